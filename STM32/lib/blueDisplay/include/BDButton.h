@@ -287,6 +287,7 @@ public:
     void setCaption(const char *aCaption, bool doDrawButton = false);
     void setCaptionFromStringArray(const char *const aCaptionStringArrayPtr[], uint8_t aStringIndex, bool doDrawButton);
     void setCaptionForValueTrue(const char *aCaption);
+    void setCaptionInterned(const char *aCaption, bool doDrawButton = false);
     void setValue(int16_t aValue, bool doDrawButton = false);
     void setValueAndDraw(int16_t aValue);
     void setButtonColor(color16_t aButtonColor);
@@ -0,0 +1,61 @@
+/*
+ * BDNumberFormat.h
+ *
+ * Small allocation free number to string conversion, to avoid pulling in the printf implementation
+ * for drawShort(), drawLong(), debug() and the chart labels.
+ *
+ *  SUMMARY
+ *  Blue Display is an Open Source Android remote Display for Arduino etc.
+ *  It receives basic draw requests from Arduino etc. over Bluetooth and renders it.
+ *  It also implements basic GUI elements as buttons and sliders.
+ *  GUI callback, touch and sensor events are sent back to Arduino.
+ *
+ *  Copyright (C) 2026  agent
+ *  agent@local
+ *
+ *  This file is part of BlueDisplay https://github.com/ArminJo/android-blue-display.
+ *
+ *  BlueDisplay is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+#ifndef _BDNUMBERFORMAT_H
+#define _BDNUMBERFORMAT_H
+
+#include <stdint.h>
+
+/*
+ * All functions write into a caller supplied buffer of aBufferSize bytes, terminate it with a null character
+ * and return the number of characters written (without the terminating null).
+ * The result is right aligned and left padded up to aMinWidth like printf("%*d").
+ * Like snprintf(), the result is truncated to aBufferSize - 1 characters if it does not fit.
+ */
+#define FORMAT_MAX_DECIMAL_DIGITS   10  // 4294967295
+#define FORMAT_MAX_HEX_DIGITS        8
+#define FORMAT_MAX_NUMBER_OF_DECIMALS 7 // More decimals make no sense for float
+#define FORMAT_BUFFER_SIZE_FOR_LONG 12  // sign + 10 digits + null
+#define FORMAT_BUFFER_SIZE_FOR_FLOAT 22 // like dtostrf(aFloat, 16, 7, ...)
+
+#define FORMAT_PAD_SPACE ' '
+#define FORMAT_PAD_ZERO  '0'
+
+uint8_t formatUnsignedDecimal(char *aBuffer, uint8_t aBufferSize, uint32_t aValue, uint8_t aMinWidth = 0,
+        char aPadChar = FORMAT_PAD_SPACE);
+uint8_t formatSignedDecimal(char *aBuffer, uint8_t aBufferSize, int32_t aValue, uint8_t aMinWidth = 0,
+        char aPadChar = FORMAT_PAD_SPACE);
+uint8_t formatHex(char *aBuffer, uint8_t aBufferSize, uint32_t aValue, uint8_t aMinNumberOfDigits = 1);
+uint8_t formatFloat(char *aBuffer, uint8_t aBufferSize, float aValue, uint8_t aMinWidth, uint8_t aNumberOfDecimals);
+
+#endif // _BDNUMBERFORMAT_H
+#pragma once
@@ -0,0 +1,93 @@
+/*
+ * BDVectorGroup.h
+ *
+ * Group of vectors (needles) of an instrument panel, which are updated together.
+ * Only vectors with changed angle are redrawn.
+ *
+ *  SUMMARY
+ *  Blue Display is an Open Source Android remote Display for Arduino etc.
+ *  It receives basic draw requests from Arduino etc. over Bluetooth and renders it.
+ *  It also implements basic GUI elements as buttons and sliders.
+ *  GUI callback, touch and sensor events are sent back to Arduino.
+ *
+ *  Copyright (C) 2026  agent
+ *  agent@local
+ *
+ *  This file is part of BlueDisplay https://github.com/ArminJo/android-blue-display.
+ *
+ *  BlueDisplay is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+#ifndef _BDVECTORGROUP_H
+#define _BDVECTORGROUP_H
+
+#include <stdint.h>
+
+#include "Colors.h" // for color16_t
+
+#if !defined(VECTOR_GROUP_MAX_SIZE)
+#define VECTOR_GROUP_MAX_SIZE 12
+#endif
+#define VECTOR_DEGREES_NOT_DRAWN 0x7FFF
+
+typedef uint8_t BDVectorHandle_t;
+#define MAX_NUMBER_OF_HOST_VECTORS 0xFF // limited by the size of BDVectorHandle_t
+extern BDVectorHandle_t sLocalVectorIndex;
+
+/*
+ * Degrees are counted counterclockwise, 0 is right (3 o'clock) like for drawVectorDegrees()
+ */
+struct BDVector {
+    uint16_t StartX;
+    uint16_t StartY;
+    uint16_t Length;
+    int16_t Thickness;
+    color16_t Color;
+    color16_t BackgroundColor;
+    int16_t DrawnDegrees; // VECTOR_DEGREES_NOT_DRAWN if not yet drawn
+    int16_t Degrees;
+    BDVectorHandle_t VectorHandle; // handle of host vector
+};
+
+#ifdef __cplusplus
+class BDVectorGroup {
+public:
+    static void resetAllVectors(void);
+
+    BDVectorGroup();
+    /*
+     * With host rendering, the host stores the vectors and one command per update erases and draws all changed vectors.
+     * Call resetAllVectors(), init() and addVector() in the connect callback like for buttons, since host vectors
+     * are cleared by reset all.
+     */
+    void init(bool aDoHostRendering);
+    int8_t addVector(uint16_t aStartX, uint16_t aStartY, uint16_t aLength, int16_t aThickness, color16_t aColor,
+            color16_t aBackgroundColor, int16_t aDegrees);
+    void setDegrees(uint8_t aVectorIndex, int16_t aDegrees);
+    void update(void);
+    void redraw(void);
+
+    struct BDVector mVectors[VECTOR_GROUP_MAX_SIZE];
+    uint8_t mNumberOfVectors;
+    bool mDoHostRendering;
+
+private:
+    void updateVectors(bool aDoDrawAll);
+    void drawVector(struct BDVector *aVector, int16_t aDegrees, color16_t aColor);
+};
+#endif
+
+#endif // _BDVECTORGROUP_H
+#pragma once
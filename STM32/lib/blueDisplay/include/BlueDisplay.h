@@ -81,6 +81,7 @@
 #ifdef __cplusplus
 #include "BDButton.h" // for BDButtonHandle_t
 #include "BDSlider.h" // for BDSliderHandle_t
+#include "BDVectorGroup.h"
 #endif
 
 /***************************
@@ -114,64 +115,136 @@
 #define TEXT_SIZE_33 33
 // for factor 4 of 8*12 font
 #define TEXT_SIZE_44 44
-// TextWidth = TextSize * 0.6
+
+/*
+ * Text metrics for the Monospace font on Android.
+ * The sizes 11, 22, 33 and 44 have fixed values, e.g. to be compatible with the 8*12 font of local displays
+ * or to have ASCEND + DECEND = HEIGHT. All other sizes use the formulas below.
+ * The TEXT_SIZE_<n>_* macros are constants, which can also be used by C code.
+ */
+#define TEXT_WIDTH_FORMULA(aTextSize)   ((((aTextSize) * 6) + 4) / 10)     // TextSize * 0.6
+#define TEXT_HEIGHT_FORMULA(aTextSize)  ((aTextSize) + ((aTextSize) / 8))  // TextSize * 1,125 ( 1 + 1/8)
+#define TEXT_ASCEND_FORMULA(aTextSize)  ((((aTextSize) * 195L) + 128) >> 8) // TextSize * 0.76
+#define TEXT_DECEND_FORMULA(aTextSize)  ((((aTextSize) * 61L) + 128) >> 8)  // TextSize * 0.24
+#define TEXT_ASCEND_MINUS_DECEND_FORMULA(aTextSize) ((((aTextSize) * 133L) + 128) >> 8)
+#define TEXT_MIDDLE_FORMULA(aTextSize)  ((((aTextSize) * 66L) + 128) >> 8)
+
 #if defined(SUPPORT_LOCAL_DISPLAY)
 // 8/16 instead of 7/13 to be compatible with 8*12 font
 #define TEXT_SIZE_11_WIDTH 8
 #define TEXT_SIZE_22_WIDTH 16
 #else
 #define TEXT_SIZE_11_WIDTH 7
-#define TEXT_SIZE_12_WIDTH 7
-#define TEXT_SIZE_13_WIDTH 8
-#define TEXT_SIZE_14_WIDTH 8
-#define TEXT_SIZE_16_WIDTH 10
-#define TEXT_SIZE_18_WIDTH 11
 #define TEXT_SIZE_22_WIDTH 13
-#define TEXT_SIZE_33_WIDTH 20
-#define TEXT_SIZE_44_WIDTH 26
 #endif
-
-// TextSize * 1,125 ( 1 + 1/8)
-// 12 instead of 11 to be compatible with 8*12 font and have a margin
-#define TEXT_SIZE_10_HEIGHT 11
+// 12 instead of 11 to be compatible with 8*12 font and have a margin, ascend 9 instead of 8 to have ASCEND + DECEND = HEIGHT
 #define TEXT_SIZE_11_HEIGHT 12
-#define TEXT_SIZE_12_HEIGHT 13
-#define TEXT_SIZE_14_HEIGHT 15
-#define TEXT_SIZE_16_HEIGHT 18
-#define TEXT_SIZE_18_HEIGHT 20
-#define TEXT_SIZE_20_HEIGHT 22
-#define TEXT_SIZE_22_HEIGHT 24
-#define TEXT_SIZE_33_HEIGHT 36
-#define TEXT_SIZE_44_HEIGHT 48
-
-// TextSize * 0.76
-// TextSize * 0.855 to have ASCEND + DECEND = HEIGHT
-// 9 instead of 8 to have ASCEND + DECEND = HEIGHT
 #define TEXT_SIZE_11_ASCEND 9
-#define TEXT_SIZE_12_ASCEND 9
-#define TEXT_SIZE_13_ASCEND 10
-#define TEXT_SIZE_14_ASCEND 11
-#define TEXT_SIZE_16_ASCEND 12
-#define TEXT_SIZE_18_ASCEND 14
-// 18 instead of 17 to have ASCEND + DECEND = HEIGHT
-#define TEXT_SIZE_22_ASCEND 18
-#define TEXT_SIZE_33_ASCEND 28
-#define TEXT_SIZE_44_ASCEND 37
-
-// TextSize * 0.24
-// TextSize * 0.27 to have ASCEND + DECEND = HEIGHT
 #define TEXT_SIZE_11_DECEND 3
-#define TEXT_SIZE_11_DECEND 3
-// 6 instead of 5 to have ASCEND + DECEND = HEIGHT
+// 18 / 6 instead of 17 / 5 to have ASCEND + DECEND = HEIGHT
+#define TEXT_SIZE_22_HEIGHT 24
+#define TEXT_SIZE_22_ASCEND 18
 #define TEXT_SIZE_22_DECEND 6
+// for factor 3 and 4 of 8*12 font
+#define TEXT_SIZE_33_WIDTH 20
+#define TEXT_SIZE_33_HEIGHT 36
+#define TEXT_SIZE_33_ASCEND 28
 #define TEXT_SIZE_33_DECEND 8
+#define TEXT_SIZE_44_WIDTH 26
+#define TEXT_SIZE_44_HEIGHT 48
+#define TEXT_SIZE_44_ASCEND 37
 #define TEXT_SIZE_44_DECEND 11
 
-uint16_t getTextHeight(uint16_t aTextSize);
-uint16_t getTextWidth(uint16_t aTextSize);
-uint16_t getTextAscend(uint16_t aTextSize);
-uint16_t getTextAscendMinusDescend(uint16_t aTextSize);
-uint16_t getTextMiddle(uint16_t aTextSize);
+#define TEXT_SIZE_12_WIDTH TEXT_WIDTH_FORMULA(TEXT_SIZE_12)
+#define TEXT_SIZE_13_WIDTH TEXT_WIDTH_FORMULA(TEXT_SIZE_13)
+#define TEXT_SIZE_14_WIDTH TEXT_WIDTH_FORMULA(TEXT_SIZE_14)
+#define TEXT_SIZE_16_WIDTH TEXT_WIDTH_FORMULA(TEXT_SIZE_16)
+#define TEXT_SIZE_18_WIDTH TEXT_WIDTH_FORMULA(TEXT_SIZE_18)
+
+#define TEXT_SIZE_10_HEIGHT TEXT_HEIGHT_FORMULA(TEXT_SIZE_10)
+#define TEXT_SIZE_12_HEIGHT TEXT_HEIGHT_FORMULA(TEXT_SIZE_12)
+#define TEXT_SIZE_14_HEIGHT TEXT_HEIGHT_FORMULA(TEXT_SIZE_14)
+#define TEXT_SIZE_16_HEIGHT TEXT_HEIGHT_FORMULA(TEXT_SIZE_16)
+#define TEXT_SIZE_18_HEIGHT TEXT_HEIGHT_FORMULA(TEXT_SIZE_18)
+#define TEXT_SIZE_20_HEIGHT TEXT_HEIGHT_FORMULA(TEXT_SIZE_20)
+
+#define TEXT_SIZE_12_ASCEND TEXT_ASCEND_FORMULA(TEXT_SIZE_12)
+#define TEXT_SIZE_13_ASCEND TEXT_ASCEND_FORMULA(TEXT_SIZE_13)
+#define TEXT_SIZE_14_ASCEND TEXT_ASCEND_FORMULA(TEXT_SIZE_14)
+#define TEXT_SIZE_16_ASCEND TEXT_ASCEND_FORMULA(TEXT_SIZE_16)
+#define TEXT_SIZE_18_ASCEND TEXT_ASCEND_FORMULA(TEXT_SIZE_18)
+
+#ifdef __cplusplus
+/*
+ * All functions are constexpr, so metrics of constant text sizes are computed by the compiler.
+ */
+struct TextMetrics {
+    uint8_t TextSize;
+    uint8_t Width;
+    uint8_t Height;
+    uint8_t Ascend;
+    uint8_t Decend;
+};
+
+static constexpr TextMetrics sTextMetricsTable[] = {
+        { TEXT_SIZE_11, TEXT_SIZE_11_WIDTH, TEXT_SIZE_11_HEIGHT, TEXT_SIZE_11_ASCEND, TEXT_SIZE_11_DECEND },
+        { TEXT_SIZE_22, TEXT_SIZE_22_WIDTH, TEXT_SIZE_22_HEIGHT, TEXT_SIZE_22_ASCEND, TEXT_SIZE_22_DECEND },
+        { TEXT_SIZE_33, TEXT_SIZE_33_WIDTH, TEXT_SIZE_33_HEIGHT, TEXT_SIZE_33_ASCEND, TEXT_SIZE_33_DECEND },
+        { TEXT_SIZE_44, TEXT_SIZE_44_WIDTH, TEXT_SIZE_44_HEIGHT, TEXT_SIZE_44_ASCEND, TEXT_SIZE_44_DECEND } };
+
+#define TEXT_METRICS_TABLE_SIZE (sizeof(sTextMetricsTable) / sizeof(TextMetrics))
+
+/*
+ * Returns index in sTextMetricsTable or TEXT_METRICS_TABLE_SIZE if not found.
+ * Recursive, since C++11 constexpr functions must consist of a single return statement.
+ */
+constexpr uint8_t getTextMetricsIndex(uint16_t aTextSize, uint8_t aIndex = 0) {
+    return (aIndex >= TEXT_METRICS_TABLE_SIZE || sTextMetricsTable[aIndex].TextSize == aTextSize) ?
+            aIndex : getTextMetricsIndex(aTextSize, aIndex + 1);
+}
+
+constexpr uint16_t getTextWidth(uint16_t aTextSize) {
+    return (getTextMetricsIndex(aTextSize) < TEXT_METRICS_TABLE_SIZE) ?
+            sTextMetricsTable[getTextMetricsIndex(aTextSize)].Width : TEXT_WIDTH_FORMULA(aTextSize);
+}
+
+constexpr uint16_t getTextHeight(uint16_t aTextSize) {
+    return (getTextMetricsIndex(aTextSize) < TEXT_METRICS_TABLE_SIZE) ?
+            sTextMetricsTable[getTextMetricsIndex(aTextSize)].Height : TEXT_HEIGHT_FORMULA(aTextSize);
+}
+
+constexpr uint16_t getTextAscend(uint16_t aTextSize) {
+    return (getTextMetricsIndex(aTextSize) < TEXT_METRICS_TABLE_SIZE) ?
+            sTextMetricsTable[getTextMetricsIndex(aTextSize)].Ascend : TEXT_ASCEND_FORMULA(aTextSize);
+}
+
+constexpr uint16_t getTextDecend(uint16_t aTextSize) {
+    return (getTextMetricsIndex(aTextSize) < TEXT_METRICS_TABLE_SIZE) ?
+            sTextMetricsTable[getTextMetricsIndex(aTextSize)].Decend : TEXT_DECEND_FORMULA(aTextSize);
+}
+
+/*
+ * Ascend - Decent
+ * is used to position text in the middle of a button
+ * Formula for positioning:
+ * Position = ButtonTop + (ButtonHeight + getTextAscendMinusDescend())/2
+ */
+constexpr uint16_t getTextAscendMinusDescend(uint16_t aTextSize) {
+    return (getTextMetricsIndex(aTextSize) < TEXT_METRICS_TABLE_SIZE) ?
+            sTextMetricsTable[getTextMetricsIndex(aTextSize)].Ascend - sTextMetricsTable[getTextMetricsIndex(aTextSize)].Decend :
+            TEXT_ASCEND_MINUS_DECEND_FORMULA(aTextSize);
+}
+
+/*
+ * (Ascend -Decent)/2
+ */
+constexpr uint16_t getTextMiddle(uint16_t aTextSize) {
+    return (getTextMetricsIndex(aTextSize) < TEXT_METRICS_TABLE_SIZE) ?
+            getTextAscendMinusDescend(aTextSize) / 2 : TEXT_MIDDLE_FORMULA(aTextSize);
+}
+
+struct XYSize measureText(const char *aStringPtr, uint16_t aTextSize);
+#endif // __cplusplus
 
 /*
  * Layout for 320 x 240 screen size
@@ -261,6 +334,51 @@ struct ThickLine {
     color16_t BackgroundColor;
 };
 
+/*
+ * Clip rectangle for culling and clipping on client side, to avoid sending invisible drawings.
+ * End values are included. The default clip rectangle covers the whole coordinate range, i.e. nothing is clipped.
+ */
+struct ClipRect {
+    int16_t XStart;
+    int16_t YStart;
+    int16_t XEnd;
+    int16_t YEnd;
+};
+#if !defined(CLIP_STACK_SIZE)
+#define CLIP_STACK_SIZE 4
+#endif
+
+/*
+ * Bitmaps are uploaded once and then cached by the host under their id.
+ * The registry only stores the pointers to the pixel data, so the data must be valid as long as the bitmap is not removed.
+ */
+#if !defined(NUMBER_OF_CACHED_BITMAPS)
+#define NUMBER_OF_CACHED_BITMAPS 8
+#endif
+#define NO_BITMAP 0xFF
+#define HOST_DATA_BUFFER_SIZE 4096 // The host receive buffer for the data of one command
+#define BITMAP_UPLOAD_MAX_CHUNK_SIZE (HOST_DATA_BUFFER_SIZE / 2)
+#define BITMAP_MAX_NUMBER_OF_PALETTE_ENTRIES 256 // Pixels are 8 bit indexes
+typedef uint8_t BDBitmapHandle_t;
+
+/*
+ * Constant strings like captions and labels are sent only once per connection and then referenced by a 1 byte id.
+ * Strings are identified by their address, so content must not change. The least recently used string id is reused.
+ */
+#if !defined(NUMBER_OF_INTERNED_STRINGS)
+#define NUMBER_OF_INTERNED_STRINGS 16 // max 255
+#endif
+#define NO_STRING_ID 0xFF
+
+struct BDBitmap {
+    const uint8_t *PixelData; // NULL if registry entry is free
+    const color16_t *Palette; // Only used for BITMAP_FORMAT_INDEXED_8
+    uint16_t Width;
+    uint16_t Height;
+    uint16_t NumberOfPaletteEntries;
+    uint8_t Format;
+};
+
 #ifdef __cplusplus
 #define MAX_NUMBER_OF_ARGS_FOR_BD_FUNCTIONS 12 // for sending
 
@@ -287,8 +405,23 @@ public:
     void clearDisplay(color16_t aColor = COLOR16_WHITE);
     void clearDisplayOptional(color16_t aColor = COLOR16_WHITE);
     void drawDisplayDirect(void);
+    void beginFrame(bool aIsCompleteRedraw = false);
+    void endFrame(void);
+    void selectLayer(uint8_t aLayer);
+    void clearLayer(uint8_t aLayer);
+    void scrollRectLeft(uint16_t aXStart, uint16_t aYStart, uint16_t aWidth, uint16_t aHeight, uint16_t aNumberOfPixel,
+            color16_t aFillColor);
     void setScreenOrientationLock(uint8_t aLockMode);
 
+    void setClipRect(int16_t aXStart, int16_t aYStart, int16_t aXEnd, int16_t aYEnd);
+    bool pushClip(int16_t aXStart, int16_t aYStart, int16_t aXEnd, int16_t aYEnd);
+    void popClip(void);
+    void resetClip(void);
+    bool isClipActive(void);
+    bool isRectVisible(int32_t aXStart, int32_t aYStart, int32_t aXEnd, int32_t aYEnd, int16_t aMargin = 0);
+    bool isTextVisible(uint16_t aPosX, uint16_t aPosY, const char *aStringPtr, uint16_t aTextSize);
+    bool clipLine(int32_t *aXStart, int32_t *aYStart, int32_t *aXEnd, int32_t *aYEnd, int16_t aMargin = 0);
+
     void drawPixel(uint16_t aXPos, uint16_t aYPos, color16_t aColor);
     void drawCircle(uint16_t aXCenter, uint16_t aYCenter, uint16_t aRadius, color16_t aColor, uint16_t aStrokeWidth);
     void fillCircle(uint16_t aXCenter, uint16_t aYCenter, uint16_t aRadius, color16_t aColor);
@@ -297,6 +430,7 @@ public:
             uint16_t aStrokeWidth);
     void fillRect(uint16_t aXStart, uint16_t aYStart, uint16_t aXEnd, uint16_t aYEnd, color16_t aColor);
     void fillRectRel(uint16_t aXStart, uint16_t aYStart, uint16_t aWidth, uint16_t aHeight, color16_t aColor);
+    void fillRectList(uint16_t aXOffset, uint16_t aYOffset, color16_t aColor, uint16_t *aRectBuffer, uint8_t aNumberOfRects);
     uint16_t drawChar(uint16_t aPosX, uint16_t aPosY, char aChar, uint16_t aCharSize, color16_t aFGColor, color16_t aBGColor);
     uint16_t drawText(uint16_t aXStart, uint16_t aYStart, const char *aStringPtr, uint16_t aFontSize, color16_t aFGColor,
             color16_t aBGColor);
@@ -351,6 +485,32 @@ public:
             uint8_t *aByteBuffer, size_t aByteBufferLength);
     void drawChartByteBuffer(uint16_t aXOffset, uint16_t aYOffset, color16_t aColor, color16_t aClearBeforeColor,
             uint8_t aChartIndex, bool aDoDrawDirect, uint8_t *aByteBuffer, size_t aByteBufferLength);
+    void drawChartMinMaxByteBuffer(uint16_t aXOffset, uint16_t aYOffset, color16_t aColor, color16_t aClearBeforeColor,
+            uint8_t aChartIndex, uint8_t *aMinMaxByteBuffer, uint16_t aNumberOfColumns);
+    void drawChartXYByteBuffer(uint16_t aXOffset, uint16_t aYOffset, color16_t aColor, color16_t aClearBeforeColor,
+            uint8_t aChartIndex, uint8_t *aXYByteBuffer, uint16_t aNumberOfPoints);
+    void drawChartGrid(uint16_t aXOrigin, uint16_t aYOrigin, uint16_t aWidth, uint16_t aHeight, uint8_t aGridXSpacing,
+            uint8_t aGridYSpacing, uint8_t aAxesSize, uint8_t aFlags, color16_t aGridColor, color16_t aAxesColor);
+    void drawChartGridSingle(uint16_t aXOrigin, uint16_t aYOrigin, uint16_t aWidth, uint16_t aHeight, uint8_t aGridXSpacing,
+            uint8_t aGridYSpacing, uint8_t aAxesSize, uint8_t aFlags, color16_t aGridColor, color16_t aAxesColor,
+            bool aLocalDisplayOnly);
+
+    BDBitmapHandle_t uploadBitmap(uint16_t aWidth, uint16_t aHeight, const color16_t *aPixels);
+    BDBitmapHandle_t uploadBitmapIndexed(uint16_t aWidth, uint16_t aHeight, const uint8_t *aPaletteIndexes,
+            const color16_t *aPalette, uint16_t aNumberOfPaletteEntries);
+    void drawBitmap(BDBitmapHandle_t aBitmapId, uint16_t aPosX, uint16_t aPosY);
+    void removeBitmap(BDBitmapHandle_t aBitmapId);
+    void reuploadAllBitmaps(void);
+
+    uint8_t getStringId(const char *aString);
+    void resetInternedStrings(void);
+    uint16_t drawInternedText(uint16_t aPosX, uint16_t aPosY, const char *aStringPtr, uint16_t aTextSize, color16_t aFGColor,
+            color16_t aBGColor);
+
+    void setColorPalette(const color16_t *aPalette, uint16_t aNumberOfColors);
+    void sendColorPalette(void);
+
+    void setConnectionJournal(uint8_t *aJournalBuffer, uint16_t aJournalBufferSize);
 
     struct XYSize* getMaxDisplaySize(void);
     uint16_t getMaxDisplayWidth(void);
@@ -463,6 +623,14 @@ public:
     bool mBlueDisplayConnectionEstablished; // true if BlueDisplayApps responded to requestMaxCanvasSize()
     bool mOrientationIsLandscape;
 
+    struct ClipRect mClipRect;
+    struct ClipRect mClipStack[CLIP_STACK_SIZE];
+    uint8_t mClipStackDepth;
+
+    const color16_t *mColorPalette; // NULL if palette mode is disabled
+    uint16_t mNumberOfPaletteColors;
+    uint8_t mClearDisplayCount; // incremented by clearDisplay(), to detect that content drawn before is gone
+
     /* For tests */
     void drawGreyscale(uint16_t aXPos, uint16_t tYPos, uint16_t aHeight);
     void drawStar(int aXPos, int aYPos, int tOffsetCenter, int tLength, int tOffsetDiagonal, int tLengthDiagonal, color16_t aColor);
@@ -483,7 +651,11 @@ void clearDisplayAndDisableButtonsAndSliders(color16_t aColor);
  * external declaration saves ROM (210 bytes) and RAM ( 20 bytes)
  * and avoids missing initialization :-)
  */
-#if defined(USE_HY32D)
+#if defined(USE_FRAME_BUFFER_DISPLAY)
+// In memory display without hardware, e.g. for tests
+#include "FrameBufferDisplay.h"
+extern FrameBufferDisplay LocalDisplay;
+#elif defined(USE_HY32D)
 #include "SSD1289.h"
 extern SSD1289 LocalDisplay;
 #else
@@ -529,6 +701,35 @@ float getTemperature(void);
 #endif
 
 /*
+ * Version 3.1.0 - work in progress
+ * - drawByte() to drawLong(), debug() and chart labels use BDNumberFormat instead of sprintf().
+ * - Text metrics are constexpr functions based on one table. New function measureText(). Fixed getTextDecend() for size 11 and 22.
+ * - New functions uploadBitmap(), uploadBitmapIndexed(), drawBitmap() and removeBitmap(). Bitmaps are uploaded again after reconnect.
+ * - New functions getStringId(), drawInternedText() and BDButton::setCaptionInterned() to send constant strings only once per connection.
+ * - New FrameBufferDisplay class, which can be used as LocalDisplay by defining USE_FRAME_BUFFER_DISPLAY.
+ * - New functions beginFrame() and endFrame() to show all drawings of a frame at once.
+ * - New functions setClipRect(), pushClip() and popClip() to skip drawings outside of the clip rectangle and to clip lines.
+ * - Fixed refreshVector() comparing EndX with new Y value. It now clips the vector instead of clamping the end point.
+ * - Fixed local drawing of drawLineRelWithThickness().
+ * - New function setColorPalette(). Colors contained in the palette are sent as one byte index.
+ * - New class BDVectorGroup for updating many vectors at once, optional with host rendering.
+ * - New functions selectLayer() and clearLayer() to draw e.g. chart traces on a host layer above the static grid.
+ * - New function Chart::setDataLayer() to draw chart data on its own host layer.
+ * - New function setConnectionJournal(). GUI is rebuilt at reconnect by replaying the recorded commands.
+ * - New function drawChartMinMaxByteBuffer() to draw a vertical line per column, used by Chart peak detect compression.
+ * - New function scrollRectLeft(), used by Chart roll mode.
+ * - Chart supports up to 16 traces with own color, scale and offset, each using its own host chart index.
+ * - Chart computes display values of integer data without float operations.
+ * - Chart::drawChartData() accepts int8_t, uint8_t, uint16_t, int32_t and float data without conversion.
+ * - New class ChartLTTB for streaming largest triangle three buckets downsampling and Chart::setXLTTB().
+ * - Chart axis labels are only redrawn if their text changed.
+ * - New function drawChartGrid() to draw chart axes and grid with one command, used by Chart::drawAxesAndGrid().
+ * - Chart envelope mode CHART_MODE_ENVELOPE accumulates the minimum and maximum of successive traces with optional decay.
+ * - New function Chart::drawChartDataXY() for X-Y plots, sent as one byte buffer of X and Y pairs by drawChartXYByteBuffer().
+ * - New class BarChart for histograms, which draws only the changed parts of the bars with the new function fillRectList().
+ * - New class ChartSpectrum for fixed point FFT spectrum display with Chart.
+ * - New class ChartTrigger for edge, level and pulse width triggers with pre trigger capture for Chart.
+ *
  * Version 3.0.0
  * - Renamed *.cpp to *.hpp.
  *
@@ -34,6 +34,8 @@
  * 1. Sync byte A5
  * 2. byte function token
  * 3. Short length (in bytes units -> always multiple of 2) of parameters
+ *    If a color palette is set, the upper byte is a mask of the parameters 0 to 7, which are sent as one byte palette index
+ *    and the lower byte is the length in bytes.
  * 4. Short n parameters
  *
  * Data (expected for messages with function code >= 0x60):
@@ -285,8 +287,21 @@ const int FUNCTION_FILL_RECT = 0x27;
 const int FUNCTION_DRAW_CIRCLE = 0x28;
 const int FUNCTION_FILL_CIRCLE = 0x29;
 
+// 3 parameter, draws bitmap previously uploaded with FUNCTION_BITMAP_UPLOAD
+const int FUNCTION_BITMAP_DRAW = 0x2A;
+const int FUNCTION_BITMAP_REMOVE = 0x2B;
 const int FUNCTION_DRAW_VECTOR_DEGREE = 0x2C;
 const int FUNCTION_DRAW_VECTOR_RADIAN = 0x2D;
+// 6 parameter, like FUNCTION_DRAW_STRING but with id of a string defined by FUNCTION_STRING_DEFINE as last parameter
+const int FUNCTION_DRAW_STRING_BY_ID = 0x2E;
+
+// no parameter. Host shows the last frame until FUNCTION_FRAME_END
+const int FUNCTION_FRAME_BEGIN = 0x30;
+// Host may skip content up to this command, if it can not keep up with the client
+const int FUNCTION_FRAME_BEGIN_OPTIONAL = 0x31;
+const int FUNCTION_FRAME_END = 0x32;
+// 7 parameter: vector handle, start x, start y, length, thickness, color, background color. Defines a host vector
+const int FUNCTION_VECTOR_DEFINE = 0x33;
 
 const int FUNCTION_WRITE_SETTINGS = 0x34;
 // Flags for WRITE_SETTINGS
@@ -294,19 +309,58 @@ const int FLAG_WRITE_SETTINGS_SET_SIZE_AND_COLORS_AND_FLAGS = 0x00;
 const int FLAG_WRITE_SETTINGS_SET_POSITION = 0x01;
 const int FLAG_WRITE_SETTINGS_SET_LINE_COLUMN = 0x02;
 
+// 1 parameter: layer. Layer 0 is the opaque background, upper layers are transparent and composited by the host
+const int FUNCTION_LAYER_SELECT = 0x35;
+// 1 parameter: layer. Clears upper layers to transparent and layer 0 to white
+const int FUNCTION_LAYER_CLEAR = 0x36;
+const int LAYER_BACKGROUND = 0;
+const int LAYER_FOREGROUND = 1;
+const int MAX_NUMBER_OF_LAYERS = 4;
+// 6 parameter: x, y, width, height, pixel to scroll left, fill color. On upper layers exposed area is cleared to transparent.
+const int FUNCTION_RECT_SCROLL_LEFT = 0x37;
+// 10 parameter: x and y of origin, width, height, grid color, axes color, X and Y grid spacing, axes size, flags.
+// Draws axes, tick indicators and grid lines of a chart like Chart::drawAxesAndGrid() without labels.
+const int FUNCTION_DRAW_CHART_GRID = 0x38;
+// Flags for DRAW_CHART_GRID
+const int CHART_GRID_FLAG_GRID_LINES = 0x01;
+const int CHART_GRID_FLAG_X_INDICATORS = 0x02;
+const int CHART_GRID_FLAG_Y_INDICATORS = 0x04;
+
 const int INDEX_LAST_FUNCTION_WITHOUT_DATA = 0x5F;
 // Function with variable data size
 const int FUNCTION_DRAW_STRING = 0x60;
 const int FUNCTION_DEBUG_STRING = 0x61;
 const int FUNCTION_WRITE_STRING = 0x62;
+// Parameter like FUNCTION_DRAW_CHART. Data: pairs of X and Y value, each pair is drawn as one point
+// Without clear color, the points are added to the points to clear of the chart index
+const int FUNCTION_DRAW_CHART_XY = 0x63;
 
 const int FUNCTION_GET_NUMBER_WITH_SHORT_PROMPT = 0x64;
 const int FUNCTION_GET_TEXT_WITH_SHORT_PROMPT = 0x65;
+// Parameter: flag draw all. Data: pairs of vector handle and degrees. Host erases the old and draws the new vectors.
+const int FUNCTION_VECTOR_SET_DEGREES = 0x66;
+// Parameter like FUNCTION_DRAW_CHART. Data: pairs of top and bottom Y value, each pair is drawn as vertical line of one column
+const int FUNCTION_DRAW_CHART_MIN_MAX = 0x67;
 
 const int FUNCTION_DRAW_PATH = 0x68;
 const int FUNCTION_FILL_PATH = 0x69;
 const int FUNCTION_DRAW_CHART = 0x6A;
 const int FUNCTION_DRAW_CHART_WITHOUT_DIRECT_RENDERING = 0x6B;
+// Parameter: bitmap id, width, height, format, start line. Data: complete lines of pixels
+const int FUNCTION_BITMAP_UPLOAD = 0x6C;
+// Formats for FUNCTION_BITMAP_UPLOAD
+const int BITMAP_FORMAT_RGB565 = 0x00; // 2 bytes little endian per pixel
+const int BITMAP_FORMAT_INDEXED_8 = 0x01; // 1 byte index into palette per pixel
+// Parameter: bitmap id, number of entries. Data: palette entries as RGB565 little endian
+const int FUNCTION_BITMAP_SET_PALETTE = 0x6D;
+// Parameter: string id. Data: string, which is stored by host under this id
+const int FUNCTION_STRING_DEFINE = 0x6E;
+// Parameter: number of entries. Data: palette entries as RGB565 little endian. Used to send colors as one byte palette index
+const int FUNCTION_COLOR_PALETTE_SET = 0x6F;
+// 0x74 to 0x77 are display functions, since buttons use only 0x70 to 0x73.
+// Parameter: x and y offset, number of rectangles, 0, color. Data: x, y, width and height of each rectangle as short values,
+// data length is in byte as for all data fields
+const int FUNCTION_FILL_RECT_LIST = 0x74;
 
 /**********************
  * Button functions
@@ -330,6 +384,9 @@ const int SUBFUNCTION_BUTTON_RESET_ACTIVE = 0x11;
 const int SUBFUNCTION_BUTTON_SET_AUTOREPEAT_TIMING = 0x12;
 
 const int FUNCTION_BUTTON_REMOVE = 0x43;
+// Parameter: button number, string id
+const int FUNCTION_BUTTON_SET_CAPTION_BY_ID = 0x44;
+const int FUNCTION_BUTTON_SET_CAPTION_BY_ID_AND_DRAW_BUTTON = 0x45;
 
 // static functions
 const int FUNCTION_BUTTON_ACTIVATE_ALL = 0x48;
@@ -60,11 +60,40 @@
 #define BAUD_921600 ( 921600)
 #define BAUD_1382400 (1382400)
 
+/*
+ * Colors contained in the palette are sent as one byte index, see FUNCTION_COLOR_PALETTE_SET
+ */
+#define MAX_NUMBER_OF_PALETTE_COLORS 256
+#define NO_PALETTE_INDEX (-1)
+#define COLOR_PARAMETER(aParameterIndex) (1 << (aParameterIndex)) // for aColorParameterMask
+void setColorPaletteForSend(const uint16_t *aPalette, uint16_t aNumberOfColors);
+int16_t getPaletteIndexForSend(uint16_t aColor);
+
+/*
+ * Connection journal. Records the commands which build up the GUI, to replay them at reconnect
+ * without calling the connect callback of the application.
+ */
+#define JOURNAL_STATE_DISABLED          0 // no journal buffer
+#define JOURNAL_STATE_INVALID           1 // overflow or screen content changed, must be recorded again
+#define JOURNAL_STATE_RECORD_ALL        2 // records all commands, set during the callbacks at connection build up
+#define JOURNAL_STATE_RECORD_GUI_STATE  3 // valid, records only changes of buttons, sliders, strings and vectors
+#define JOURNAL_ENTRY_HEADER_SIZE       2 // length of entry
+void setJournalBuffer(uint8_t *aBuffer, uint16_t aSize);
+void startJournalRecording(void);
+void endJournalRecording(void);
+void invalidateJournal(void);
+bool isJournalValid(void);
+uint16_t getJournalLength(void);
+void replayJournal(void);
+void resumeJournalRecording(void);
+
 /*
  * common functions
  */
 void sendUSARTArgs(uint8_t aFunctionTag, int aNumberOfArgs, ...);
 void sendUSARTArgsAndByteBuffer(uint8_t aFunctionTag, int aNumberOfArgs, ...);
+void sendUSARTArgsWithColors(uint8_t aFunctionTag, uint8_t aColorParameterMask, int aNumberOfArgs, ...);
+void sendUSARTArgsWithColorsAndByteBuffer(uint8_t aFunctionTag, uint8_t aColorParameterMask, int aNumberOfArgs, ...);
 void sendUSART5Args(uint8_t aFunctionTag, uint16_t aXStart, uint16_t aYStart, uint16_t aXEnd, uint16_t aYEnd,
         uint16_t aColor);
 void sendUSART5ArgsAndByteBuffer(uint8_t aFunctionTag, uint16_t aXStart, uint16_t aYStart, uint16_t aXEnd,
@@ -141,6 +170,8 @@ void sendUSARTBufferSimple(uint8_t * aParameterBufferPointer, size_t aParameterB
 // Function using DMA
 void sendUSARTBufferNoSizeCheck(uint8_t * aParameterBufferPointer, size_t aParameterBufferLength,
         uint8_t * aDataBufferPointer, size_t aDataBufferLength);
+void sendUSARTBuffer(uint8_t * aParameterBufferPointer, size_t aParameterBufferLength, uint8_t * aDataBufferPointer,
+        size_t aDataBufferLength);
 void checkAndHandleMessageReceived(void);
 
 #endif /* BLUESERIAL_H_ */
@@ -95,12 +95,12 @@ void BDButton::init(uint16_t aPositionX, uint16_t aPositionY, uint16_t aWidthX,
     BDButtonHandle_t tButtonNumber = sLocalButtonIndex++;
     if (USART_isBluetoothPaired()) {
 #if __SIZEOF_POINTER__ == 4
-        sendUSARTArgsAndByteBuffer(FUNCTION_BUTTON_CREATE, 11, tButtonNumber, aPositionX, aPositionY, aWidthX, aHeightY,
-                aButtonColor, aCaptionSize, aFlags, aValue, aOnTouchHandler, (reinterpret_cast<uint32_t>(aOnTouchHandler) >> 16),
-                strlen(aCaption), aCaption);
+        sendUSARTArgsWithColorsAndByteBuffer(FUNCTION_BUTTON_CREATE, COLOR_PARAMETER(5), 11, tButtonNumber, aPositionX, aPositionY,
+                aWidthX, aHeightY, aButtonColor, aCaptionSize, aFlags, aValue, aOnTouchHandler,
+                (reinterpret_cast<uint32_t>(aOnTouchHandler) >> 16), strlen(aCaption), aCaption);
 #else
-        sendUSARTArgsAndByteBuffer(FUNCTION_BUTTON_CREATE, 10, tButtonNumber, aPositionX, aPositionY, aWidthX, aHeightY,
-                aButtonColor, aCaptionSize, aFlags, aValue, aOnTouchHandler, strlen(aCaption), aCaption);
+        sendUSARTArgsWithColorsAndByteBuffer(FUNCTION_BUTTON_CREATE, COLOR_PARAMETER(5), 10, tButtonNumber, aPositionX, aPositionY,
+                aWidthX, aHeightY, aButtonColor, aCaptionSize, aFlags, aValue, aOnTouchHandler, strlen(aCaption), aCaption);
 #endif
     }
     mButtonHandle = tButtonNumber;
@@ -146,7 +146,7 @@ void BDButton::removeButton(color16_t aBackgroundColor) {
     mLocalButtonPtr->removeButton(aBackgroundColor);
 #endif
     if (USART_isBluetoothPaired()) {
-        sendUSARTArgs(FUNCTION_BUTTON_REMOVE, 2, mButtonHandle, aBackgroundColor);
+        sendUSARTArgsWithColors(FUNCTION_BUTTON_REMOVE, COLOR_PARAMETER(1), 2, mButtonHandle, aBackgroundColor);
     }
 }
 
@@ -196,6 +196,25 @@ void BDButton::setCaption(const char *aCaption, bool doDrawButton) {
     }
 }
 
+/*
+ * Like setCaption(), but caption string is sent only once per connection
+ */
+void BDButton::setCaptionInterned(const char *aCaption, bool doDrawButton) {
+#if defined(SUPPORT_LOCAL_DISPLAY)
+    mLocalButtonPtr->setCaption(aCaption);
+    if (doDrawButton) {
+        mLocalButtonPtr->drawButton();
+    }
+#endif
+    if (USART_isBluetoothPaired()) {
+        uint8_t tFunctionCode = FUNCTION_BUTTON_SET_CAPTION_BY_ID;
+        if (doDrawButton) {
+            tFunctionCode = FUNCTION_BUTTON_SET_CAPTION_BY_ID_AND_DRAW_BUTTON;
+        }
+        sendUSARTArgs(tFunctionCode, 2, mButtonHandle, BlueDisplay1.getStringId(aCaption));
+    }
+}
+
 void BDButton::setCaptionFromStringArray(const char *const aCaptionStringArrayPtr[], uint8_t aStringIndex, bool doDrawButton) {
     setCaption(aCaptionStringArrayPtr[aStringIndex], doDrawButton);
 }
@@ -229,7 +248,8 @@ void BDButton::setButtonColor(color16_t aButtonColor) {
     mLocalButtonPtr->setButtonColor(aButtonColor);
 #endif
     if (USART_isBluetoothPaired()) {
-        sendUSARTArgs(FUNCTION_BUTTON_SETTINGS, 3, mButtonHandle, SUBFUNCTION_BUTTON_SET_BUTTON_COLOR, aButtonColor);
+        sendUSARTArgsWithColors(FUNCTION_BUTTON_SETTINGS, COLOR_PARAMETER(2), 3, mButtonHandle, SUBFUNCTION_BUTTON_SET_BUTTON_COLOR,
+                aButtonColor);
     }
 }
 
@@ -239,7 +259,8 @@ void BDButton::setButtonColorAndDraw(color16_t aButtonColor) {
     mLocalButtonPtr->drawButton();
 #endif
     if (USART_isBluetoothPaired()) {
-        sendUSARTArgs(FUNCTION_BUTTON_SETTINGS, 3, mButtonHandle, SUBFUNCTION_BUTTON_SET_BUTTON_COLOR_AND_DRAW, aButtonColor);
+        sendUSARTArgsWithColors(FUNCTION_BUTTON_SETTINGS, COLOR_PARAMETER(2), 3, mButtonHandle,
+                SUBFUNCTION_BUTTON_SET_BUTTON_COLOR_AND_DRAW, aButtonColor);
     }
 }
 
@@ -421,12 +442,12 @@ void BDButton::init(uint16_t aPositionX, uint16_t aPositionY, uint16_t aWidthX,
         uint8_t tCaptionLength = StringClipAndCopy(tStringBuffer, aPGMCaption);
 
 #if __SIZEOF_POINTER__ == 4
-        sendUSARTArgsAndByteBuffer(FUNCTION_BUTTON_CREATE, 11, tButtonNumber, aPositionX, aPositionY, aWidthX, aHeightY,
-                aButtonColor, aCaptionSize, aFlags, aValue, aOnTouchHandler, (reinterpret_cast<uint32_t>(aOnTouchHandler) >> 16),
-                tCaptionLength, tStringBuffer);
+        sendUSARTArgsWithColorsAndByteBuffer(FUNCTION_BUTTON_CREATE, COLOR_PARAMETER(5), 11, tButtonNumber, aPositionX, aPositionY,
+                aWidthX, aHeightY, aButtonColor, aCaptionSize, aFlags, aValue, aOnTouchHandler,
+                (reinterpret_cast<uint32_t>(aOnTouchHandler) >> 16), tCaptionLength, tStringBuffer);
 #else
-        sendUSARTArgsAndByteBuffer(FUNCTION_BUTTON_CREATE, 10, tButtonNumber, aPositionX, aPositionY, aWidthX, aHeightY,
-                aButtonColor, aCaptionSize, aFlags, aValue, aOnTouchHandler, tCaptionLength, tStringBuffer);
+        sendUSARTArgsWithColorsAndByteBuffer(FUNCTION_BUTTON_CREATE, COLOR_PARAMETER(5), 10, tButtonNumber, aPositionX, aPositionY,
+                aWidthX, aHeightY, aButtonColor, aCaptionSize, aFlags, aValue, aOnTouchHandler, tCaptionLength, tStringBuffer);
 #endif
     }
     mButtonHandle = tButtonNumber;
@@ -0,0 +1,188 @@
+/*
+ * BDNumberFormat.cpp
+ *
+ * Number to string conversion without division and without printf.
+ * Digits are generated by subtracting powers of ten from a constant table,
+ * which is fast even on cores without hardware divider.
+ *
+ *  SUMMARY
+ *  Blue Display is an Open Source Android remote Display for Arduino etc.
+ *  It receives basic draw requests from Arduino etc. over Bluetooth and renders it.
+ *  It also implements basic GUI elements as buttons and sliders.
+ *  GUI callback, touch and sensor events are sent back to Arduino.
+ *
+ *  Copyright (C) 2026  agent
+ *  agent@local
+ *
+ *  This file is part of BlueDisplay https://github.com/ArminJo/android-blue-display.
+ *
+ *  BlueDisplay is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+#ifndef _BDNUMBERFORMAT_HPP
+#define _BDNUMBERFORMAT_HPP
+
+#include "BDNumberFormat.h"
+
+static constexpr uint32_t sPowersOfTen[FORMAT_MAX_DECIMAL_DIGITS] = { 1UL, 10UL, 100UL, 1000UL, 10000UL, 100000UL, 1000000UL,
+        10000000UL, 100000000UL, 1000000000UL };
+
+static constexpr char sHexDigits[16] = { '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F' };
+
+static uint8_t getNumberOfDecimalDigits(uint32_t aValue) {
+    uint8_t tNumberOfDigits = 1;
+    while (tNumberOfDigits < FORMAT_MAX_DECIMAL_DIGITS && aValue >= sPowersOfTen[tNumberOfDigits]) {
+        tNumberOfDigits++;
+    }
+    return tNumberOfDigits;
+}
+
+/*
+ * Writes exactly aNumberOfDigits digits, including leading zeros. No null termination.
+ */
+static char* writeDecimalDigits(char *aBuffer, uint32_t aValue, uint8_t aNumberOfDigits) {
+    while (aNumberOfDigits > 0) {
+        aNumberOfDigits--;
+        uint32_t tPowerOfTen = sPowersOfTen[aNumberOfDigits];
+        char tDigit = '0';
+        while (aValue >= tPowerOfTen) {
+            aValue -= tPowerOfTen;
+            tDigit++;
+        }
+        *aBuffer++ = tDigit;
+    }
+    return aBuffer;
+}
+
+/*
+ * Copies the unpadded number right aligned to aMinWidth into aBuffer and truncates it to aBufferSize - 1 characters.
+ * Zeros are padded behind a leading minus sign.
+ */
+static uint8_t copyPadded(char *aBuffer, uint8_t aBufferSize, const char *aNumberString, uint8_t aNumberLength,
+        uint8_t aMinWidth, char aPadChar) {
+    if (aBufferSize == 0) {
+        return 0;
+    }
+    uint8_t tMaxLength = aBufferSize - 1;
+    uint8_t tLength = 0;
+    uint8_t tPadCount = 0;
+    if (aMinWidth > aNumberLength) {
+        tPadCount = aMinWidth - aNumberLength;
+    }
+    if (aPadChar == FORMAT_PAD_ZERO && tPadCount > 0 && *aNumberString == '-') {
+        if (tLength < tMaxLength) {
+            aBuffer[tLength++] = '-';
+        }
+        aNumberString++;
+        aNumberLength--;
+    }
+    while (tPadCount > 0 && tLength < tMaxLength) {
+        aBuffer[tLength++] = aPadChar;
+        tPadCount--;
+    }
+    while (aNumberLength > 0 && tLength < tMaxLength) {
+        aBuffer[tLength++] = *aNumberString++;
+        aNumberLength--;
+    }
+    aBuffer[tLength] = '\0';
+    return tLength;
+}
+
+/*
+ * Writes optional sign and digits without null termination
+ * @return pointer behind the last digit
+ */
+static char* writeSignAndDigits(char *aBuffer, uint32_t aAbsoluteValue, bool aIsNegative) {
+    if (aIsNegative) {
+        *aBuffer++ = '-';
+    }
+    return writeDecimalDigits(aBuffer, aAbsoluteValue, getNumberOfDecimalDigits(aAbsoluteValue));
+}
+
+static uint8_t formatDecimal(char *aBuffer, uint8_t aBufferSize, uint32_t aAbsoluteValue, bool aIsNegative, uint8_t aMinWidth,
+        char aPadChar) {
+    char tNumberString[FORMAT_BUFFER_SIZE_FOR_LONG];
+    uint8_t tNumberLength = writeSignAndDigits(tNumberString, aAbsoluteValue, aIsNegative) - tNumberString;
+    return copyPadded(aBuffer, aBufferSize, tNumberString, tNumberLength, aMinWidth, aPadChar);
+}
+
+uint8_t formatUnsignedDecimal(char *aBuffer, uint8_t aBufferSize, uint32_t aValue, uint8_t aMinWidth, char aPadChar) {
+    return formatDecimal(aBuffer, aBufferSize, aValue, false, aMinWidth, aPadChar);
+}
+
+uint8_t formatSignedDecimal(char *aBuffer, uint8_t aBufferSize, int32_t aValue, uint8_t aMinWidth, char aPadChar) {
+    if (aValue < 0) {
+        // negate as unsigned to handle INT32_MIN
+        return formatDecimal(aBuffer, aBufferSize, 0UL - (uint32_t) aValue, true, aMinWidth, aPadChar);
+    }
+    return formatDecimal(aBuffer, aBufferSize, aValue, false, aMinWidth, aPadChar);
+}
+
+/*
+ * Upper case hex digits without "0x" prefix, zero padded to aMinNumberOfDigits like printf("%.*X")
+ */
+uint8_t formatHex(char *aBuffer, uint8_t aBufferSize, uint32_t aValue, uint8_t aMinNumberOfDigits) {
+    char tNumberString[FORMAT_MAX_HEX_DIGITS];
+    uint8_t tNumberOfDigits = FORMAT_MAX_HEX_DIGITS;
+    while (tNumberOfDigits > aMinNumberOfDigits && tNumberOfDigits > 1 && (aValue >> ((tNumberOfDigits - 1) * 4)) == 0) {
+        tNumberOfDigits--;
+    }
+    for (uint8_t i = 0; i < tNumberOfDigits; ++i) {
+        tNumberString[i] = sHexDigits[(aValue >> ((tNumberOfDigits - 1 - i) * 4)) & 0x0F];
+    }
+    return copyPadded(aBuffer, aBufferSize, tNumberString, tNumberOfDigits, aMinNumberOfDigits, FORMAT_PAD_ZERO);
+}
+
+/*
+ * Like printf("%*.*f", aMinWidth, aNumberOfDecimals, aValue).
+ * Integer part is saturated at 4294967295, which is sufficient for display purposes.
+ */
+uint8_t formatFloat(char *aBuffer, uint8_t aBufferSize, float aValue, uint8_t aMinWidth, uint8_t aNumberOfDecimals) {
+    if (aValue != aValue) {
+        return copyPadded(aBuffer, aBufferSize, "nan", 3, aMinWidth, FORMAT_PAD_SPACE);
+    }
+    if (aNumberOfDecimals > FORMAT_MAX_NUMBER_OF_DECIMALS) {
+        aNumberOfDecimals = FORMAT_MAX_NUMBER_OF_DECIMALS;
+    }
+    bool tIsNegative = false;
+    if (aValue < 0) {
+        tIsNegative = true;
+        aValue = -aValue;
+    }
+
+    uint32_t tIntegerPart = 0xFFFFFFFF;
+    uint32_t tFractionPart = 0;
+    if (aValue < 4294967295.0f) {
+        tIntegerPart = aValue;
+        uint32_t tFractionScale = sPowersOfTen[aNumberOfDecimals];
+        // round to requested number of decimals
+        tFractionPart = ((aValue - tIntegerPart) * tFractionScale) + 0.5f;
+        if (tFractionPart >= tFractionScale) {
+            tFractionPart -= tFractionScale;
+            tIntegerPart++;
+        }
+    }
+
+    char tNumberString[FORMAT_BUFFER_SIZE_FOR_FLOAT];
+    char *tNumberPointer = writeSignAndDigits(tNumberString, tIntegerPart, tIsNegative);
+    if (aNumberOfDecimals > 0) {
+        *tNumberPointer++ = '.';
+        tNumberPointer = writeDecimalDigits(tNumberPointer, tFractionPart, aNumberOfDecimals);
+    }
+    return copyPadded(aBuffer, aBufferSize, tNumberString, tNumberPointer - tNumberString, aMinWidth, FORMAT_PAD_SPACE);
+}
+
+#endif //_BDNUMBERFORMAT_HPP
+#pragma once
@@ -72,12 +72,12 @@ void BDSlider::init(uint16_t aPositionX, uint16_t aPositionY, uint16_t aBarWidth
 
     if (USART_isBluetoothPaired()) {
 #if __SIZEOF_POINTER__ == 4
-        sendUSARTArgs(FUNCTION_SLIDER_CREATE, 12, tSliderNumber, aPositionX, aPositionY, aBarWidth, aBarLength,
-                aThresholdValue, aInitalValue, aSliderColor, aBarColor, aFlags, aOnChangeHandler,
+        sendUSARTArgsWithColors(FUNCTION_SLIDER_CREATE, COLOR_PARAMETER(7), 12, tSliderNumber, aPositionX, aPositionY, aBarWidth,
+                aBarLength, aThresholdValue, aInitalValue, aSliderColor, aBarColor, aFlags, aOnChangeHandler,
                 (reinterpret_cast<uint32_t>(aOnChangeHandler) >> 16));
 #else
-        sendUSARTArgs(FUNCTION_SLIDER_CREATE, 11, tSliderNumber, aPositionX, aPositionY, aBarWidth, aBarLength, aThresholdValue,
-                aInitalValue, aSliderColor, aBarColor, aFlags, aOnChangeHandler);
+        sendUSARTArgsWithColors(FUNCTION_SLIDER_CREATE, COLOR_PARAMETER(7), 11, tSliderNumber, aPositionX, aPositionY, aBarWidth,
+                aBarLength, aThresholdValue, aInitalValue, aSliderColor, aBarColor, aFlags, aOnChangeHandler);
 #endif
     }
     mSliderHandle = tSliderNumber;
@@ -171,7 +171,8 @@ void BDSlider::setBarThresholdColor(color16_t aBarThresholdColor) {
     mLocalSliderPointer->setBarThresholdColor(aBarThresholdColor);
 #endif
     if (USART_isBluetoothPaired()) {
-        sendUSARTArgs(FUNCTION_SLIDER_SETTINGS, 3, mSliderHandle, SUBFUNCTION_SLIDER_SET_COLOR_THRESHOLD, aBarThresholdColor);
+        sendUSARTArgsWithColors(FUNCTION_SLIDER_SETTINGS, COLOR_PARAMETER(2), 3, mSliderHandle,
+                SUBFUNCTION_SLIDER_SET_COLOR_THRESHOLD, aBarThresholdColor);
     }
 }
 
@@ -193,7 +194,8 @@ void BDSlider::setBarBackgroundColor(color16_t aBarBackgroundColor) {
     mLocalSliderPointer->setBarBackgroundColor(aBarBackgroundColor);
 #endif
     if (USART_isBluetoothPaired()) {
-        sendUSARTArgs(FUNCTION_SLIDER_SETTINGS, 3, mSliderHandle, SUBFUNCTION_SLIDER_SET_COLOR_BAR_BACKGROUND, aBarBackgroundColor);
+        sendUSARTArgsWithColors(FUNCTION_SLIDER_SETTINGS, COLOR_PARAMETER(2), 3, mSliderHandle,
+                SUBFUNCTION_SLIDER_SET_COLOR_BAR_BACKGROUND, aBarBackgroundColor);
     }
 }
 
@@ -0,0 +1,174 @@
+/*
+ * BDVectorGroup.hpp
+ *
+ * Implementation of the vector group, which generalizes BlueDisplay::refreshVector() for many vectors.
+ *
+ *  SUMMARY
+ *  Blue Display is an Open Source Android remote Display for Arduino etc.
+ *  It receives basic draw requests from Arduino etc. over Bluetooth and renders it.
+ *  It also implements basic GUI elements as buttons and sliders.
+ *  GUI callback, touch and sensor events are sent back to Arduino.
+ *
+ *  Copyright (C) 2026  agent
+ *  agent@local
+ *
+ *  This file is part of BlueDisplay https://github.com/ArminJo/android-blue-display.
+ *
+ *  BlueDisplay is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+#ifndef _BDVECTORGROUP_HPP
+#define _BDVECTORGROUP_HPP
+
+#include "BDVectorGroup.h"
+#include "BlueDisplay.h"
+
+#include <math.h> // for sinf()
+
+BDVectorHandle_t sLocalVectorIndex = 0;
+
+BDVectorGroup::BDVectorGroup(void) { // @suppress("Class members should be properly initialized")
+    mNumberOfVectors = 0;
+    mDoHostRendering = false;
+}
+
+void BDVectorGroup::init(bool aDoHostRendering) {
+    mNumberOfVectors = 0;
+    mDoHostRendering = aDoHostRendering;
+}
+
+/**
+ * The vector is drawn at next update()
+ * @return index of vector in group or -1 if group is full or all host vector handles are used
+ */
+int8_t BDVectorGroup::addVector(uint16_t aStartX, uint16_t aStartY, uint16_t aLength, int16_t aThickness, color16_t aColor,
+        color16_t aBackgroundColor, int16_t aDegrees) {
+    if (mNumberOfVectors >= VECTOR_GROUP_MAX_SIZE || (mDoHostRendering && sLocalVectorIndex >= MAX_NUMBER_OF_HOST_VECTORS)) {
+        return -1;
+    }
+    struct BDVector *tVector = &mVectors[mNumberOfVectors];
+    tVector->StartX = aStartX;
+    tVector->StartY = aStartY;
+    tVector->Length = aLength;
+    tVector->Thickness = aThickness;
+    tVector->Color = aColor;
+    tVector->BackgroundColor = aBackgroundColor;
+    tVector->DrawnDegrees = VECTOR_DEGREES_NOT_DRAWN;
+    tVector->Degrees = aDegrees;
+    if (mDoHostRendering) {
+        tVector->VectorHandle = sLocalVectorIndex++;
+        if (USART_isBluetoothPaired()) {
+            sendUSARTArgsWithColors(FUNCTION_VECTOR_DEFINE, COLOR_PARAMETER(5) | COLOR_PARAMETER(6), 7, tVector->VectorHandle,
+                    aStartX, aStartY, aLength, aThickness, aColor, aBackgroundColor);
+        }
+    }
+    return mNumberOfVectors++;
+}
+
+/**
+ * Only stores the new value, drawing is done by update()
+ */
+void BDVectorGroup::setDegrees(uint8_t aVectorIndex, int16_t aDegrees) {
+    if (aVectorIndex < mNumberOfVectors) {
+        mVectors[aVectorIndex].Degrees = aDegrees;
+    }
+}
+
+/**
+ * Erases and draws all vectors with changed degrees
+ */
+void BDVectorGroup::update(void) {
+    updateVectors(false);
+}
+
+/**
+ * Draws all vectors, e.g. after clearDisplay()
+ */
+void BDVectorGroup::redraw(void) {
+    updateVectors(true);
+}
+
+void BDVectorGroup::updateVectors(bool aDoDrawAll) {
+    if (mDoHostRendering) {
+        /*
+         * One command with pairs of handle and degrees of the changed vectors
+         */
+        int16_t tHandlesAndDegrees[2 * VECTOR_GROUP_MAX_SIZE];
+        uint8_t tNumberOfChangedVectors = 0;
+        for (uint8_t i = 0; i < mNumberOfVectors; ++i) {
+            struct BDVector *tVector = &mVectors[i];
+            if (aDoDrawAll || tVector->Degrees != tVector->DrawnDegrees) {
+                tHandlesAndDegrees[2 * tNumberOfChangedVectors] = tVector->VectorHandle;
+                tHandlesAndDegrees[(2 * tNumberOfChangedVectors) + 1] = tVector->Degrees;
+                tNumberOfChangedVectors++;
+                tVector->DrawnDegrees = tVector->Degrees;
+            }
+        }
+        if (tNumberOfChangedVectors > 0 && USART_isBluetoothPaired()) {
+            sendUSARTArgsAndByteBuffer(FUNCTION_VECTOR_SET_DEGREES, 1, aDoDrawAll, tNumberOfChangedVectors * 2 * sizeof(int16_t),
+                    (uint8_t*) tHandlesAndDegrees);
+        }
+        return;
+    }
+
+    /*
+     * Client rendering. First erase all old vectors, then draw all new ones, so a vector is not damaged by erasing another one.
+     */
+    bool tFrameIsOpen = false;
+    for (uint8_t i = 0; i < mNumberOfVectors; ++i) {
+        struct BDVector *tVector = &mVectors[i];
+        if (tVector->Degrees != tVector->DrawnDegrees && tVector->DrawnDegrees != VECTOR_DEGREES_NOT_DRAWN) {
+            if (!tFrameIsOpen) {
+                BlueDisplay1.beginFrame();
+                tFrameIsOpen = true;
+            }
+            drawVector(tVector, tVector->DrawnDegrees, tVector->BackgroundColor);
+        }
+    }
+    for (uint8_t i = 0; i < mNumberOfVectors; ++i) {
+        struct BDVector *tVector = &mVectors[i];
+        if (aDoDrawAll || tVector->Degrees != tVector->DrawnDegrees) {
+            if (!tFrameIsOpen) {
+                BlueDisplay1.beginFrame();
+                tFrameIsOpen = true;
+            }
+            drawVector(tVector, tVector->Degrees, tVector->Color);
+            tVector->DrawnDegrees = tVector->Degrees;
+        }
+    }
+    if (tFrameIsOpen) {
+        BlueDisplay1.endFrame();
+    }
+}
+
+/*
+ * Uses drawLineWithThickness(), since drawVectorDegrees() has no local display support
+ */
+void BDVectorGroup::drawVector(struct BDVector *aVector, int16_t aDegrees, color16_t aColor) {
+    float tRadian = aDegrees * (float) (M_PI / 180.0);
+    int16_t tEndX = aVector->StartX + (int16_t) lroundf(cosf(tRadian) * aVector->Length);
+    int16_t tEndY = aVector->StartY - (int16_t) lroundf(sinf(tRadian) * aVector->Length);
+    BlueDisplay1.drawLineWithThickness(aVector->StartX, aVector->StartY, tEndX, tEndY, aVector->Thickness, aColor);
+}
+
+/*
+ * Static functions
+ */
+void BDVectorGroup::resetAllVectors(void) {
+    sLocalVectorIndex = 0;
+}
+
+#endif // _BDVECTORGROUP_HPP
+#pragma once
@@ -38,6 +38,8 @@
 #include "EventHandler.hpp"
 #include "BDButton.hpp"
 #include "BDSlider.hpp"
+#include "BDVectorGroup.hpp"
+#include "BDNumberFormat.hpp"
 
 #if defined(SUPPORT_LOCAL_DISPLAY)
 #include "thickLine.h"
@@ -45,9 +47,7 @@
 #endif
 
 #include <string.h>  // for strlen
-#include <stdio.h> /* for sprintf */
 #include <math.h> // for PI
-#include <stdlib.h> // for dtostrf()
 
 //-------------------- Constructor --------------------
 
@@ -55,6 +55,11 @@ BlueDisplay::BlueDisplay(void) { // @suppress("Class members should be properly
     mRequestedDisplaySize.XWidth = DISPLAY_DEFAULT_WIDTH;
     mRequestedDisplaySize.YHeight = DISPLAY_DEFAULT_HEIGHT;
     mBlueDisplayConnectionEstablished = false;
+    resetInternedStrings();
+    resetClip();
+    mColorPalette = NULL;
+    mClearDisplayCount = 0;
+    mNumberOfPaletteColors = 0;
 }
 
 // One instance of BlueDisplay called BlueDisplay1
@@ -130,6 +135,8 @@ void BlueDisplay::setFlagsAndSize(uint16_t aFlags, uint16_t aWidth, uint16_t aHe
             // reset local buttons to be synchronized
             BDButton::resetAllButtons();
             BDSlider::resetAllSliders();
+            // host string table is cleared by reset all
+            resetInternedStrings();
         }
         sendUSARTArgs(FUNCTION_GLOBAL_SETTINGS, 4, SUBFUNCTION_GLOBAL_SET_FLAGS_AND_SIZE, aFlags, aWidth, aHeight);
     }
@@ -219,6 +226,7 @@ void BlueDisplay::playFeedbackTone(uint8_t aToneType) {
 }
 
 void BlueDisplay::clearDisplay(color16_t aColor) {
+    mClearDisplayCount++;
 #if defined(SUPPORT_LOCAL_DISPLAY)
     LocalDisplay.clearDisplay(aColor);
 #endif
@@ -236,7 +244,7 @@ void BlueDisplay::clearDisplay(color16_t aColor) {
 //        tParamBuffer[1] = 1;
 //        tParamBuffer[2] = aColor;
 //        sendUSARTBufferNoSizeCheck((uint8_t*) &tParamBuffer[0], 1 * 2 + 4, NULL, 0);
-        sendUSARTArgs(FUNCTION_CLEAR_DISPLAY, 1, aColor);
+        sendUSARTArgsWithColors(FUNCTION_CLEAR_DISPLAY, COLOR_PARAMETER(0), 1, aColor);
     }
 }
 
@@ -245,8 +253,65 @@ void BlueDisplay::clearDisplay(color16_t aColor) {
  * Useful if we send commands faster than the display may able to handle, to avoid increasing delay between sending and rendering.
  */
 void BlueDisplay::clearDisplayOptional(color16_t aColor) {
+    mClearDisplayCount++;
     if (USART_isBluetoothPaired()) {
-        sendUSARTArgs(FUNCTION_CLEAR_DISPLAY_OPTIONAL, 1, aColor);
+        sendUSARTArgsWithColors(FUNCTION_CLEAR_DISPLAY_OPTIONAL, COLOR_PARAMETER(0), 1, aColor);
+    }
+}
+
+/**
+ * Host keeps showing the last frame, until endFrame() is called.
+ * @param aIsCompleteRedraw if true, the frame does not depend on the content of preceding frames
+ *        and the host may skip preceding frames, if it can not keep up with the client.
+ */
+void BlueDisplay::beginFrame(bool aIsCompleteRedraw) {
+    if (USART_isBluetoothPaired()) {
+        uint8_t tFunctionTag = FUNCTION_FRAME_BEGIN;
+        if (aIsCompleteRedraw) {
+            tFunctionTag = FUNCTION_FRAME_BEGIN_OPTIONAL;
+        }
+        sendUSARTArgs(tFunctionTag, 0);
+    }
+}
+
+/*
+ * Renders all drawings since beginFrame() at once
+ */
+void BlueDisplay::endFrame(void) {
+    if (USART_isBluetoothPaired()) {
+        sendUSARTArgs(FUNCTION_FRAME_END, 0);
+    }
+}
+
+/*
+ * Following drawings go to aLayer. Only supported by host, local display has only one layer.
+ * Layers are composited by host, so e.g. the traces of a chart on LAYER_FOREGROUND can be cleared by clearLayer()
+ * and redrawn without redrawing the grid and labels on LAYER_BACKGROUND, see Chart::setDataLayer().
+ */
+void BlueDisplay::selectLayer(uint8_t aLayer) {
+    if (USART_isBluetoothPaired()) {
+        sendUSARTArgs(FUNCTION_LAYER_SELECT, 1, aLayer);
+    }
+}
+
+/*
+ * Clears aLayer to transparent, layer 0 to white. Does not change the selected layer.
+ */
+void BlueDisplay::clearLayer(uint8_t aLayer) {
+    if (USART_isBluetoothPaired()) {
+        sendUSARTArgs(FUNCTION_LAYER_CLEAR, 1, aLayer);
+    }
+}
+
+/*
+ * Moves content of rectangle left and fills the exposed area at the right with aFillColor.
+ * Only supported by host, since local displays can not read back their content.
+ */
+void BlueDisplay::scrollRectLeft(uint16_t aXStart, uint16_t aYStart, uint16_t aWidth, uint16_t aHeight, uint16_t aNumberOfPixel,
+        color16_t aFillColor) {
+    if (USART_isBluetoothPaired()) {
+        sendUSARTArgsWithColors(FUNCTION_RECT_SCROLL_LEFT, COLOR_PARAMETER(5), 6, aXStart, aYStart, aWidth, aHeight, aNumberOfPixel,
+                aFillColor);
     }
 }
 
@@ -257,16 +322,184 @@ void BlueDisplay::drawDisplayDirect(void) {
     }
 }
 
+/*
+ * Clipping. Drawings, which are completely outside the clip rectangle, are skipped. Lines and filled rectangles are clipped.
+ * The other primitives are sent unchanged if they are partially visible.
+ */
+void BlueDisplay::setClipRect(int16_t aXStart, int16_t aYStart, int16_t aXEnd, int16_t aYEnd) {
+    mClipRect.XStart = aXStart;
+    mClipRect.YStart = aYStart;
+    mClipRect.XEnd = aXEnd;
+    mClipRect.YEnd = aYEnd;
+}
+
+/**
+ * Saves the current clip rectangle and sets the intersection of it with the new one, e.g. for drawing a panel
+ * @return false if stack is full, clip rectangle is unchanged then and popClip() must not be called
+ */
+bool BlueDisplay::pushClip(int16_t aXStart, int16_t aYStart, int16_t aXEnd, int16_t aYEnd) {
+    if (mClipStackDepth >= CLIP_STACK_SIZE) {
+        return false;
+    }
+    mClipStack[mClipStackDepth++] = mClipRect;
+    if (aXStart > mClipRect.XStart) {
+        mClipRect.XStart = aXStart;
+    }
+    if (aYStart > mClipRect.YStart) {
+        mClipRect.YStart = aYStart;
+    }
+    if (aXEnd < mClipRect.XEnd) {
+        mClipRect.XEnd = aXEnd;
+    }
+    if (aYEnd < mClipRect.YEnd) {
+        mClipRect.YEnd = aYEnd;
+    }
+    return true;
+}
+
+void BlueDisplay::popClip(void) {
+    if (mClipStackDepth > 0) {
+        mClipRect = mClipStack[--mClipStackDepth];
+    }
+}
+
+/*
+ * Disables clipping and clears clip stack
+ */
+void BlueDisplay::resetClip(void) {
+    setClipRect(INT16_MIN, INT16_MIN, INT16_MAX, INT16_MAX);
+    mClipStackDepth = 0;
+}
+
+bool BlueDisplay::isClipActive(void) {
+    return (mClipRect.XStart != INT16_MIN || mClipRect.YStart != INT16_MIN || mClipRect.XEnd != INT16_MAX
+            || mClipRect.YEnd != INT16_MAX);
+}
+
+/**
+ * @param aMargin is added on each side of the rectangle, e.g. for stroke width
+ * @return false if rectangle is completely outside the clip rectangle
+ */
+bool BlueDisplay::isRectVisible(int32_t aXStart, int32_t aYStart, int32_t aXEnd, int32_t aYEnd, int16_t aMargin) {
+    if (aXStart > aXEnd) {
+        int32_t tTemp = aXStart;
+        aXStart = aXEnd;
+        aXEnd = tTemp;
+    }
+    if (aYStart > aYEnd) {
+        int32_t tTemp = aYStart;
+        aYStart = aYEnd;
+        aYEnd = tTemp;
+    }
+    return (aXEnd + aMargin >= mClipRect.XStart && aXStart - aMargin <= mClipRect.XEnd && aYEnd + aMargin >= mClipRect.YStart
+            && aYStart - aMargin <= mClipRect.YEnd);
+}
+
+/**
+ * Text box is computed only if clipping is active, since measureText() must scan the string
+ * @param aPosY baseline position
+ */
+bool BlueDisplay::isTextVisible(uint16_t aPosX, uint16_t aPosY, const char *aStringPtr, uint16_t aTextSize) {
+    struct XYSize tTextSize = measureText(aStringPtr, aTextSize);
+    int32_t tYTop = (int32_t) aPosY - getTextAscend(aTextSize);
+    return isRectVisible(aPosX, tYTop, (int32_t) aPosX + tTextSize.XWidth - 1, tYTop + tTextSize.YHeight - 1);
+}
+
+#define CLIP_OUTCODE_LEFT   0x01
+#define CLIP_OUTCODE_RIGHT  0x02
+#define CLIP_OUTCODE_TOP    0x04
+#define CLIP_OUTCODE_BOTTOM 0x08
+
+static uint8_t getClipOutcode(int32_t aX, int32_t aY, int32_t aXMin, int32_t aYMin, int32_t aXMax, int32_t aYMax) {
+    uint8_t tOutcode = 0;
+    if (aX < aXMin) {
+        tOutcode = CLIP_OUTCODE_LEFT;
+    } else if (aX > aXMax) {
+        tOutcode = CLIP_OUTCODE_RIGHT;
+    }
+    if (aY < aYMin) {
+        tOutcode |= CLIP_OUTCODE_TOP;
+    } else if (aY > aYMax) {
+        tOutcode |= CLIP_OUTCODE_BOTTOM;
+    }
+    return tOutcode;
+}
+
+/**
+ * Cohen-Sutherland line clipping against the clip rectangle enlarged by aMargin. The direction of the line is kept.
+ * @return false if line is completely outside, then the values are undefined
+ */
+bool BlueDisplay::clipLine(int32_t *aXStart, int32_t *aYStart, int32_t *aXEnd, int32_t *aYEnd, int16_t aMargin) {
+    int32_t tXMin = (int32_t) mClipRect.XStart - aMargin;
+    int32_t tYMin = (int32_t) mClipRect.YStart - aMargin;
+    int32_t tXMax = (int32_t) mClipRect.XEnd + aMargin;
+    int32_t tYMax = (int32_t) mClipRect.YEnd + aMargin;
+    uint8_t tOutcodeStart = getClipOutcode(*aXStart, *aYStart, tXMin, tYMin, tXMax, tYMax);
+    uint8_t tOutcodeEnd = getClipOutcode(*aXEnd, *aYEnd, tXMin, tYMin, tXMax, tYMax);
+    while (true) {
+        if ((tOutcodeStart | tOutcodeEnd) == 0) {
+            return true;
+        }
+        if ((tOutcodeStart & tOutcodeEnd) != 0) {
+            return false;
+        }
+        // move the point outside to the border
+        uint8_t tOutcode = tOutcodeStart;
+        if (tOutcode == 0) {
+            tOutcode = tOutcodeEnd;
+        }
+        int32_t tDeltaX = *aXEnd - *aXStart;
+        int32_t tDeltaY = *aYEnd - *aYStart;
+        // 64 bit product, since delta and distance can both be up to 16 bit
+        int32_t tX, tY;
+        if (tOutcode & CLIP_OUTCODE_TOP) {
+            tY = tYMin;
+            tX = *aXStart + ((int64_t) tDeltaX * (tYMin - *aYStart)) / tDeltaY;
+        } else if (tOutcode & CLIP_OUTCODE_BOTTOM) {
+            tY = tYMax;
+            tX = *aXStart + ((int64_t) tDeltaX * (tYMax - *aYStart)) / tDeltaY;
+        } else if (tOutcode & CLIP_OUTCODE_RIGHT) {
+            tX = tXMax;
+            tY = *aYStart + ((int64_t) tDeltaY * (tXMax - *aXStart)) / tDeltaX;
+        } else {
+            tX = tXMin;
+            tY = *aYStart + ((int64_t) tDeltaY * (tXMin - *aXStart)) / tDeltaX;
+        }
+        if (tOutcode == tOutcodeStart) {
+            *aXStart = tX;
+            *aYStart = tY;
+            tOutcodeStart = getClipOutcode(tX, tY, tXMin, tYMin, tXMax, tYMax);
+        } else {
+            *aXEnd = tX;
+            *aYEnd = tY;
+            tOutcodeEnd = getClipOutcode(tX, tY, tXMin, tYMin, tXMax, tYMax);
+        }
+    }
+}
+
 void BlueDisplay::drawPixel(uint16_t aXPos, uint16_t aYPos, color16_t aColor) {
+    // coordinates are interpreted as signed by host
+    if (isClipActive() && !isRectVisible((int16_t) aXPos, (int16_t) aYPos, (int16_t) aXPos, (int16_t) aYPos)) {
+        return;
+    }
 #if defined(SUPPORT_LOCAL_DISPLAY)
     LocalDisplay.drawPixel(aXPos, aYPos, aColor);
 #endif
     if (USART_isBluetoothPaired()) {
-        sendUSARTArgs(FUNCTION_DRAW_PIXEL, 3, aXPos, aYPos, aColor);
+        sendUSARTArgsWithColors(FUNCTION_DRAW_PIXEL, COLOR_PARAMETER(2), 3, aXPos, aYPos, aColor);
     }
 }
 
 void BlueDisplay::drawLine(uint16_t aXStart, uint16_t aYStart, uint16_t aXEnd, uint16_t aYEnd, color16_t aColor) {
+    // coordinates are interpreted as signed by host
+    int32_t tXStart = (int16_t) aXStart, tYStart = (int16_t) aYStart, tXEnd = (int16_t) aXEnd, tYEnd = (int16_t) aYEnd;
+    if (!clipLine(&tXStart, &tYStart, &tXEnd, &tYEnd)) {
+        return;
+    }
+    aXStart = tXStart;
+    aYStart = tYStart;
+    aXEnd = tXEnd;
+    aYEnd = tYEnd;
 #if defined(SUPPORT_LOCAL_DISPLAY)
     LocalDisplay.drawLine(aXStart, aYStart, aXEnd, aYEnd, aColor);
 #endif
@@ -276,6 +509,17 @@ void BlueDisplay::drawLine(uint16_t aXStart, uint16_t aYStart, uint16_t aXEnd, u
 }
 
 void BlueDisplay::drawLineRel(uint16_t aXStart, uint16_t aYStart, uint16_t aXDelta, uint16_t aYDelta, color16_t aColor) {
+    // delta values are interpreted as signed by host
+    int32_t tXStart = (int16_t) aXStart, tYStart = (int16_t) aYStart;
+    int32_t tXEnd = tXStart + (int16_t) aXDelta;
+    int32_t tYEnd = tYStart + (int16_t) aYDelta;
+    if (!clipLine(&tXStart, &tYStart, &tXEnd, &tYEnd)) {
+        return;
+    }
+    aXStart = tXStart;
+    aYStart = tYStart;
+    aXDelta = tXEnd - tXStart;
+    aYDelta = tYEnd - tYStart;
 #if defined(SUPPORT_LOCAL_DISPLAY)
     LocalDisplay.drawLine(aXStart, aYStart, aXStart + aXDelta, aYStart + aYDelta, aColor);
 #endif
@@ -291,6 +535,11 @@ void BlueDisplay::drawLineRel(uint16_t aXStart, uint16_t aYStart, uint16_t aXDel
  * uses setArea instead if drawPixel to speed up drawing
  */
 void BlueDisplay::drawLineFastOneX(uint16_t aXStart, uint16_t aYStart, uint16_t aYEnd, color16_t aColor) {
+    if (isClipActive()) {
+        // clipping is done by drawLine()
+        drawLine(aXStart, aYStart, aXStart + 1, aYEnd, aColor);
+        return;
+    }
 #if defined(SUPPORT_LOCAL_DISPLAY)
     LocalDisplay.drawLineFastOneX(aXStart, aYStart, aYEnd, aColor);
 #endif
@@ -305,9 +554,13 @@ void BlueDisplay::drawLineFastOneX(uint16_t aXStart, uint16_t aYStart, uint16_t
  */
 void BlueDisplay::drawVectorDegrees(uint16_t aXStart, uint16_t aYStart, uint16_t aLength, int aDegrees, color16_t aColor,
         int16_t aThickness) {
+    if (!isRectVisible(aXStart, aYStart, aXStart, aYStart, aLength + aThickness)) {
+        return;
+    }
 
     if (USART_isBluetoothPaired()) {
-        sendUSARTArgs(FUNCTION_DRAW_VECTOR_DEGREE, 6, aXStart, aYStart, aLength, aDegrees, aColor, aThickness);
+        sendUSARTArgsWithColors(FUNCTION_DRAW_VECTOR_DEGREE, COLOR_PARAMETER(4), 6, aXStart, aYStart, aLength, aDegrees, aColor,
+                aThickness);
     }
 }
 
@@ -316,6 +569,9 @@ void BlueDisplay::drawVectorDegrees(uint16_t aXStart, uint16_t aYStart, uint16_t
  */
 void BlueDisplay::drawVectorRadian(uint16_t aXStart, uint16_t aYStart, uint16_t aLength, float aRadian, color16_t aColor,
         int16_t aThickness) {
+    if (!isRectVisible(aXStart, aYStart, aXStart, aYStart, aLength + aThickness)) {
+        return;
+    }
 
     if (USART_isBluetoothPaired()) {
         union {
@@ -323,52 +579,111 @@ void BlueDisplay::drawVectorRadian(uint16_t aXStart, uint16_t aYStart, uint16_t
             uint16_t shortArray[2];
         } floatToShortArray;
         floatToShortArray.floatValue = aRadian;
-        sendUSARTArgs(FUNCTION_DRAW_VECTOR_DEGREE, 7, aXStart, aYStart, aLength, floatToShortArray.shortArray[0],
-                floatToShortArray.shortArray[1], aColor, aThickness);
+        sendUSARTArgsWithColors(FUNCTION_DRAW_VECTOR_DEGREE, COLOR_PARAMETER(5), 7, aXStart, aYStart, aLength,
+                floatToShortArray.shortArray[0], floatToShortArray.shortArray[1], aColor, aThickness);
     }
 }
 
 void BlueDisplay::drawLineWithThickness(uint16_t aXStart, uint16_t aYStart, uint16_t aXEnd, uint16_t aYEnd, int16_t aThickness,
         color16_t aColor) {
+    // coordinates are interpreted as signed by host
+    int32_t tXStart = (int16_t) aXStart, tYStart = (int16_t) aYStart, tXEnd = (int16_t) aXEnd, tYEnd = (int16_t) aYEnd;
+    // clip the center line against the clip rectangle enlarged by half of the thickness
+    if (!clipLine(&tXStart, &tYStart, &tXEnd, &tYEnd, (aThickness + 1) / 2)) {
+        return;
+    }
+    aXStart = tXStart;
+    aYStart = tYStart;
+    aXEnd = tXEnd;
+    aYEnd = tYEnd;
 #if defined(SUPPORT_LOCAL_DISPLAY)
     drawThickLine(aXStart, aYStart, aXEnd, aYEnd, aThickness, LINE_THICKNESS_MIDDLE, aColor);
 #endif
     if (USART_isBluetoothPaired()) {
-        sendUSARTArgs(FUNCTION_DRAW_LINE, 6, aXStart, aYStart, aXEnd, aYEnd, aColor, aThickness);
+        sendUSARTArgsWithColors(FUNCTION_DRAW_LINE, COLOR_PARAMETER(4), 6, aXStart, aYStart, aXEnd, aYEnd, aColor, aThickness);
     }
 }
 
 void BlueDisplay::drawLineRelWithThickness(uint16_t aXStart, uint16_t aYStart, uint16_t aXDelta, uint16_t aYDelta,
         int16_t aThickness, color16_t aColor) {
+    int32_t tXStart = (int16_t) aXStart, tYStart = (int16_t) aYStart;
+    int32_t tXEnd = tXStart + (int16_t) aXDelta;
+    int32_t tYEnd = tYStart + (int16_t) aYDelta;
+    if (!clipLine(&tXStart, &tYStart, &tXEnd, &tYEnd, (aThickness + 1) / 2)) {
+        return;
+    }
+    aXStart = tXStart;
+    aYStart = tYStart;
+    aXDelta = tXEnd - tXStart;
+    aYDelta = tYEnd - tYStart;
 #if defined(SUPPORT_LOCAL_DISPLAY)
-    drawThickLine(aXStart, aYStart, aXDelta, aYDelta, aThickness, LINE_THICKNESS_MIDDLE, aColor);
+    drawThickLine(aXStart, aYStart, tXEnd, tYEnd, aThickness, LINE_THICKNESS_MIDDLE, aColor);
 #endif
     if (USART_isBluetoothPaired()) {
-        sendUSARTArgs(FUNCTION_DRAW_LINE_REL, 6, aXStart, aYStart, aXDelta, aYDelta, aColor, aThickness);
+        sendUSARTArgsWithColors(FUNCTION_DRAW_LINE_REL, COLOR_PARAMETER(4), 6, aXStart, aYStart, aXDelta, aYDelta, aColor,
+                aThickness);
     }
 }
 
 void BlueDisplay::drawRect(uint16_t aXStart, uint16_t aYStart, uint16_t aXEnd, uint16_t aYEnd, color16_t aColor,
         uint16_t aStrokeWidth) {
+    if (!isRectVisible(aXStart, aYStart, aXEnd, aYEnd, aStrokeWidth)) {
+        return;
+    }
 #if defined(SUPPORT_LOCAL_DISPLAY)
     LocalDisplay.drawRect(aXStart, aYStart, aXEnd - 1, aYEnd - 1, aColor);
 #endif
     if (USART_isBluetoothPaired()) {
-        sendUSARTArgs(FUNCTION_DRAW_RECT, 6, aXStart, aYStart, aXEnd, aYEnd, aColor, aStrokeWidth);
+        sendUSARTArgsWithColors(FUNCTION_DRAW_RECT, COLOR_PARAMETER(4), 6, aXStart, aYStart, aXEnd, aYEnd, aColor, aStrokeWidth);
     }
 }
 
 void BlueDisplay::drawRectRel(uint16_t aXStart, uint16_t aYStart, uint16_t aWidth, uint16_t aHeight, color16_t aColor,
         uint16_t aStrokeWidth) {
+    if (!isRectVisible(aXStart, aYStart, aXStart + aWidth - 1, aYStart + aHeight - 1, aStrokeWidth)) {
+        return;
+    }
 #if defined(SUPPORT_LOCAL_DISPLAY)
     LocalDisplay.drawRect(aXStart, aYStart, aXStart + aWidth - 1, aYStart + aHeight - 1, aColor);
 #endif
     if (USART_isBluetoothPaired()) {
-        sendUSARTArgs(FUNCTION_DRAW_RECT_REL, 6, aXStart, aYStart, aWidth, aHeight, aColor, aStrokeWidth);
+        sendUSARTArgsWithColors(FUNCTION_DRAW_RECT_REL, COLOR_PARAMETER(4), 6, aXStart, aYStart, aWidth, aHeight, aColor,
+                aStrokeWidth);
     }
 }
 
 void BlueDisplay::fillRect(uint16_t aXStart, uint16_t aYStart, uint16_t aXEnd, uint16_t aYEnd, color16_t aColor) {
+    // coordinates are interpreted as signed by host, corners are sorted before clipping
+    int32_t tXStart = (int16_t) aXStart, tYStart = (int16_t) aYStart, tXEnd = (int16_t) aXEnd, tYEnd = (int16_t) aYEnd;
+    if (tXStart > tXEnd) {
+        int32_t tTemp = tXStart;
+        tXStart = tXEnd;
+        tXEnd = tTemp;
+    }
+    if (tYStart > tYEnd) {
+        int32_t tTemp = tYStart;
+        tYStart = tYEnd;
+        tYEnd = tTemp;
+    }
+    if (!isRectVisible(tXStart, tYStart, tXEnd, tYEnd)) {
+        return;
+    }
+    if (tXStart < mClipRect.XStart) {
+        tXStart = mClipRect.XStart;
+    }
+    if (tYStart < mClipRect.YStart) {
+        tYStart = mClipRect.YStart;
+    }
+    if (tXEnd > mClipRect.XEnd) {
+        tXEnd = mClipRect.XEnd;
+    }
+    if (tYEnd > mClipRect.YEnd) {
+        tYEnd = mClipRect.YEnd;
+    }
+    aXStart = tXStart;
+    aYStart = tYStart;
+    aXEnd = tXEnd;
+    aYEnd = tYEnd;
 #if defined(SUPPORT_LOCAL_DISPLAY)
     LocalDisplay.fillRect(aXStart, aYStart, aXEnd, aYEnd, aColor);
 #endif
@@ -378,6 +693,11 @@ void BlueDisplay::fillRect(uint16_t aXStart, uint16_t aYStart, uint16_t aXEnd, u
 }
 
 void BlueDisplay::fillRectRel(uint16_t aXStart, uint16_t aYStart, uint16_t aWidth, uint16_t aHeight, color16_t aColor) {
+    if (isClipActive()) {
+        // clipping is done by fillRect()
+        fillRect(aXStart, aYStart, aXStart + aWidth - 1, aYStart + aHeight - 1, aColor);
+        return;
+    }
 #if defined(SUPPORT_LOCAL_DISPLAY)
     LocalDisplay.fillRect(aXStart, aYStart, aXStart + aWidth - 1, aYStart + aHeight - 1, aColor);
 #endif
@@ -387,20 +707,26 @@ void BlueDisplay::fillRectRel(uint16_t aXStart, uint16_t aYStart, uint16_t aWidt
 }
 
 void BlueDisplay::drawCircle(uint16_t aXCenter, uint16_t aYCenter, uint16_t aRadius, color16_t aColor, uint16_t aStrokeWidth) {
+    if (!isRectVisible(aXCenter, aYCenter, aXCenter, aYCenter, aRadius + aStrokeWidth)) {
+        return;
+    }
 #if defined(SUPPORT_LOCAL_DISPLAY)
     LocalDisplay.drawCircle(aXCenter, aYCenter, aRadius, aColor);
 #endif
     if (USART_isBluetoothPaired()) {
-        sendUSART5Args(FUNCTION_DRAW_CIRCLE, aXCenter, aYCenter, aRadius, aColor, aStrokeWidth);
+        sendUSARTArgsWithColors(FUNCTION_DRAW_CIRCLE, COLOR_PARAMETER(3), 5, aXCenter, aYCenter, aRadius, aColor, aStrokeWidth);
     }
 }
 
 void BlueDisplay::fillCircle(uint16_t aXCenter, uint16_t aYCenter, uint16_t aRadius, color16_t aColor) {
+    if (!isRectVisible(aXCenter, aYCenter, aXCenter, aYCenter, aRadius)) {
+        return;
+    }
 #if defined(SUPPORT_LOCAL_DISPLAY)
     LocalDisplay.fillCircle(aXCenter, aYCenter, aRadius, aColor);
 #endif
     if (USART_isBluetoothPaired()) {
-        sendUSARTArgs(FUNCTION_FILL_CIRCLE, 4, aXCenter, aYCenter, aRadius, aColor);
+        sendUSARTArgsWithColors(FUNCTION_FILL_CIRCLE, COLOR_PARAMETER(3), 4, aXCenter, aYCenter, aRadius, aColor);
     }
 }
 
@@ -412,13 +738,18 @@ void BlueDisplay::fillCircle(uint16_t aXCenter, uint16_t aYCenter, uint16_t aRad
 uint16_t BlueDisplay::drawChar(uint16_t aPosX, uint16_t aPosY, char aChar, uint16_t aCharSize, color16_t aFGColor,
         color16_t aBGColor) {
     uint16_t tRetValue = 0;
+    if (!isRectVisible(aPosX, aPosY - getTextAscend(aCharSize), aPosX + getTextWidth(aCharSize) - 1,
+            aPosY + getTextDecend(aCharSize))) {
+        return aPosX + getTextWidth(aCharSize);
+    }
 #if defined(SUPPORT_LOCAL_DISPLAY)
     tRetValue = LocalDisplay.drawChar(aPosX, aPosY - getTextAscend(aCharSize), aChar, getLocalTextSize(aCharSize), aFGColor,
             aBGColor);
 #endif
     if (USART_isBluetoothPaired()) {
         tRetValue = aPosX + getTextWidth(aCharSize);
-        sendUSARTArgs(FUNCTION_DRAW_CHAR, 6, aPosX, aPosY, aCharSize, aFGColor, aBGColor, aChar);
+        sendUSARTArgsWithColors(FUNCTION_DRAW_CHAR, COLOR_PARAMETER(3) | COLOR_PARAMETER(4), 6, aPosX, aPosY, aCharSize, aFGColor,
+                aBGColor, aChar);
     }
     return tRetValue;
 }
@@ -435,14 +766,39 @@ uint16_t BlueDisplay::drawChar(uint16_t aPosX, uint16_t aPosY, char aChar, uint1
 uint16_t BlueDisplay::drawText(uint16_t aPosX, uint16_t aPosY, const char *aStringPtr, uint16_t aTextSize, color16_t aFGColor,
         color16_t aBGColor) {
     uint16_t tRetValue = 0;
+    if (isClipActive() && !isTextVisible(aPosX, aPosY, aStringPtr, aTextSize)) {
+        return aPosX + strlen(aStringPtr) * getTextWidth(aTextSize);
+    }
+#if defined(SUPPORT_LOCAL_DISPLAY)
+    tRetValue = LocalDisplay.drawText(aPosX, aPosY - getTextAscend(aTextSize), (char *) aStringPtr, getLocalTextSize(aTextSize),
+            aFGColor, aBGColor);
+#endif
+    if (USART_isBluetoothPaired()) {
+        tRetValue = aPosX + strlen(aStringPtr) * getTextWidth(aTextSize);
+        sendUSARTArgsWithColorsAndByteBuffer(FUNCTION_DRAW_STRING, COLOR_PARAMETER(3) | COLOR_PARAMETER(4), 5, aPosX, aPosY,
+                aTextSize, aFGColor, aBGColor, strlen(aStringPtr), (uint8_t*) aStringPtr);
+    }
+    return tRetValue;
+}
+
+/**
+ * Like drawText(), but for constant strings, which are sent only at first call or if dropped from the string table
+ */
+uint16_t BlueDisplay::drawInternedText(uint16_t aPosX, uint16_t aPosY, const char *aStringPtr, uint16_t aTextSize,
+        color16_t aFGColor, color16_t aBGColor) {
+    uint16_t tRetValue = 0;
+    if (isClipActive() && !isTextVisible(aPosX, aPosY, aStringPtr, aTextSize)) {
+        // string is not defined at host until it is really drawn
+        return aPosX + strlen(aStringPtr) * getTextWidth(aTextSize);
+    }
 #if defined(SUPPORT_LOCAL_DISPLAY)
     tRetValue = LocalDisplay.drawText(aPosX, aPosY - getTextAscend(aTextSize), (char *) aStringPtr, getLocalTextSize(aTextSize),
             aFGColor, aBGColor);
 #endif
     if (USART_isBluetoothPaired()) {
         tRetValue = aPosX + strlen(aStringPtr) * getTextWidth(aTextSize);
-        sendUSARTArgsAndByteBuffer(FUNCTION_DRAW_STRING, 5, aPosX, aPosY, aTextSize, aFGColor, aBGColor, strlen(aStringPtr),
-                (uint8_t*) aStringPtr);
+        sendUSARTArgsWithColors(FUNCTION_DRAW_STRING_BY_ID, COLOR_PARAMETER(3) | COLOR_PARAMETER(4), 6, aPosX, aPosY, aTextSize,
+                aFGColor, aBGColor, getStringId(aStringPtr));
     }
     return tRetValue;
 }
@@ -460,19 +816,15 @@ uint16_t BlueDisplay::drawByte(uint16_t aPosX, uint16_t aPosY, int8_t aByte, uin
         color16_t aBGColor) {
     uint16_t tRetValue = 0;
     char tStringBuffer[5];
-#if defined(AVR)
-    sprintf_P(tStringBuffer, PSTR("%4hhd"), aByte);
-#else
-    sprintf(tStringBuffer, "%4hhd", aByte);
-#endif
+    formatSignedDecimal(tStringBuffer, sizeof(tStringBuffer), aByte, 4);
 #if defined(SUPPORT_LOCAL_DISPLAY)
     tRetValue = LocalDisplay.drawText(aPosX, aPosY - getTextAscend(aTextSize), tStringBuffer, getLocalTextSize(aTextSize), aFGColor,
             aBGColor);
 #endif
     if (USART_isBluetoothPaired()) {
         tRetValue = aPosX + 4 * getTextWidth(aTextSize);
-        sendUSARTArgsAndByteBuffer(FUNCTION_DRAW_STRING, 5, aPosX, aPosY, aTextSize, aFGColor, aBGColor, 4,
-                (uint8_t*) tStringBuffer);
+        sendUSARTArgsWithColorsAndByteBuffer(FUNCTION_DRAW_STRING, COLOR_PARAMETER(3) | COLOR_PARAMETER(4), 5, aPosX, aPosY,
+                aTextSize, aFGColor, aBGColor, 4, (uint8_t*) tStringBuffer);
     }
     return tRetValue;
 }
@@ -481,19 +833,15 @@ uint16_t BlueDisplay::drawUnsignedByte(uint16_t aPosX, uint16_t aPosY, uint8_t a
         color16_t aFGColor, color16_t aBGColor) {
     uint16_t tRetValue = 0;
     char tStringBuffer[4];
-#if defined(AVR)
-    sprintf_P(tStringBuffer, PSTR("%3u"), aUnsignedByte);
-#else
-    sprintf(tStringBuffer, "%3u", aUnsignedByte);
-#endif
+    formatUnsignedDecimal(tStringBuffer, sizeof(tStringBuffer), aUnsignedByte, 3);
 #if defined(SUPPORT_LOCAL_DISPLAY)
     tRetValue = LocalDisplay.drawText(aPosX, aPosY - getTextAscend(aTextSize), tStringBuffer, getLocalTextSize(aTextSize), aFGColor,
             aBGColor);
 #endif
     if (USART_isBluetoothPaired()) {
         tRetValue = aPosX + 3 * getTextWidth(aTextSize);
-        sendUSARTArgsAndByteBuffer(FUNCTION_DRAW_STRING, 5, aPosX, aPosY, aTextSize, aFGColor, aBGColor, 3,
-                (uint8_t*) tStringBuffer);
+        sendUSARTArgsWithColorsAndByteBuffer(FUNCTION_DRAW_STRING, COLOR_PARAMETER(3) | COLOR_PARAMETER(4), 5, aPosX, aPosY,
+                aTextSize, aFGColor, aBGColor, 3, (uint8_t*) tStringBuffer);
     }
     return tRetValue;
 }
@@ -502,19 +850,15 @@ uint16_t BlueDisplay::drawShort(uint16_t aPosX, uint16_t aPosY, int16_t aShort,
         color16_t aBGColor) {
     uint16_t tRetValue = 0;
     char tStringBuffer[7];
-#if defined(AVR)
-    sprintf_P(tStringBuffer, PSTR("%6hd"), aShort);
-#else
-    sprintf(tStringBuffer, "%6hd", aShort);
-#endif
+    formatSignedDecimal(tStringBuffer, sizeof(tStringBuffer), aShort, 6);
 #if defined(SUPPORT_LOCAL_DISPLAY)
     tRetValue = LocalDisplay.drawText(aPosX, aPosY - getTextAscend(aTextSize), tStringBuffer, getLocalTextSize(aTextSize), aFGColor,
             aBGColor);
 #endif
     if (USART_isBluetoothPaired()) {
         tRetValue = aPosX + 6 * getTextWidth(aTextSize);
-        sendUSARTArgsAndByteBuffer(FUNCTION_DRAW_STRING, 5, aPosX, aPosY, aTextSize, aFGColor, aBGColor, 6,
-                (uint8_t*) tStringBuffer);
+        sendUSARTArgsWithColorsAndByteBuffer(FUNCTION_DRAW_STRING, COLOR_PARAMETER(3) | COLOR_PARAMETER(4), 5, aPosX, aPosY,
+                aTextSize, aFGColor, aBGColor, 6, (uint8_t*) tStringBuffer);
     }
     return tRetValue;
 }
@@ -522,22 +866,16 @@ uint16_t BlueDisplay::drawShort(uint16_t aPosX, uint16_t aPosY, int16_t aShort,
 uint16_t BlueDisplay::drawLong(uint16_t aPosX, uint16_t aPosY, int32_t aLong, uint16_t aTextSize, color16_t aFGColor,
         color16_t aBGColor) {
     uint16_t tRetValue = 0;
-    char tStringBuffer[12];
-#if defined(AVR)
-    sprintf_P(tStringBuffer, PSTR("%11ld"), aLong);
-#elif defined(__XTENSA__)
-    sprintf(tStringBuffer, "%11ld", (long)aLong);
-#else
-    sprintf(tStringBuffer, "%11ld", aLong);
-#endif
+    char tStringBuffer[FORMAT_BUFFER_SIZE_FOR_LONG];
+    formatSignedDecimal(tStringBuffer, sizeof(tStringBuffer), aLong, 11);
 #if defined(SUPPORT_LOCAL_DISPLAY)
     tRetValue = LocalDisplay.drawText(aPosX, aPosY - getTextAscend(aTextSize), tStringBuffer, getLocalTextSize(aTextSize), aFGColor,
             aBGColor);
 #endif
     if (USART_isBluetoothPaired()) {
         tRetValue = aPosX + 11 * getTextWidth(aTextSize);
-        sendUSARTArgsAndByteBuffer(FUNCTION_DRAW_STRING, 5, aPosX, aPosY, aTextSize, aFGColor, aBGColor, 11,
-                (uint8_t*) tStringBuffer);
+        sendUSARTArgsWithColorsAndByteBuffer(FUNCTION_DRAW_STRING, COLOR_PARAMETER(3) | COLOR_PARAMETER(4), 5, aPosX, aPosY,
+                aTextSize, aFGColor, aBGColor, 11, (uint8_t*) tStringBuffer);
     }
     return tRetValue;
 }
@@ -551,8 +889,8 @@ void BlueDisplay::setWriteStringSizeAndColorAndFlag(uint16_t aPrintSize, color16
     printSetOptions(getLocalTextSize(aPrintSize), aPrintColor, aPrintBackgroundColor, aClearOnNewScreen);
 #endif
     if (USART_isBluetoothPaired()) {
-        sendUSART5Args(FUNCTION_WRITE_SETTINGS, FLAG_WRITE_SETTINGS_SET_SIZE_AND_COLORS_AND_FLAGS, aPrintSize, aPrintColor,
-                aPrintBackgroundColor, aClearOnNewScreen);
+        sendUSARTArgsWithColors(FUNCTION_WRITE_SETTINGS, COLOR_PARAMETER(2) | COLOR_PARAMETER(3), 5,
+                FLAG_WRITE_SETTINGS_SET_SIZE_AND_COLORS_AND_FLAGS, aPrintSize, aPrintColor, aPrintBackgroundColor, aClearOnNewScreen);
     }
 }
 
@@ -608,150 +946,138 @@ void BlueDisplay::debug(const char *aStringPtr) {
     }
 }
 
+/*
+ * Formats e.g. "  -1 0xFF" for the debug() functions.
+ * aHexDigits < 8 masks the value, so that negative bytes and shorts are not sign extended.
+ */
+static uint8_t formatDecimalAndHex(char *aBuffer, uint8_t aBufferSize, uint32_t aValue, bool aIsSigned, uint8_t aDecimalWidth,
+        uint8_t aHexDigits) {
+    uint8_t tLength;
+    if (aIsSigned) {
+        tLength = formatSignedDecimal(aBuffer, aBufferSize, (int32_t) aValue, aDecimalWidth);
+    } else {
+        tLength = formatUnsignedDecimal(aBuffer, aBufferSize, aValue, aDecimalWidth);
+    }
+    if (tLength + 3 >= aBufferSize) {
+        // no space for " 0x" and a hex digit
+        return tLength;
+    }
+    aBuffer[tLength++] = ' ';
+    aBuffer[tLength++] = '0';
+    aBuffer[tLength++] = 'x';
+    if (aHexDigits < FORMAT_MAX_HEX_DIGITS) {
+        aValue &= (1UL << (aHexDigits * 4)) - 1;
+    }
+    return tLength + formatHex(&aBuffer[tLength], aBufferSize - tLength, aValue, aHexDigits);
+}
+
+/*
+ * Prepends aMessage to the already formatted value.
+ * The message is truncated, so that the value always fits into STRING_BUFFER_STACK_SIZE_FOR_DEBUG_WITH_MESSAGE.
+ */
+static void sendDebugMessageAndValue(const char *aMessage, const char *aValueString, uint8_t aValueLength) {
+    char tStringBuffer[STRING_BUFFER_STACK_SIZE_FOR_DEBUG_WITH_MESSAGE];
+    size_t tMessageLength = strlen(aMessage);
+    if (tMessageLength > (STRING_BUFFER_STACK_SIZE_FOR_DEBUG_WITH_MESSAGE - aValueLength)) {
+        tMessageLength = STRING_BUFFER_STACK_SIZE_FOR_DEBUG_WITH_MESSAGE - aValueLength;
+    }
+    memcpy(tStringBuffer, aMessage, tMessageLength);
+    memcpy(&tStringBuffer[tMessageLength], aValueString, aValueLength);
+    sendUSARTArgsAndByteBuffer(FUNCTION_DEBUG_STRING, 0, tMessageLength + aValueLength, tStringBuffer);
+}
+
 /**
  * Output as warning to log and present as toast every 500 ms
  */
 void BlueDisplay::debug(uint8_t aByte) {
-    char tStringBuffer[9];
-// hhu -> unsigned char instead of unsigned int with u
-#if defined(AVR)
-    sprintf_P(tStringBuffer, PSTR("%3hhu 0x%2.2hhX"), aByte, aByte);
-#else
-    sprintf(tStringBuffer, "%3hhu 0x%2.2hhX", aByte, aByte);
-#endif
+    char tStringBuffer[9]; // 3 decimal + 3 " 0x" + 2 hex +1
+    uint8_t tLength = formatDecimalAndHex(tStringBuffer, sizeof(tStringBuffer), aByte, false, 3, 2);
     if (USART_isBluetoothPaired()) {
-        sendUSARTArgsAndByteBuffer(FUNCTION_DEBUG_STRING, 0, strlen(tStringBuffer), tStringBuffer);
+        sendUSARTArgsAndByteBuffer(FUNCTION_DEBUG_STRING, 0, tLength, tStringBuffer);
     }
 }
 
 /*
- * Maximum size of aMessage string is 25 character.
+ * Maximum size of aMessage string is 26 character.
  */
 void BlueDisplay::debug(const char *aMessage, uint8_t aByte) {
-    char tStringBuffer[STRING_BUFFER_STACK_SIZE_FOR_DEBUG_WITH_MESSAGE];
-// hhu -> unsigned char instead of unsigned int with u
-#if defined(AVR)
-    snprintf_P(tStringBuffer, STRING_BUFFER_STACK_SIZE_FOR_DEBUG_WITH_MESSAGE, PSTR("%s%3hhu 0x%2.2hhX"), aMessage, aByte, aByte);
-#else
-    snprintf(tStringBuffer, STRING_BUFFER_STACK_SIZE_FOR_DEBUG_WITH_MESSAGE, "%s%3hhu 0x%2.2hhX", aMessage, aByte, aByte);
-#endif
+    char tStringBuffer[9];
+    uint8_t tLength = formatDecimalAndHex(tStringBuffer, sizeof(tStringBuffer), aByte, false, 3, 2);
     if (USART_isBluetoothPaired()) {
-        sendUSARTArgsAndByteBuffer(FUNCTION_DEBUG_STRING, 0, strlen(tStringBuffer), tStringBuffer);
+        sendDebugMessageAndValue(aMessage, tStringBuffer, tLength);
     }
 }
 
 /*
- * Maximum size of aMessage string is 24 character.
+ * Maximum size of aMessage string is 25 character.
  */
 void BlueDisplay::debug(const char *aMessage, int8_t aByte) {
-    char tStringBuffer[STRING_BUFFER_STACK_SIZE_FOR_DEBUG_WITH_MESSAGE];
-// hhd -> signed char instead of signed int with d
-#if defined(AVR)
-    snprintf_P(tStringBuffer, STRING_BUFFER_STACK_SIZE_FOR_DEBUG_WITH_MESSAGE, PSTR("%s%4hhd 0x%2.2hhX"), aMessage, aByte, aByte);
-#else
-    snprintf(tStringBuffer, STRING_BUFFER_STACK_SIZE_FOR_DEBUG_WITH_MESSAGE, "%s%4hhd 0x%2.2hhX", aMessage, aByte, aByte);
-#endif
+    char tStringBuffer[10];
+    uint8_t tLength = formatDecimalAndHex(tStringBuffer, sizeof(tStringBuffer), aByte, true, 4, 2);
     if (USART_isBluetoothPaired()) {
-        sendUSARTArgsAndByteBuffer(FUNCTION_DEBUG_STRING, 0, strlen(tStringBuffer), tStringBuffer);
+        sendDebugMessageAndValue(aMessage, tStringBuffer, tLength);
     }
 }
 
 void BlueDisplay::debug(int8_t aByte) {
-    char tStringBuffer[10];
-// hhd -> signed char instead of int with d
-#if defined(AVR)
-    sprintf_P(tStringBuffer, PSTR("%4hhd 0x%2.2hhX"), aByte, aByte);
-#else
-    sprintf(tStringBuffer, "%4hhd 0x%2.2hhX", aByte, aByte);
-#endif
+    char tStringBuffer[10]; // 4 decimal + 3 " 0x" + 2 hex +1
+    uint8_t tLength = formatDecimalAndHex(tStringBuffer, sizeof(tStringBuffer), aByte, true, 4, 2);
     if (USART_isBluetoothPaired()) {
-        sendUSARTArgsAndByteBuffer(FUNCTION_DEBUG_STRING, 0, strlen(tStringBuffer), tStringBuffer);
+        sendUSARTArgsAndByteBuffer(FUNCTION_DEBUG_STRING, 0, tLength, tStringBuffer);
     }
 }
 
 void BlueDisplay::debug(uint16_t aShort) {
     char tStringBuffer[13]; //5 decimal + 3 " 0x" + 4 hex +1
-// hu -> unsigned short int instead of unsigned int with u
-#if defined(AVR)
-    sprintf_P(tStringBuffer, PSTR("%5u 0x%4.4X"), aShort, aShort);
-#else
-    sprintf(tStringBuffer, "%5hu 0x%4.4X", aShort, aShort);
-#endif
+    uint8_t tLength = formatDecimalAndHex(tStringBuffer, sizeof(tStringBuffer), aShort, false, 5, 4);
     if (USART_isBluetoothPaired()) {
-        sendUSARTArgsAndByteBuffer(FUNCTION_DEBUG_STRING, 0, strlen(tStringBuffer), tStringBuffer);
+        sendUSARTArgsAndByteBuffer(FUNCTION_DEBUG_STRING, 0, tLength, tStringBuffer);
     }
 }
 
 void BlueDisplay::debug(int16_t aShort) {
     char tStringBuffer[14]; //6 decimal + 3 " 0x" + 4 hex +1
-// hd -> short int instead of int with d
-#if defined(AVR)
-    sprintf_P(tStringBuffer, PSTR("%6d 0x%4.4X"), aShort, aShort);
-#else
-    sprintf(tStringBuffer, "%6hd 0x%4.4X", aShort, aShort);
-#endif
+    uint8_t tLength = formatDecimalAndHex(tStringBuffer, sizeof(tStringBuffer), aShort, true, 6, 4);
     if (USART_isBluetoothPaired()) {
-        sendUSARTArgsAndByteBuffer(FUNCTION_DEBUG_STRING, 0, strlen(tStringBuffer), tStringBuffer);
+        sendUSARTArgsAndByteBuffer(FUNCTION_DEBUG_STRING, 0, tLength, tStringBuffer);
     }
 }
 
 /*
- * Maximum size of aMessage string is 21 character.
+ * Maximum size of aMessage string is 22 character.
  */
 void BlueDisplay::debug(const char *aMessage, uint16_t aShort) {
-    char tStringBuffer[STRING_BUFFER_STACK_SIZE_FOR_DEBUG_WITH_MESSAGE];
-// hd -> short int instead of int with d
-#if defined(AVR)
-    snprintf_P(tStringBuffer, STRING_BUFFER_STACK_SIZE_FOR_DEBUG_WITH_MESSAGE, PSTR("%s%5u 0x%4.4X"), aMessage, aShort, aShort);
-#else
-    snprintf(tStringBuffer, STRING_BUFFER_STACK_SIZE_FOR_DEBUG_WITH_MESSAGE, "%s%5hu 0x%4.4X", aMessage, aShort, aShort);
-#endif
+    char tStringBuffer[13];
+    uint8_t tLength = formatDecimalAndHex(tStringBuffer, sizeof(tStringBuffer), aShort, false, 5, 4);
     if (USART_isBluetoothPaired()) {
-        sendUSARTArgsAndByteBuffer(FUNCTION_DEBUG_STRING, 0, strlen(tStringBuffer), tStringBuffer);
+        sendDebugMessageAndValue(aMessage, tStringBuffer, tLength);
     }
 }
 
 /*
- * Maximum size of aMessage string is 20 character.
+ * Maximum size of aMessage string is 21 character.
  */
 void BlueDisplay::debug(const char *aMessage, int16_t aShort) {
-    char tStringBuffer[STRING_BUFFER_STACK_SIZE_FOR_DEBUG_WITH_MESSAGE];
-// hd -> short int instead of int with d
-#if defined(AVR)
-    snprintf_P(tStringBuffer, STRING_BUFFER_STACK_SIZE_FOR_DEBUG_WITH_MESSAGE, PSTR("%s%6d 0x%4.4X"), aMessage, aShort, aShort);
-#else
-    snprintf(tStringBuffer, STRING_BUFFER_STACK_SIZE_FOR_DEBUG_WITH_MESSAGE, "%s%6hd 0x%4.4X", aMessage, aShort, aShort);
-#endif
+    char tStringBuffer[14];
+    uint8_t tLength = formatDecimalAndHex(tStringBuffer, sizeof(tStringBuffer), aShort, true, 6, 4);
     if (USART_isBluetoothPaired()) {
-        sendUSARTArgsAndByteBuffer(FUNCTION_DEBUG_STRING, 0, strlen(tStringBuffer), tStringBuffer);
+        sendDebugMessageAndValue(aMessage, tStringBuffer, tLength);
     }
 }
 
 void BlueDisplay::debug(uint32_t aLong) {
     char tStringBuffer[22]; //10 decimal + 3 " 0x" + 8 hex +1
-#if defined(AVR)
-    sprintf_P(tStringBuffer, PSTR("%10lu 0x%lX"), aLong, aLong);
-#elif defined(__XTENSA__)
-    sprintf(tStringBuffer, "%10lu 0x%lX", (long)aLong, (long)aLong);
-#else
-    sprintf(tStringBuffer, "%10lu 0x%lX", aLong, aLong);
-#endif
+    uint8_t tLength = formatDecimalAndHex(tStringBuffer, sizeof(tStringBuffer), aLong, false, 10, 1);
     if (USART_isBluetoothPaired()) {
-        sendUSARTArgsAndByteBuffer(FUNCTION_DEBUG_STRING, 0, strlen(tStringBuffer), tStringBuffer);
+        sendUSARTArgsAndByteBuffer(FUNCTION_DEBUG_STRING, 0, tLength, tStringBuffer);
     }
 }
 
 void BlueDisplay::debug(int32_t aLong) {
     char tStringBuffer[23]; //11 decimal + 3 " 0x" + 8 hex +1
-#if defined(AVR)
-    sprintf_P(tStringBuffer, PSTR("%11ld 0x%lX"), aLong, aLong);
-#elif defined(__XTENSA__)
-    sprintf(tStringBuffer, "%11ld 0x%lX", (long)aLong, (long)aLong);
-#else
-    sprintf(tStringBuffer, "%11ld 0x%lX", aLong, aLong);
-#endif
+    uint8_t tLength = formatDecimalAndHex(tStringBuffer, sizeof(tStringBuffer), aLong, true, 11, 1);
     if (USART_isBluetoothPaired()) {
-        sendUSARTArgsAndByteBuffer(FUNCTION_DEBUG_STRING, 0, strlen(tStringBuffer), tStringBuffer);
+        sendUSARTArgsAndByteBuffer(FUNCTION_DEBUG_STRING, 0, tLength, tStringBuffer);
     }
 }
 
@@ -759,16 +1085,10 @@ void BlueDisplay::debug(int32_t aLong) {
  * Maximum size of aMessage string is 13 to 20 character depending on content of aLong.
  */
 void BlueDisplay::debug(const char *aMessage, uint32_t aLong) {
-    char tStringBuffer[STRING_BUFFER_STACK_SIZE_FOR_DEBUG_WITH_MESSAGE];
-#if defined(AVR)
-    snprintf_P(tStringBuffer, STRING_BUFFER_STACK_SIZE_FOR_DEBUG_WITH_MESSAGE, PSTR("%s%10lu 0x%lX"), aMessage, aLong, aLong);
-#elif defined(__XTENSA__)
-    snprintf(tStringBuffer, STRING_BUFFER_STACK_SIZE_FOR_DEBUG_WITH_MESSAGE, "%s%10lu 0x%lX", aMessage, (long)aLong, (long)aLong);
-#else
-    snprintf(tStringBuffer, STRING_BUFFER_STACK_SIZE_FOR_DEBUG_WITH_MESSAGE, "%s%10lu 0x%lX", aMessage, aLong, aLong);
-#endif
+    char tStringBuffer[22];
+    uint8_t tLength = formatDecimalAndHex(tStringBuffer, sizeof(tStringBuffer), aLong, false, 10, 1);
     if (USART_isBluetoothPaired()) {
-        sendUSARTArgsAndByteBuffer(FUNCTION_DEBUG_STRING, 0, strlen(tStringBuffer), tStringBuffer);
+        sendDebugMessageAndValue(aMessage, tStringBuffer, tLength);
     }
 }
 
@@ -776,57 +1096,37 @@ void BlueDisplay::debug(const char *aMessage, uint32_t aLong) {
  * Maximum size of aMessage string is 12 to 19 character depending on content of aLong.
  */
 void BlueDisplay::debug(const char *aMessage, int32_t aLong) {
-    char tStringBuffer[STRING_BUFFER_STACK_SIZE_FOR_DEBUG_WITH_MESSAGE];
-#if defined(AVR)
-    snprintf_P(tStringBuffer, STRING_BUFFER_STACK_SIZE_FOR_DEBUG_WITH_MESSAGE, PSTR("%s%11ld 0x%lX"), aMessage, aLong, aLong);
-#elif defined(__XTENSA__)
-    snprintf(tStringBuffer, STRING_BUFFER_STACK_SIZE_FOR_DEBUG_WITH_MESSAGE, "%s%11ld 0x%lX", aMessage, (long)aLong, (long)aLong);
-#else
-    snprintf(tStringBuffer, STRING_BUFFER_STACK_SIZE_FOR_DEBUG_WITH_MESSAGE, "%s%11ld 0x%lX", aMessage, aLong, aLong);
-#endif
+    char tStringBuffer[23];
+    uint8_t tLength = formatDecimalAndHex(tStringBuffer, sizeof(tStringBuffer), aLong, true, 11, 1);
     if (USART_isBluetoothPaired()) {
-        sendUSARTArgsAndByteBuffer(FUNCTION_DEBUG_STRING, 0, strlen(tStringBuffer), tStringBuffer);
+        sendDebugMessageAndValue(aMessage, tStringBuffer, tLength);
     }
 }
 
 void BlueDisplay::debug(float aFloat) {
-    char tStringBuffer[22];
-#if defined(AVR)
-    dtostrf(aFloat, 16, 7, tStringBuffer);
-#else
-    sprintf(tStringBuffer, "%f", aFloat);
-#endif
+    char tStringBuffer[FORMAT_BUFFER_SIZE_FOR_FLOAT];
+    uint8_t tLength = formatFloat(tStringBuffer, sizeof(tStringBuffer), aFloat, 16, 7);
     if (USART_isBluetoothPaired()) {
-        sendUSARTArgsAndByteBuffer(FUNCTION_DEBUG_STRING, 0, strlen(tStringBuffer), tStringBuffer);
+        sendUSARTArgsAndByteBuffer(FUNCTION_DEBUG_STRING, 0, tLength, tStringBuffer);
     }
 }
 
 /*
- * Maximum size of aMessage string is up to 30 character depending on content of aFloat.
+ * Maximum size of aMessage string is 18 character.
  */
 void BlueDisplay::debug(const char *aMessage, float aFloat) {
-    char tStringBuffer[STRING_BUFFER_STACK_SIZE_FOR_DEBUG_WITH_MESSAGE];
-#if defined(AVR)
-    strncpy(tStringBuffer, aMessage, (STRING_BUFFER_STACK_SIZE_FOR_DEBUG_WITH_MESSAGE - 22));
-    dtostrf(aFloat, 16, 7, &tStringBuffer[strlen(tStringBuffer)]);
-//    snprintf(tStringBuffer, STRING_BUFFER_STACK_SIZE_FOR_DEBUG_WITH_MESSAGE, "%s%f", aMessage, (double)aFloat); // requires ca. 800 bytes more
-#else
-    snprintf(tStringBuffer, STRING_BUFFER_STACK_SIZE_FOR_DEBUG_WITH_MESSAGE, "%s%f", aMessage, aFloat);
-#endif
+    char tStringBuffer[FORMAT_BUFFER_SIZE_FOR_FLOAT];
+    uint8_t tLength = formatFloat(tStringBuffer, sizeof(tStringBuffer), aFloat, 16, 7);
     if (USART_isBluetoothPaired()) {
-        sendUSARTArgsAndByteBuffer(FUNCTION_DEBUG_STRING, 0, strlen(tStringBuffer), tStringBuffer);
+        sendDebugMessageAndValue(aMessage, tStringBuffer, tLength);
     }
 }
 
 void BlueDisplay::debug(double aDouble) {
-    char tStringBuffer[22];
-#if defined(AVR)
-    dtostrf(aDouble, 16, 7, tStringBuffer);
-#else
-    sprintf(tStringBuffer, "%f", aDouble);
-#endif
+    char tStringBuffer[FORMAT_BUFFER_SIZE_FOR_FLOAT];
+    uint8_t tLength = formatFloat(tStringBuffer, sizeof(tStringBuffer), aDouble, 16, 7);
     if (USART_isBluetoothPaired()) {
-        sendUSARTArgsAndByteBuffer(FUNCTION_DEBUG_STRING, 0, strlen(tStringBuffer), tStringBuffer);
+        sendUSARTArgsAndByteBuffer(FUNCTION_DEBUG_STRING, 0, tLength, tStringBuffer);
     }
 }
 
@@ -836,8 +1136,8 @@ void BlueDisplay::debug(double aDouble) {
 void BlueDisplay::drawChartByteBuffer(uint16_t aXOffset, uint16_t aYOffset, color16_t aColor, color16_t aClearBeforeColor,
         uint8_t *aByteBuffer, size_t aByteBufferLength) {
     if (USART_isBluetoothPaired()) {
-        sendUSARTArgsAndByteBuffer(FUNCTION_DRAW_CHART, 4, aXOffset, aYOffset, aColor, aClearBeforeColor, aByteBufferLength,
-                aByteBuffer);
+        sendUSARTArgsWithColorsAndByteBuffer(FUNCTION_DRAW_CHART, COLOR_PARAMETER(2) | COLOR_PARAMETER(3), 4, aXOffset, aYOffset,
+                aColor, aClearBeforeColor, aByteBufferLength, aByteBuffer);
     }
 }
 
@@ -853,10 +1153,406 @@ void BlueDisplay::drawChartByteBuffer(uint16_t aXOffset, uint16_t aYOffset, colo
         if (aDoDrawDirect) {
             tFunctionTag = FUNCTION_DRAW_CHART;
         }
-        sendUSARTArgsAndByteBuffer(tFunctionTag, 4, aXOffset, aYOffset, aColor, aClearBeforeColor, aByteBufferLength, aByteBuffer);
+        sendUSARTArgsWithColorsAndByteBuffer(tFunctionTag, COLOR_PARAMETER(2) | COLOR_PARAMETER(3), 4, aXOffset, aYOffset, aColor,
+                aClearBeforeColor, aByteBufferLength, aByteBuffer);
+    }
+}
+
+/**
+ * Draws a vertical line from top to bottom value for each column
+ * @param aMinMaxByteBuffer Pairs of top and bottom Y value relative to aYOffset
+ * @param aChartIndex is coded in the upper 4 bits of aYOffset, like for drawChartByteBuffer()
+ */
+void BlueDisplay::drawChartMinMaxByteBuffer(uint16_t aXOffset, uint16_t aYOffset, color16_t aColor, color16_t aClearBeforeColor,
+        uint8_t aChartIndex, uint8_t *aMinMaxByteBuffer, uint16_t aNumberOfColumns) {
+    if (USART_isBluetoothPaired()) {
+        aYOffset = aYOffset | ((aChartIndex & 0x0F) << 12);
+        sendUSARTArgsWithColorsAndByteBuffer(FUNCTION_DRAW_CHART_MIN_MAX, COLOR_PARAMETER(2) | COLOR_PARAMETER(3), 4, aXOffset,
+                aYOffset, aColor, aClearBeforeColor, aNumberOfColumns * 2, aMinMaxByteBuffer);
+    }
+}
+
+/**
+ * Fills all rectangles with one command
+ * @param aRectBuffer X, Y, width and height of each rectangle, relative to aXOffset and aYOffset
+ */
+void BlueDisplay::fillRectList(uint16_t aXOffset, uint16_t aYOffset, color16_t aColor, uint16_t *aRectBuffer,
+        uint8_t aNumberOfRects) {
+    if (isClipActive()) {
+        // host does not know the clip rectangle, fillRectRel() clips
+        for (uint8_t i = 0; i < aNumberOfRects; ++i) {
+            uint16_t *tRect = &aRectBuffer[4 * i];
+            fillRectRel(aXOffset + tRect[0], aYOffset + tRect[1], tRect[2], tRect[3], aColor);
+        }
+        return;
+    }
+#if defined(SUPPORT_LOCAL_DISPLAY)
+    for (uint8_t i = 0; i < aNumberOfRects; ++i) {
+        uint16_t *tRect = &aRectBuffer[4 * i];
+        LocalDisplay.fillRect(aXOffset + tRect[0], aYOffset + tRect[1], aXOffset + tRect[0] + tRect[2] - 1,
+                aYOffset + tRect[1] + tRect[3] - 1, aColor);
+    }
+#endif
+    if (USART_isBluetoothPaired()) {
+        // the host reads the length of the data field in byte
+        sendUSART5ArgsAndByteBuffer(FUNCTION_FILL_RECT_LIST, aXOffset, aYOffset, aNumberOfRects, 0, aColor,
+                (uint8_t*) aRectBuffer, aNumberOfRects * 4 * sizeof(uint16_t));
+    }
+}
+
+/**
+ * Draws a point for each pair of X and Y value
+ * @param aXYByteBuffer Pairs of X and Y value relative to aXOffset and aYOffset
+ * @param aChartIndex is coded in the upper 4 bits of aYOffset, like for drawChartByteBuffer()
+ * @param aClearBeforeColor if not 0, the host clears all points of aChartIndex drawn since the last clearing.
+ *        If 0, the host adds the points to the points of aChartIndex, so a set of points can be sent in several chunks.
+ */
+void BlueDisplay::drawChartXYByteBuffer(uint16_t aXOffset, uint16_t aYOffset, color16_t aColor, color16_t aClearBeforeColor,
+        uint8_t aChartIndex, uint8_t *aXYByteBuffer, uint16_t aNumberOfPoints) {
+    if (USART_isBluetoothPaired()) {
+        aYOffset = aYOffset | ((aChartIndex & 0x0F) << 12);
+        sendUSARTArgsWithColorsAndByteBuffer(FUNCTION_DRAW_CHART_XY, COLOR_PARAMETER(2) | COLOR_PARAMETER(3), 4, aXOffset,
+                aYOffset, aColor, aClearBeforeColor, aNumberOfPoints * 2, aXYByteBuffer);
+    }
+}
+
+/**
+ * Draws axes, tick indicators and grid lines of a chart with one command. Labels are not drawn.
+ * @param aXOrigin, aYOrigin 0 coordinates of the grid, they are part of the axes
+ * @param aFlags CHART_GRID_FLAG_GRID_LINES, CHART_GRID_FLAG_X_INDICATORS and CHART_GRID_FLAG_Y_INDICATORS
+ */
+void BlueDisplay::drawChartGrid(uint16_t aXOrigin, uint16_t aYOrigin, uint16_t aWidth, uint16_t aHeight, uint8_t aGridXSpacing,
+        uint8_t aGridYSpacing, uint8_t aAxesSize, uint8_t aFlags, color16_t aGridColor, color16_t aAxesColor) {
+    if (isClipActive()) {
+        // host does not know the clip rectangle
+        drawChartGridSingle(aXOrigin, aYOrigin, aWidth, aHeight, aGridXSpacing, aGridYSpacing, aAxesSize, aFlags, aGridColor,
+                aAxesColor, false);
+        return;
+    }
+#if defined(SUPPORT_LOCAL_DISPLAY)
+    drawChartGridSingle(aXOrigin, aYOrigin, aWidth, aHeight, aGridXSpacing, aGridYSpacing, aAxesSize, aFlags, aGridColor,
+            aAxesColor, true);
+#endif
+    if (USART_isBluetoothPaired()) {
+        // colors first, since color parameter mask has only 8 bits
+        sendUSARTArgsWithColors(FUNCTION_DRAW_CHART_GRID, COLOR_PARAMETER(4) | COLOR_PARAMETER(5), 10, aXOrigin, aYOrigin, aWidth,
+                aHeight, aGridColor, aAxesColor, aGridXSpacing, aGridYSpacing, aAxesSize, aFlags);
     }
 }
 
+/*
+ * Draws the chart grid with one drawing per line, on the local display only or with one command per line.
+ * The host does the same drawings for FUNCTION_DRAW_CHART_GRID.
+ */
+void BlueDisplay::drawChartGridSingle(uint16_t aXOrigin, uint16_t aYOrigin, uint16_t aWidth, uint16_t aHeight,
+        uint8_t aGridXSpacing, uint8_t aGridYSpacing, uint8_t aAxesSize, uint8_t aFlags, color16_t aGridColor,
+        color16_t aAxesColor, bool aLocalDisplayOnly) {
+#if !defined(SUPPORT_LOCAL_DISPLAY)
+    if (aLocalDisplayOnly) {
+        return;
+    }
+#endif
+    if (aGridXSpacing == 0 || aGridYSpacing == 0) {
+        return;
+    }
+    uint16_t tAxesStart = aXOrigin - (aAxesSize - 1);
+    uint16_t tOffset;
+    if (aLocalDisplayOnly) {
+#if defined(SUPPORT_LOCAL_DISPLAY)
+        // X and Y axis
+        LocalDisplay.fillRect(tAxesStart, aYOrigin, aXOrigin + aWidth - 1, aYOrigin + aAxesSize - 1, aAxesColor);
+        LocalDisplay.fillRect(tAxesStart, aYOrigin - (aHeight - 1), aXOrigin, aYOrigin - 1, aAxesColor);
+        if (aFlags & CHART_GRID_FLAG_X_INDICATORS) {
+            for (tOffset = 0; tOffset <= aWidth; tOffset += aGridXSpacing) {
+                LocalDisplay.fillRect(aXOrigin + tOffset, aYOrigin + aAxesSize, aXOrigin + tOffset,
+                        aYOrigin + (2 * aAxesSize) - 1, aGridColor);
+            }
+        }
+        if (aFlags & CHART_GRID_FLAG_Y_INDICATORS) {
+            for (tOffset = 0; tOffset <= aHeight; tOffset += aGridYSpacing) {
+                LocalDisplay.fillRect(aXOrigin - (2 * aAxesSize) + 1, aYOrigin - tOffset, aXOrigin - aAxesSize,
+                        aYOrigin - tOffset, aGridColor);
+            }
+        }
+        if (aFlags & CHART_GRID_FLAG_GRID_LINES) {
+            for (tOffset = aGridXSpacing; tOffset <= aWidth; tOffset += aGridXSpacing) {
+                LocalDisplay.drawLine(aXOrigin + tOffset, aYOrigin - (aHeight - 1), aXOrigin + tOffset, aYOrigin, aGridColor);
+            }
+            for (tOffset = aGridYSpacing; tOffset <= aHeight; tOffset += aGridYSpacing) {
+                LocalDisplay.drawLine(aXOrigin + 1, aYOrigin - tOffset, aXOrigin + aWidth, aYOrigin - tOffset, aGridColor);
+            }
+        }
+#endif
+        return;
+    }
+
+    fillRectRel(tAxesStart, aYOrigin, aWidth + (aAxesSize - 1), aAxesSize, aAxesColor);
+    fillRectRel(tAxesStart, aYOrigin - (aHeight - 1), aAxesSize, aHeight - 1, aAxesColor);
+    if (aFlags & CHART_GRID_FLAG_X_INDICATORS) {
+        for (tOffset = 0; tOffset <= aWidth; tOffset += aGridXSpacing) {
+            fillRectRel(aXOrigin + tOffset, aYOrigin + aAxesSize, 1, aAxesSize, aGridColor);
+        }
+    }
+    if (aFlags & CHART_GRID_FLAG_Y_INDICATORS) {
+        for (tOffset = 0; tOffset <= aHeight; tOffset += aGridYSpacing) {
+            fillRectRel(aXOrigin - (2 * aAxesSize) + 1, aYOrigin - tOffset, aAxesSize, 1, aGridColor);
+        }
+    }
+    if (aFlags & CHART_GRID_FLAG_GRID_LINES) {
+        for (tOffset = aGridXSpacing; tOffset <= aWidth; tOffset += aGridXSpacing) {
+            drawLineRel(aXOrigin + tOffset, aYOrigin - (aHeight - 1), 0, aHeight - 1, aGridColor);
+        }
+        for (tOffset = aGridYSpacing; tOffset <= aHeight; tOffset += aGridYSpacing) {
+            drawLineRel(aXOrigin + 1, aYOrigin - tOffset, aWidth - 1, 0, aGridColor);
+        }
+    }
+}
+
+/*
+ * Registry of all bitmaps cached by the host, index is the bitmap id
+ */
+static struct BDBitmap sBitmapRegistry[NUMBER_OF_CACHED_BITMAPS];
+
+static BDBitmapHandle_t registerBitmap(uint16_t aWidth, uint16_t aHeight, uint8_t aFormat, const uint8_t *aPixelData,
+        const color16_t *aPalette, uint16_t aNumberOfPaletteEntries) {
+    uint8_t tBytesPerPixel = 1;
+    if (aFormat == BITMAP_FORMAT_RGB565) {
+        tBytesPerPixel = 2;
+    }
+    // one line must fit into one upload chunk
+    if (aPixelData == NULL || aWidth == 0 || aWidth * tBytesPerPixel > BITMAP_UPLOAD_MAX_CHUNK_SIZE) {
+        return NO_BITMAP;
+    }
+    if (aFormat == BITMAP_FORMAT_INDEXED_8) {
+        if (aPalette == NULL || aNumberOfPaletteEntries == 0) {
+            return NO_BITMAP;
+        }
+        // palette must fit into the host data buffer, more entries can not be addressed by an 8 bit index anyway
+        if (aNumberOfPaletteEntries > BITMAP_MAX_NUMBER_OF_PALETTE_ENTRIES) {
+            aNumberOfPaletteEntries = BITMAP_MAX_NUMBER_OF_PALETTE_ENTRIES;
+        }
+    }
+    for (uint8_t i = 0; i < NUMBER_OF_CACHED_BITMAPS; ++i) {
+        struct BDBitmap *tBitmap = &sBitmapRegistry[i];
+        if (tBitmap->PixelData == NULL) {
+            tBitmap->PixelData = aPixelData;
+            tBitmap->Palette = aPalette;
+            tBitmap->Width = aWidth;
+            tBitmap->Height = aHeight;
+            tBitmap->NumberOfPaletteEntries = aNumberOfPaletteEntries;
+            tBitmap->Format = aFormat;
+            return i;
+        }
+    }
+    return NO_BITMAP;
+}
+
+/*
+ * Sends palette and then the pixel data in chunks of complete lines, which fit into the host data buffer
+ */
+static void sendBitmap(BDBitmapHandle_t aBitmapId) {
+    struct BDBitmap *tBitmap = &sBitmapRegistry[aBitmapId];
+    uint16_t tBytesPerLine = tBitmap->Width;
+    if (tBitmap->Format == BITMAP_FORMAT_RGB565) {
+        tBytesPerLine *= 2;
+    } else {
+        sendUSARTArgsAndByteBuffer(FUNCTION_BITMAP_SET_PALETTE, 2, aBitmapId, tBitmap->NumberOfPaletteEntries,
+                tBitmap->NumberOfPaletteEntries * sizeof(color16_t), tBitmap->Palette);
+    }
+    uint16_t tLinesPerChunk = BITMAP_UPLOAD_MAX_CHUNK_SIZE / tBytesPerLine;
+    const uint8_t *tPixelDataPointer = tBitmap->PixelData;
+    for (uint16_t tStartLine = 0; tStartLine < tBitmap->Height; tStartLine += tLinesPerChunk) {
+        uint16_t tNumberOfLines = tBitmap->Height - tStartLine;
+        if (tNumberOfLines > tLinesPerChunk) {
+            tNumberOfLines = tLinesPerChunk;
+        }
+        sendUSARTArgsAndByteBuffer(FUNCTION_BITMAP_UPLOAD, 5, aBitmapId, tBitmap->Width, tBitmap->Height, tBitmap->Format,
+                tStartLine, tNumberOfLines * tBytesPerLine, tPixelDataPointer);
+        tPixelDataPointer += tNumberOfLines * tBytesPerLine;
+    }
+}
+
+/**
+ * Registers the bitmap and uploads it to the host, where it is stored under the returned id.
+ * Pixels are only referenced, not copied! Returns NO_BITMAP if registry is full.
+ */
+BDBitmapHandle_t BlueDisplay::uploadBitmap(uint16_t aWidth, uint16_t aHeight, const color16_t *aPixels) {
+    BDBitmapHandle_t tBitmapId = registerBitmap(aWidth, aHeight, BITMAP_FORMAT_RGB565, (const uint8_t*) aPixels, NULL, 0);
+    if (tBitmapId != NO_BITMAP && USART_isBluetoothPaired()) {
+        sendBitmap(tBitmapId);
+    }
+    return tBitmapId;
+}
+
+/**
+ * One byte per pixel, which is an index into aPalette. Halves the upload size compared to uploadBitmap().
+ */
+BDBitmapHandle_t BlueDisplay::uploadBitmapIndexed(uint16_t aWidth, uint16_t aHeight, const uint8_t *aPaletteIndexes,
+        const color16_t *aPalette, uint16_t aNumberOfPaletteEntries) {
+    BDBitmapHandle_t tBitmapId = registerBitmap(aWidth, aHeight, BITMAP_FORMAT_INDEXED_8, aPaletteIndexes, aPalette,
+            aNumberOfPaletteEntries);
+    if (tBitmapId != NO_BITMAP && USART_isBluetoothPaired()) {
+        sendBitmap(tBitmapId);
+    }
+    return tBitmapId;
+}
+
+/**
+ * Costs only 3 parameters, the pixels are taken from the host cache
+ */
+void BlueDisplay::drawBitmap(BDBitmapHandle_t aBitmapId, uint16_t aPosX, uint16_t aPosY) {
+    if (aBitmapId >= NUMBER_OF_CACHED_BITMAPS || sBitmapRegistry[aBitmapId].PixelData == NULL) {
+        return;
+    }
+    struct BDBitmap *tBitmap = &sBitmapRegistry[aBitmapId];
+    if (!isRectVisible(aPosX, aPosY, (int32_t) aPosX + tBitmap->Width - 1, (int32_t) aPosY + tBitmap->Height - 1)) {
+        return;
+    }
+#if defined(SUPPORT_LOCAL_DISPLAY)
+    for (uint16_t y = 0; y < tBitmap->Height; ++y) {
+        for (uint16_t x = 0; x < tBitmap->Width; ++x) {
+            uint32_t tPixelIndex = (uint32_t) y * tBitmap->Width + x;
+            color16_t tColor;
+            if (tBitmap->Format == BITMAP_FORMAT_RGB565) {
+                tColor = ((const color16_t*) tBitmap->PixelData)[tPixelIndex];
+            } else {
+                tColor = tBitmap->Palette[tBitmap->PixelData[tPixelIndex]];
+            }
+            LocalDisplay.drawPixel(aPosX + x, aPosY + y, tColor);
+        }
+    }
+#endif
+    if (USART_isBluetoothPaired()) {
+        sendUSARTArgs(FUNCTION_BITMAP_DRAW, 3, aBitmapId, aPosX, aPosY);
+    }
+}
+
+/**
+ * Frees the registry entry and the host cache entry
+ */
+void BlueDisplay::removeBitmap(BDBitmapHandle_t aBitmapId) {
+    if (aBitmapId >= NUMBER_OF_CACHED_BITMAPS) {
+        return;
+    }
+    sBitmapRegistry[aBitmapId].PixelData = NULL;
+    if (USART_isBluetoothPaired()) {
+        sendUSARTArgs(FUNCTION_BITMAP_REMOVE, 1, aBitmapId);
+    }
+}
+
+/*
+ * String ids known by host, sorted by usage. First entry is the most recently used one.
+ */
+struct InternedString {
+    const char *String; // NULL if id is not yet used
+    uint8_t Id;
+};
+static struct InternedString sInternedStrings[NUMBER_OF_INTERNED_STRINGS];
+
+/**
+ * Sets all ids to unused. Must be called if host string table was cleared.
+ */
+void BlueDisplay::resetInternedStrings(void) {
+    for (uint8_t i = 0; i < NUMBER_OF_INTERNED_STRINGS; ++i) {
+        sInternedStrings[i].String = NULL;
+        sInternedStrings[i].Id = i;
+    }
+}
+
+/**
+ * Returns the id under which the host knows the string.
+ * If the string is not known, the id of the least recently used string is reused and the string is sent to the host.
+ * @return NO_STRING_ID if not connected
+ */
+uint8_t BlueDisplay::getStringId(const char *aString) {
+    if (!USART_isBluetoothPaired()) {
+        return NO_STRING_ID;
+    }
+    uint8_t tIndex = 0;
+    while (tIndex < NUMBER_OF_INTERNED_STRINGS - 1 && sInternedStrings[tIndex].String != aString) {
+        tIndex++;
+    }
+    struct InternedString tEntry = sInternedStrings[tIndex];
+    if (tEntry.String != aString) {
+        // not found, reuse last = least recently used entry
+        tEntry.String = aString;
+        sendUSARTArgsAndByteBuffer(FUNCTION_STRING_DEFINE, 1, tEntry.Id, strlen(aString), (uint8_t*) aString);
+    }
+    // move entry to front
+    while (tIndex > 0) {
+        sInternedStrings[tIndex] = sInternedStrings[tIndex - 1];
+        tIndex--;
+    }
+    sInternedStrings[0] = tEntry;
+    return tEntry.Id;
+}
+
+/**
+ * Called at EVENT_CONNECTION_BUILD_UP, since the host cache is cleared by reset all
+ */
+void BlueDisplay::reuploadAllBitmaps(void) {
+    if (USART_isBluetoothPaired()) {
+        for (uint8_t i = 0; i < NUMBER_OF_CACHED_BITMAPS; ++i) {
+            if (sBitmapRegistry[i].PixelData != NULL) {
+                sendBitmap(i);
+            }
+        }
+    }
+}
+
+/*****************************************************************************
+ * Color palette
+ *****************************************************************************/
+#if (MAX_NUMBER_OF_PALETTE_COLORS * 2) > HOST_DATA_BUFFER_SIZE || (BITMAP_MAX_NUMBER_OF_PALETTE_ENTRIES * 2) > HOST_DATA_BUFFER_SIZE
+#error Color palette does not fit into the host data buffer
+#endif
+/**
+ * Uploads the palette and enables palette mode. In palette mode all colors contained in the palette are sent
+ * as one byte index instead of 2 bytes RGB565 value. Colors not contained in the palette are sent as before.
+ * @param aPalette Must be valid as long as palette mode is enabled. Put the most used colors first.
+ * @param aNumberOfColors Max 256. 0 disables palette mode.
+ */
+void BlueDisplay::setColorPalette(const color16_t *aPalette, uint16_t aNumberOfColors) {
+    if (aNumberOfColors > MAX_NUMBER_OF_PALETTE_COLORS) {
+        aNumberOfColors = MAX_NUMBER_OF_PALETTE_COLORS;
+    }
+    if (aNumberOfColors == 0) {
+        aPalette = NULL;
+    }
+    mColorPalette = aPalette;
+    mNumberOfPaletteColors = aNumberOfColors;
+    // disable palette mode until host has received the new palette
+    setColorPaletteForSend(NULL, 0);
+    sendColorPalette();
+}
+
+/**
+ * Called at EVENT_CONNECTION_BUILD_UP, since a new host has no palette
+ */
+void BlueDisplay::sendColorPalette(void) {
+    if (mColorPalette != NULL && USART_isBluetoothPaired()) {
+        sendUSARTArgsAndByteBuffer(FUNCTION_COLOR_PALETTE_SET, 1, mNumberOfPaletteColors,
+                mNumberOfPaletteColors * sizeof(color16_t), (uint8_t*) mColorPalette);
+    }
+    setColorPaletteForSend(mColorPalette, mNumberOfPaletteColors);
+}
+
+/*****************************************************************************
+ * Connection journal
+ *****************************************************************************/
+/**
+ * Enables recording of the commands sent by the connect and redraw callbacks at connection build up,
+ * and of all later changes of buttons and sliders. At the next connection build up, the recorded commands
+ * are sent as one burst instead of calling the connect callback. The redraw callback is still called after the burst,
+ * to draw the content not contained in the journal, but its commands are not recorded.
+ * The journal is recorded again by calling the callbacks, if it overflows, if palette changes,
+ * or if the application calls clearDisplay() or gets a redraw or reorientation event.
+ * @param aJournalBuffer NULL disables the journal
+ */
+void BlueDisplay::setConnectionJournal(uint8_t *aJournalBuffer, uint16_t aJournalBufferSize) {
+    setJournalBuffer(aJournalBuffer, aJournalBufferSize);
+}
+
 struct XYSize* BlueDisplay::getMaxDisplaySize(void) {
     return &mMaxDisplaySize;
 }
@@ -907,32 +1603,21 @@ bool BlueDisplay::isDisplayOrientationLandscape(void) {
 void BlueDisplay::refreshVector(struct ThickLine *aLine, int16_t aNewRelEndX, int16_t aNewRelEndY) {
     int16_t tNewEndX = aLine->StartX + aNewRelEndX;
     int16_t tNewEndY = aLine->StartY + aNewRelEndY;
-    if (aLine->EndX != tNewEndX || aLine->EndX != tNewEndY) {
+    if (aLine->EndX != tNewEndX || aLine->EndY != tNewEndY) {
+        /*
+         * The unclipped end point is stored and both lines are clipped at the display border.
+         * Clamping the end point would change the direction of the vector.
+         */
+        bool tClipPushed = pushClip(0, 0, mRequestedDisplaySize.XWidth - 1, mRequestedDisplaySize.YHeight - 1);
         //clear old line
         drawLineWithThickness(aLine->StartX, aLine->StartY, aLine->EndX, aLine->EndY, aLine->Thickness, aLine->BackgroundColor);
         // Draw new line
-        /**
-         * clipping
-         * Ignore warning since we know that values are positive when compared :-)
-         */
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wsign-compare"
-        if (tNewEndX < 0) {
-            tNewEndX = 0;
-        } else if (tNewEndX > mRequestedDisplaySize.XWidth - 1) {
-            tNewEndX = mRequestedDisplaySize.XWidth - 1;
-        }
         aLine->EndX = tNewEndX;
-
-        if (tNewEndY < 0) {
-            tNewEndY = 0;
-        } else if (tNewEndY > mRequestedDisplaySize.YHeight - 1) {
-            tNewEndY = mRequestedDisplaySize.YHeight - 1;
-        }
-#pragma GCC diagnostic pop
         aLine->EndY = tNewEndY;
-
         drawLineWithThickness(aLine->StartX, aLine->StartY, tNewEndX, tNewEndY, aLine->Thickness, aLine->Color);
+        if (tClipPushed) {
+            popClip();
+        }
     }
 }
 
@@ -956,8 +1641,8 @@ void BlueDisplay::drawMLText(uint16_t aPosX, uint16_t aPosY, const char *aString
     LocalDisplay.drawMLText(aPosX, aPosY - getTextAscend(aTextSize), (char *) aStringPtr, getLocalTextSize(aTextSize), aFGColor,
             aBGColor);
     if (USART_isBluetoothPaired()) {
-        sendUSARTArgsAndByteBuffer(FUNCTION_DRAW_STRING, 5, aPosX, aPosY, aTextSize, aFGColor, aBGColor, strlen(aStringPtr),
-                (uint8_t*) aStringPtr);
+        sendUSARTArgsWithColorsAndByteBuffer(FUNCTION_DRAW_STRING, COLOR_PARAMETER(3) | COLOR_PARAMETER(4), 5, aPosX, aPosY,
+                aTextSize, aFGColor, aBGColor, strlen(aStringPtr), (uint8_t*) aStringPtr);
     }
 }
 #endif
@@ -977,8 +1662,8 @@ uint16_t BlueDisplay::drawTextPGM(uint16_t aPosX, uint16_t aPosY, const char *aP
 #endif
     if (USART_isBluetoothPaired()) {
         tRetValue = aPosX + tTextLength * getTextWidth(aTextSize);
-        sendUSARTArgsAndByteBuffer(FUNCTION_DRAW_STRING, 5, aPosX, aPosY, aTextSize, aFGColor, aBGColor, tTextLength,
-                (uint8_t*) tStringBuffer);
+        sendUSARTArgsWithColorsAndByteBuffer(FUNCTION_DRAW_STRING, COLOR_PARAMETER(3) | COLOR_PARAMETER(4), 5, aPosX, aPosY,
+                aTextSize, aFGColor, aBGColor, tTextLength, (uint8_t*) tStringBuffer);
     }
     return tRetValue;
 }
@@ -1012,8 +1697,8 @@ uint16_t BlueDisplay::drawText(uint16_t aPosX, uint16_t aPosY, const __FlashStri
 #endif
     if (USART_isBluetoothPaired()) {
         tRetValue = aPosX + tTextLength * getTextWidth(aTextSize);
-        sendUSARTArgsAndByteBuffer(FUNCTION_DRAW_STRING, 5, aPosX, aPosY, aTextSize, aFGColor, aBGColor, tTextLength,
-                (uint8_t*) tStringBuffer);
+        sendUSARTArgsWithColorsAndByteBuffer(FUNCTION_DRAW_STRING, COLOR_PARAMETER(3) | COLOR_PARAMETER(4), 5, aPosX, aPosY,
+                aTextSize, aFGColor, aBGColor, tTextLength, (uint8_t*) tStringBuffer);
     }
     return tRetValue;
 }
@@ -1236,12 +1921,12 @@ BDButtonHandle_t BlueDisplay::createButton(uint16_t aPositionX, uint16_t aPositi
 
     if (USART_isBluetoothPaired()) {
 #if __SIZEOF_POINTER__ == 4
-        sendUSARTArgsAndByteBuffer(FUNCTION_BUTTON_CREATE, 10, tButtonNumber, aPositionX, aPositionY, aWidthX, aHeightY,
-                aButtonColor, aCaptionSize | (aFlags << 8), aValue, aOnTouchHandler,
+        sendUSARTArgsWithColorsAndByteBuffer(FUNCTION_BUTTON_CREATE, COLOR_PARAMETER(5), 10, tButtonNumber, aPositionX, aPositionY,
+                aWidthX, aHeightY, aButtonColor, aCaptionSize | (aFlags << 8), aValue, aOnTouchHandler,
                 (reinterpret_cast<uint32_t>(aOnTouchHandler) >> 16), strlen(aCaption), aCaption);
 #else
-        sendUSARTArgsAndByteBuffer(FUNCTION_BUTTON_CREATE, 9, tButtonNumber, aPositionX, aPositionY, aWidthX, aHeightY,
-                aButtonColor, aCaptionSize | (aFlags << 8), aValue, aOnTouchHandler, strlen(aCaption), aCaption);
+        sendUSARTArgsWithColorsAndByteBuffer(FUNCTION_BUTTON_CREATE, COLOR_PARAMETER(5), 9, tButtonNumber, aPositionX, aPositionY,
+                aWidthX, aHeightY, aButtonColor, aCaptionSize | (aFlags << 8), aValue, aOnTouchHandler, strlen(aCaption), aCaption);
 #endif
     }
     return tButtonNumber;
@@ -1255,7 +1940,7 @@ void BlueDisplay::drawButton(BDButtonHandle_t aButtonNumber) {
 
 void BlueDisplay::removeButton(BDButtonHandle_t aButtonNumber, color16_t aBackgroundColor) {
     if (USART_isBluetoothPaired()) {
-        sendUSARTArgs(FUNCTION_BUTTON_REMOVE, 2, aButtonNumber, aBackgroundColor);
+        sendUSARTArgsWithColors(FUNCTION_BUTTON_REMOVE, COLOR_PARAMETER(1), 2, aButtonNumber, aBackgroundColor);
     }
 }
 
@@ -1289,13 +1974,15 @@ void BlueDisplay::setButtonValueAndDraw(BDButtonHandle_t aButtonNumber, int16_t
 
 void BlueDisplay::setButtonColor(BDButtonHandle_t aButtonNumber, color16_t aButtonColor) {
     if (USART_isBluetoothPaired()) {
-        sendUSARTArgs(FUNCTION_BUTTON_SETTINGS, 3, aButtonNumber, SUBFUNCTION_BUTTON_SET_BUTTON_COLOR, aButtonColor);
+        sendUSARTArgsWithColors(FUNCTION_BUTTON_SETTINGS, COLOR_PARAMETER(2), 3, aButtonNumber, SUBFUNCTION_BUTTON_SET_BUTTON_COLOR,
+                aButtonColor);
     }
 }
 
 void BlueDisplay::setButtonColorAndDraw(BDButtonHandle_t aButtonNumber, color16_t aButtonColor) {
     if (USART_isBluetoothPaired()) {
-        sendUSARTArgs(FUNCTION_BUTTON_SETTINGS, 3, aButtonNumber, SUBFUNCTION_BUTTON_SET_BUTTON_COLOR_AND_DRAW, aButtonColor);
+        sendUSARTArgsWithColors(FUNCTION_BUTTON_SETTINGS, COLOR_PARAMETER(2), 3, aButtonNumber,
+                SUBFUNCTION_BUTTON_SET_BUTTON_COLOR_AND_DRAW, aButtonColor);
     }
 }
 
@@ -1364,8 +2051,9 @@ BDButtonHandle_t BlueDisplay::createButtonPGM(uint16_t aPositionX, uint16_t aPos
         }
         char StringBuffer[STRING_BUFFER_STACK_SIZE];
         strncpy_P(StringBuffer, aPGMCaption, tCaptionLength);
-        sendUSARTArgsAndByteBuffer(FUNCTION_BUTTON_CREATE, 9, tButtonNumber, aPositionX, aPositionY, aWidthX, aHeightY,
-                aButtonColor, aCaptionSize | (aFlags << 8), aValue, aOnTouchHandler, tCaptionLength, StringBuffer);
+        sendUSARTArgsWithColorsAndByteBuffer(FUNCTION_BUTTON_CREATE, COLOR_PARAMETER(5), 9, tButtonNumber, aPositionX, aPositionY,
+                aWidthX, aHeightY, aButtonColor, aCaptionSize | (aFlags << 8), aValue, aOnTouchHandler, tCaptionLength,
+                StringBuffer);
     }
     return tButtonNumber;
 }
@@ -1415,12 +2103,12 @@ BDSliderHandle_t BlueDisplay::createSlider(uint16_t aPositionX, uint16_t aPositi
 
     if (USART_isBluetoothPaired()) {
 #if __SIZEOF_POINTER__ == 4
-        sendUSARTArgs(FUNCTION_SLIDER_CREATE, 12, tSliderNumber, aPositionX, aPositionY, aBarWidth, aBarLength, aThresholdValue,
-                aInitalValue, aSliderColor, aBarColor, aFlags, aOnChangeHandler,
+        sendUSARTArgsWithColors(FUNCTION_SLIDER_CREATE, COLOR_PARAMETER(7), 12, tSliderNumber, aPositionX, aPositionY, aBarWidth,
+                aBarLength, aThresholdValue, aInitalValue, aSliderColor, aBarColor, aFlags, aOnChangeHandler,
                 (reinterpret_cast<uint32_t>(aOnChangeHandler) >> 16));
 #else
-        sendUSARTArgs(FUNCTION_SLIDER_CREATE, 11, tSliderNumber, aPositionX, aPositionY, aBarWidth, aBarLength, aThresholdValue,
-                aInitalValue, aSliderColor, aBarColor, aFlags, aOnChangeHandler);
+        sendUSARTArgsWithColors(FUNCTION_SLIDER_CREATE, COLOR_PARAMETER(7), 11, tSliderNumber, aPositionX, aPositionY, aBarWidth,
+                aBarLength, aThresholdValue, aInitalValue, aSliderColor, aBarColor, aFlags, aOnChangeHandler);
 #endif
     }
     return tSliderNumber;
@@ -1446,13 +2134,15 @@ void BlueDisplay::setSliderValueAndDrawBar(BDSliderHandle_t aSliderNumber, int16
 
 void BlueDisplay::setSliderColorBarThreshold(BDSliderHandle_t aSliderNumber, uint16_t aBarThresholdColor) {
     if (USART_isBluetoothPaired()) {
-        sendUSARTArgs(FUNCTION_SLIDER_SETTINGS, 3, aSliderNumber, SUBFUNCTION_SLIDER_SET_COLOR_THRESHOLD, aBarThresholdColor);
+        sendUSARTArgsWithColors(FUNCTION_SLIDER_SETTINGS, COLOR_PARAMETER(2), 3, aSliderNumber,
+                SUBFUNCTION_SLIDER_SET_COLOR_THRESHOLD, aBarThresholdColor);
     }
 }
 
 void BlueDisplay::setSliderColorBarBackground(BDSliderHandle_t aSliderNumber, uint16_t aBarBackgroundColor) {
     if (USART_isBluetoothPaired()) {
-        sendUSARTArgs(FUNCTION_SLIDER_SETTINGS, 3, aSliderNumber, SUBFUNCTION_SLIDER_SET_COLOR_BAR_BACKGROUND, aBarBackgroundColor);
+        sendUSARTArgsWithColors(FUNCTION_SLIDER_SETTINGS, COLOR_PARAMETER(2), 3, aSliderNumber,
+                SUBFUNCTION_SLIDER_SET_COLOR_BAR_BACKGROUND, aBarBackgroundColor);
     }
 }
 
@@ -1531,17 +2221,18 @@ void BlueDisplay::printVCCAndTemperaturePeriodically(uint16_t aXPos, uint16_t aY
     if ((tMillis - sMillisOfLastVCCInfo) >= aPeriodMillis) {
         sMillisOfLastVCCInfo = tMillis;
 
-        char tDataBuffer[18];
-        char tVCCString[6];
-        char tTempString[6];
-
-        float tTemp = getTemperature();
-        dtostrf(tTemp, 4, 1, tTempString);
-
-        float tVCCvoltage = getVCCVoltage();
-        dtostrf(tVCCvoltage, 4, 2, tVCCString);
-
-        sprintf_P(tDataBuffer, PSTR("%s volt %s\xB0" "C"), tVCCString, tTempString); // \xB0 is degree character
+        char tDataBuffer[18]; // "5.00 volt 25.0\xB0C"
+        uint8_t tLength = formatFloat(tDataBuffer, sizeof(tDataBuffer), getVCCVoltage(), 4, 2);
+        if (tLength < sizeof(tDataBuffer) - 6) {
+            memcpy(&tDataBuffer[tLength], " volt ", 6);
+            tLength += 6;
+            tLength += formatFloat(&tDataBuffer[tLength], sizeof(tDataBuffer) - tLength, getTemperature(), 4, 1);
+            if (tLength < sizeof(tDataBuffer) - 2) {
+                tDataBuffer[tLength++] = '\xB0'; // degree character
+                tDataBuffer[tLength++] = 'C';
+                tDataBuffer[tLength] = '\0';
+            }
+        }
         drawText(aXPos, aYPos, tDataBuffer, aTextSize, COLOR16_BLACK, COLOR16_WHITE);
     }
 }
@@ -1569,118 +2260,37 @@ void BlueDisplay::printVCCAndTemperaturePeriodically(uint16_t aXPos, uint16_t aY
  *
  **************************************************************************************************************************************************/
 /*
- * TextSize * 1,125 (* (1 + 1/8))
- */
-uint16_t getTextHeight(uint16_t aTextSize) {
-    if (aTextSize == 11) {
-        return TEXT_SIZE_11_HEIGHT;
-    }
-    if (aTextSize == 22) {
-        return TEXT_SIZE_22_HEIGHT;
-    }
-    return aTextSize + aTextSize / 8; // TextSize * 1,125
-}
-
-/*
- * Formula for Monospace Font on Android
- * TextSize * 0.6
- * Integer Formula (rounded): (TextSize *6)+4 / 10
- */
-uint16_t getTextWidth(uint16_t aTextSize) {
-    if (aTextSize == 11) {
-        return TEXT_SIZE_11_WIDTH;
-    }
-#if defined(PGMSPACE_MATTERS)
-    return TEXT_SIZE_22_WIDTH;
-#else
-    if (aTextSize == 22) {
-        return TEXT_SIZE_22_WIDTH;
-    }
-    return ((aTextSize * 6) + 4) / 10;
-#endif
-}
-
-/*
- * Formula for Monospace Font on Android
- * float: TextSize * 0.76
- * int: (TextSize * 195 + 128) >> 8
+ * Metrics of single characters are constexpr functions in BlueDisplay.h.
+ * Width is computed for the longest line, height like the host does for multiline text:
+ * '\n' and '\r' end a line, empty lines are skipped, so "\r\n" is one line break,
+ * and each further line adds TextSize + 1.
  */
-uint16_t getTextAscend(uint16_t aTextSize) {
-    if (aTextSize == TEXT_SIZE_11) {
-        return TEXT_SIZE_11_ASCEND;
-    }
-#if defined(PGMSPACE_MATTERS)
-    return TEXT_SIZE_22_ASCEND;
-#else
-    if (aTextSize == TEXT_SIZE_22) {
-        return TEXT_SIZE_22_ASCEND;
-    }
-    uint32_t tRetvalue = aTextSize;
-    tRetvalue = ((tRetvalue * 195) + 128) >> 8;
-    return tRetvalue;
-#endif
-}
-
-/*
- * Formula for Monospace Font on Android
- * float: TextSize * 0.24
- * int: (TextSize * 61 + 128) >> 8
- */
-uint16_t getTextDecend(uint16_t aTextSize) {
-    if (aTextSize == TEXT_SIZE_11) {
-        return TEXT_SIZE_11_ASCEND;
-    }
-#if defined(PGMSPACE_MATTERS)
-    return TEXT_SIZE_22_ASCEND;
-#else
-
-    if (aTextSize == TEXT_SIZE_22) {
-        return TEXT_SIZE_22_ASCEND;
-    }
-    uint32_t tRetvalue = aTextSize;
-    tRetvalue = ((tRetvalue * 61) + 128) >> 8;
-    return tRetvalue;
-#endif
-}
-/*
- * Ascend - Decent
- * is used to position text in the middle of a button
- * Formula for positioning:
- * Position = ButtonTop + (ButtonHeight + getTextAscendMinusDescend())/2
- */
-uint16_t getTextAscendMinusDescend(uint16_t aTextSize) {
-    if (aTextSize == TEXT_SIZE_11) {
-        return TEXT_SIZE_11_ASCEND - TEXT_SIZE_11_DECEND;
-    }
-#if defined(PGMSPACE_MATTERS)
-    return TEXT_SIZE_22_ASCEND - TEXT_SIZE_22_DECEND;
-#else
-    if (aTextSize == TEXT_SIZE_22) {
-        return TEXT_SIZE_22_ASCEND - TEXT_SIZE_22_DECEND;
-    }
-    uint32_t tRetvalue = aTextSize;
-    tRetvalue = ((tRetvalue * 133) + 128) >> 8;
-    return tRetvalue;
-#endif
-}
-
-/*
- * (Ascend -Decent)/2
- */
-uint16_t getTextMiddle(uint16_t aTextSize) {
-    if (aTextSize == TEXT_SIZE_11) {
-        return (TEXT_SIZE_11_ASCEND - TEXT_SIZE_11_DECEND) / 2;
-    }
-#if defined(PGMSPACE_MATTERS)
-    return (TEXT_SIZE_22_ASCEND - TEXT_SIZE_22_DECEND) / 2;
-#else
-    if (aTextSize == TEXT_SIZE_22) {
-        return (TEXT_SIZE_22_ASCEND - TEXT_SIZE_22_DECEND) / 2;
+struct XYSize measureText(const char *aStringPtr, uint16_t aTextSize) {
+    struct XYSize tSize;
+    uint16_t tMaxLineLength = 0;
+    uint16_t tLineLength = 0;
+    uint16_t tNumberOfLines = 0;
+    char tChar;
+    do {
+        tChar = *aStringPtr++;
+        if (tChar == '\n' || tChar == '\r' || tChar == '\0') {
+            if (tLineLength > 0) {
+                tNumberOfLines++;
+                if (tLineLength > tMaxLineLength) {
+                    tMaxLineLength = tLineLength;
+                }
+            }
+            tLineLength = 0;
+        } else {
+            tLineLength++;
+        }
+    } while (tChar != '\0');
+    tSize.XWidth = tMaxLineLength * getTextWidth(aTextSize);
+    tSize.YHeight = getTextHeight(aTextSize);
+    if (tNumberOfLines > 1) {
+        tSize.YHeight += (tNumberOfLines - 1) * (aTextSize + 1);
     }
-    uint32_t tRetvalue = aTextSize;
-    tRetvalue = ((tRetvalue * 66) + 128) >> 8;
-    return tRetvalue;
-#endif
+    return tSize;
 }
 
 /*****************************************************************************
@@ -342,12 +342,227 @@ int getSendBufferFreeSpace(void) {
     return (sUSARTSendBufferPointerOut - sUSARTSendBufferPointerIn);
 }
 
+/*
+ * Connection journal
+ */
+static uint8_t *sJournalBuffer = NULL;
+static uint16_t sJournalSize;
+static uint16_t sJournalLength;
+static uint8_t sJournalState = JOURNAL_STATE_DISABLED;
+static bool sJournalIsSuspended = false; // for replay and for the chunks of sendUSARTBuffer()
+
+/**
+ * @param aBuffer NULL disables the journal. Size of 512 is sufficient for a few buttons and sliders.
+ */
+void setJournalBuffer(uint8_t *aBuffer, uint16_t aSize) {
+    sJournalBuffer = aBuffer;
+    sJournalSize = aSize;
+    sJournalLength = 0;
+    if (aBuffer == NULL) {
+        sJournalState = JOURNAL_STATE_DISABLED;
+    } else {
+        // recorded at next connection build up
+        sJournalState = JOURNAL_STATE_INVALID;
+    }
+}
+
+/**
+ * Clears the journal and records all following commands
+ */
+void startJournalRecording(void) {
+    if (sJournalState != JOURNAL_STATE_DISABLED) {
+        sJournalLength = 0;
+        sJournalState = JOURNAL_STATE_RECORD_ALL;
+    }
+}
+
+/**
+ * After the GUI is built up, only the changes of the GUI elements are recorded
+ */
+void endJournalRecording(void) {
+    if (sJournalState == JOURNAL_STATE_RECORD_ALL) {
+        sJournalState = JOURNAL_STATE_RECORD_GUI_STATE;
+    }
+}
+
+void invalidateJournal(void) {
+    if (sJournalState != JOURNAL_STATE_DISABLED) {
+        sJournalState = JOURNAL_STATE_INVALID;
+    }
+}
+
+bool isJournalValid(void) {
+    return sJournalState == JOURNAL_STATE_RECORD_GUI_STATE;
+}
+
+uint16_t getJournalLength(void) {
+    return sJournalLength;
+}
+
+/*
+ * Commands which change the state of buttons, sliders, strings, vectors and sensors on the host
+ */
+static bool isJournalGUIStateCommand(uint8_t aFunctionTag) {
+    return (aFunctionTag >= FUNCTION_BUTTON_DRAW && aFunctionTag <= FUNCTION_SLIDER_GLOBAL_SETTINGS)
+            || (aFunctionTag >= FUNCTION_BUTTON_CREATE && aFunctionTag <= FUNCTION_SLIDER_SET_VALUE_FORMAT_STRING)
+            || aFunctionTag == FUNCTION_STRING_DEFINE || aFunctionTag == FUNCTION_VECTOR_DEFINE
+            || aFunctionTag == FUNCTION_SENSOR_SETTINGS;
+}
+
+/*
+ * Commands, which are only sent once per connection by the library or must not be replayed
+ */
+static bool isJournalExcludedCommand(uint8_t aFunctionTag) {
+    return aFunctionTag == FUNCTION_NOP || aFunctionTag == FUNCTION_COLOR_PALETTE_SET || aFunctionTag == FUNCTION_BITMAP_UPLOAD
+            || aFunctionTag == FUNCTION_BITMAP_SET_PALETTE || aFunctionTag == FUNCTION_REQUEST_MAX_CANVAS_SIZE
+            || (aFunctionTag >= FUNCTION_GET_NUMBER && aFunctionTag <= FUNCTION_PLAY_TONE)
+            || aFunctionTag == FUNCTION_DEBUG_STRING || aFunctionTag == FUNCTION_GET_NUMBER_WITH_SHORT_PROMPT
+            || aFunctionTag == FUNCTION_GET_TEXT_WITH_SHORT_PROMPT;
+}
+
+/*
+ * A newer command with the same tag and the same object index (and sub function for settings commands) replaces the older one.
+ * Creation commands are never replaced, since their order is relevant.
+ */
+static bool isJournalReplaceableCommand(uint8_t aFunctionTag) {
+    return aFunctionTag != FUNCTION_BUTTON_CREATE && aFunctionTag != FUNCTION_SLIDER_CREATE
+            && aFunctionTag != FUNCTION_VECTOR_DEFINE;
+}
+
+/*
+ * Returns parameter aParameterIndex of a frame. Parameters marked in the palette parameter mask at aFrame[3] are one byte long.
+ * A one byte palette index is returned with bit 16 set, to distinguish it from a 16 bit value.
+ * @return -1 if the frame has not enough parameters
+ */
+static int32_t getJournalFrameParameter(uint8_t *aFrame, uint8_t aParameterIndex) {
+    uint8_t tParameterLength = aFrame[2];
+    uint8_t tPaletteParameterMask = aFrame[3];
+    uint8_t *tParameter = &aFrame[4];
+    for (uint8_t i = 0; i <= aParameterIndex; ++i) {
+        uint8_t tSize = (i < 8 && (tPaletteParameterMask & (1 << i))) ? 1 : 2;
+        if (tParameter + tSize > &aFrame[4 + tParameterLength]) {
+            return -1;
+        }
+        if (i == aParameterIndex) {
+            if (tSize == 1) {
+                return 0x10000 | tParameter[0];
+            }
+            return tParameter[0] | tParameter[1] << 8;
+        }
+        tParameter += tSize;
+    }
+    return -1;
+}
+
+/*
+ * Key is the object index, which is the first parameter. For settings commands the sub function is part of the key.
+ */
+static bool isJournalEntryReplaced(uint8_t *aFrame, uint8_t *aNewFrame) {
+    uint8_t tFunctionTag = aNewFrame[1];
+    if (aFrame[1] != tFunctionTag || getJournalFrameParameter(aFrame, 0) != getJournalFrameParameter(aNewFrame, 0)) {
+        return false;
+    }
+    if (tFunctionTag == FUNCTION_BUTTON_SETTINGS || tFunctionTag == FUNCTION_SLIDER_SETTINGS) {
+        return getJournalFrameParameter(aFrame, 1) == getJournalFrameParameter(aNewFrame, 1);
+    }
+    return true;
+}
+
+/*
+ * Removes the entry replaced by the command in aParameterBufferPointer
+ * @return index of the removed entry or sJournalLength if no entry was removed
+ */
+static uint16_t removeReplacedJournalEntry(uint8_t *aParameterBufferPointer) {
+    uint16_t tIndex = 0;
+    while (tIndex < sJournalLength) {
+        uint8_t *tEntry = &sJournalBuffer[tIndex];
+        uint16_t tEntryLength = tEntry[0] | tEntry[1] << 8;
+        if (isJournalEntryReplaced(&tEntry[JOURNAL_ENTRY_HEADER_SIZE], aParameterBufferPointer)) {
+            uint16_t tNextIndex = tIndex + JOURNAL_ENTRY_HEADER_SIZE + tEntryLength;
+            memmove(tEntry, &sJournalBuffer[tNextIndex], sJournalLength - tNextIndex);
+            sJournalLength -= tNextIndex - tIndex;
+            return tIndex;
+        }
+        tIndex += JOURNAL_ENTRY_HEADER_SIZE + tEntryLength;
+    }
+    return sJournalLength;
+}
+
+/*
+ * Appends the command to the journal, if journal is recording.
+ * Journal is invalidated on overflow or if display is cleared after the GUI was built up.
+ */
+static void recordJournalEntry(uint8_t * aParameterBufferPointer, size_t aParameterBufferLength, uint8_t * aDataBufferPointer,
+        size_t aDataBufferLength) {
+    if (sJournalState < JOURNAL_STATE_RECORD_ALL || sJournalIsSuspended) {
+        return;
+    }
+    uint8_t tFunctionTag = aParameterBufferPointer[1];
+    if (isJournalExcludedCommand(tFunctionTag)) {
+        return;
+    }
+    uint16_t tInsertIndex = sJournalLength;
+    if (sJournalState == JOURNAL_STATE_RECORD_GUI_STATE) {
+        if (tFunctionTag == FUNCTION_CLEAR_DISPLAY) {
+            // screen content is changed by application, so recorded content is obsolete
+            sJournalState = JOURNAL_STATE_INVALID;
+            return;
+        }
+        if (!isJournalGUIStateCommand(tFunctionTag)) {
+            return;
+        }
+        if (isJournalReplaceableCommand(tFunctionTag)) {
+            tInsertIndex = removeReplacedJournalEntry(aParameterBufferPointer);
+            if (tFunctionTag != FUNCTION_STRING_DEFINE) {
+                // a string must stay defined before the commands using its id, all other commands are appended
+                tInsertIndex = sJournalLength;
+            }
+        }
+    }
+    uint16_t tEntryLength = aParameterBufferLength + aDataBufferLength;
+    if (sJournalLength + JOURNAL_ENTRY_HEADER_SIZE + tEntryLength > sJournalSize) {
+        sJournalState = JOURNAL_STATE_INVALID;
+        return;
+    }
+    uint8_t *tEntry = &sJournalBuffer[tInsertIndex];
+    memmove(tEntry + JOURNAL_ENTRY_HEADER_SIZE + tEntryLength, tEntry, sJournalLength - tInsertIndex);
+    *tEntry++ = tEntryLength;
+    *tEntry++ = tEntryLength >> 8;
+    memcpy(tEntry, aParameterBufferPointer, aParameterBufferLength);
+    if (aDataBufferLength > 0) {
+        memcpy(tEntry + aParameterBufferLength, aDataBufferPointer, aDataBufferLength);
+    }
+    sJournalLength += JOURNAL_ENTRY_HEADER_SIZE + tEntryLength;
+}
+
+/**
+ * Sends all recorded commands as one burst. The journal itself is not changed.
+ * Recording stays suspended until resumeJournalRecording(), so the redraw after replay does not change the journal.
+ */
+void replayJournal(void) {
+    if (!isJournalValid()) {
+        return;
+    }
+    sJournalIsSuspended = true;
+    uint16_t tIndex = 0;
+    while (tIndex < sJournalLength) {
+        uint16_t tEntryLength = sJournalBuffer[tIndex] | sJournalBuffer[tIndex + 1] << 8;
+        sendUSARTBuffer(&sJournalBuffer[tIndex + JOURNAL_ENTRY_HEADER_SIZE], tEntryLength, NULL, 0);
+        tIndex += JOURNAL_ENTRY_HEADER_SIZE + tEntryLength;
+    }
+}
+
+void resumeJournalRecording(void) {
+    sJournalIsSuspended = false;
+}
+
 /**
  * Copy content of both buffers to send buffer, check for buffer wrap around and call USART_BD_DMA_TX_start() with right parameters.
  * Do blocking wait if not enough space left in buffer
  */
 void sendUSARTBufferNoSizeCheck(uint8_t * aParameterBufferPointer, size_t aParameterBufferLength,
         uint8_t * aDataBufferPointer, size_t aDataBufferLength) {
+    recordJournalEntry(aParameterBufferPointer, aParameterBufferLength, aDataBufferPointer, aDataBufferLength);
 #ifdef USE_SIMPLE_SERIAL
     sendUSARTBufferSimple(aParameterBufferPointer, aParameterBufferLength, aDataBufferPointer, aDataBufferLength);
     return;
@@ -441,10 +656,15 @@ void sendUSARTBufferNoSizeCheck(uint8_t * aParameterBufferPointer, size_t aParam
 void sendUSARTBuffer(uint8_t * aParameterBufferPointer, size_t aParameterBufferLength, uint8_t * aDataBufferPointer,
         size_t aDataBufferLength) {
 #ifdef USE_SIMPLE_SERIAL
+    recordJournalEntry(aParameterBufferPointer, aParameterBufferLength, aDataBufferPointer, aDataBufferLength);
     sendUSARTBufferSimple(aParameterBufferPointer, aParameterBufferLength, aDataBufferPointer, aDataBufferLength);
     return;
 #else
     if ((aParameterBufferLength + aDataBufferLength) > UART_SEND_BUFFER_SIZE) {
+        // record as one entry, not as chunks
+        recordJournalEntry(aParameterBufferPointer, aParameterBufferLength, aDataBufferPointer, aDataBufferLength);
+        bool tJournalWasSuspended = sJournalIsSuspended;
+        sJournalIsSuspended = true;
         // first send command
         sendUSARTBufferNoSizeCheck(aParameterBufferPointer, aParameterBufferLength, NULL, 0);
         // then send data in USART_SEND_BUFFER_SIZE chunks
@@ -458,6 +678,7 @@ void sendUSARTBuffer(uint8_t * aParameterBufferPointer, size_t aParameterBufferL
             aDataBufferPointer += UART_SEND_BUFFER_SIZE;
             tSize -= UART_SEND_BUFFER_SIZE;
         }
+        sJournalIsSuspended = tJournalWasSuspended;
     } else {
         sendUSARTBufferNoSizeCheck(aParameterBufferPointer, aParameterBufferLength, aDataBufferPointer,
                 aDataBufferLength);
@@ -503,12 +724,127 @@ void sendUSARTBufferSimple(uint8_t * aParameterBufferPointer, size_t aParameterB
 }
 #endif
 
+/*
+ * Color palette for sending colors as one byte index. Host has a copy of it.
+ */
+static const uint16_t *sColorPalette = NULL;
+static uint16_t sColorPaletteSize = 0;
+static uint8_t sLastPaletteIndex = 0; // Colors tend to repeat, so check last hit first
+
+/**
+ * @param aPalette NULL disables palette mode
+ */
+void setColorPaletteForSend(const uint16_t *aPalette, uint16_t aNumberOfColors) {
+    if (aNumberOfColors > MAX_NUMBER_OF_PALETTE_COLORS) {
+        aNumberOfColors = MAX_NUMBER_OF_PALETTE_COLORS;
+    }
+    if (aPalette != sColorPalette || aNumberOfColors != sColorPaletteSize) {
+        // recorded palette indexes are invalid now
+        invalidateJournal();
+    }
+    sColorPalette = aPalette;
+    sColorPaletteSize = aNumberOfColors;
+    sLastPaletteIndex = 0;
+}
+
+/**
+ * @return NO_PALETTE_INDEX if no palette is set or color is not contained
+ */
+int16_t getPaletteIndexForSend(uint16_t aColor) {
+    if (sColorPalette == NULL) {
+        return NO_PALETTE_INDEX;
+    }
+    if (sLastPaletteIndex < sColorPaletteSize && sColorPalette[sLastPaletteIndex] == aColor) {
+        return sLastPaletteIndex;
+    }
+    for (uint16_t i = 0; i < sColorPaletteSize; ++i) {
+        if (sColorPalette[i] == aColor) {
+            sLastPaletteIndex = i;
+            return i;
+        }
+    }
+    return NO_PALETTE_INDEX;
+}
+
+/*
+ * Stores the parameters little endian to the buffer. Colors of the palette are stored as one byte palette index.
+ * Sets the parameter length and the mask of palette parameters in the length field.
+ * @param aBuffer must start with sync token and function tag, then the 2 bytes of the length field follows.
+ * @return number of bytes in buffer
+ */
+static uint8_t storeArgsWithColors(uint8_t *aBuffer, uint8_t aColorParameterMask, int aNumberOfArgs, va_list &aArgp) {
+    uint8_t *tBufferPointer = &aBuffer[4];
+    uint8_t tPaletteParameterMask = 0;
+    for (int i = 0; i < aNumberOfArgs; ++i) {
+        uint16_t tArg = va_arg(aArgp, int);
+        int16_t tPaletteIndex;
+        if (i < 8 && (aColorParameterMask & (1 << i)) && (tPaletteIndex = getPaletteIndexForSend(tArg)) != NO_PALETTE_INDEX) {
+            *tBufferPointer++ = tPaletteIndex;
+            tPaletteParameterMask |= 1 << i;
+        } else {
+            *tBufferPointer++ = tArg;
+            *tBufferPointer++ = tArg >> 8;
+        }
+    }
+    aBuffer[2] = tBufferPointer - &aBuffer[4];
+    aBuffer[3] = tPaletteParameterMask;
+    return tBufferPointer - aBuffer;
+}
+
+/**
+ * Like sendUSARTArgs(), but parameters, which are marked in aColorParameterMask, are sent as one byte palette index
+ * if a palette is set and the color is contained in it.
+ * @param aColorParameterMask bit n is set if parameter n is a color. Only parameter 0 to 7 can be a color.
+ */
+void sendUSARTArgsWithColors(uint8_t aFunctionTag, uint8_t aColorParameterMask, int aNumberOfArgs, ...) {
+    assertParamMessage((aNumberOfArgs <= MAX_NUMBER_OF_ARGS_FOR_BD_FUNCTIONS), aNumberOfArgs, "only 12 params max");
+
+    uint8_t tParamBuffer[(MAX_NUMBER_OF_ARGS_FOR_BD_FUNCTIONS + 2) * 2];
+    tParamBuffer[0] = SYNC_TOKEN;
+    tParamBuffer[1] = aFunctionTag;
+    va_list argp;
+    va_start(argp, aNumberOfArgs);
+    uint8_t tLength = storeArgsWithColors(tParamBuffer, aColorParameterMask, aNumberOfArgs, argp);
+    va_end(argp);
+
+    sendUSARTBufferNoSizeCheck(tParamBuffer, tLength, NULL, 0);
+}
+
+/**
+ * Like sendUSARTArgsAndByteBuffer(), but with colors as one byte palette index
+ * Last two arguments are length of buffer and buffer pointer (..., size_t aDataLength, uint8_t * aDataBufferPtr)
+ */
+void sendUSARTArgsWithColorsAndByteBuffer(uint8_t aFunctionTag, uint8_t aColorParameterMask, int aNumberOfArgs, ...) {
+    if (aNumberOfArgs > MAX_NUMBER_OF_ARGS_FOR_BD_FUNCTIONS) {
+        return;
+    }
+
+    uint8_t tParamBuffer[(MAX_NUMBER_OF_ARGS_FOR_BD_FUNCTIONS + 4) * 2];
+    tParamBuffer[0] = SYNC_TOKEN;
+    tParamBuffer[1] = aFunctionTag;
+    va_list argp;
+    va_start(argp, aNumberOfArgs);
+    uint8_t tLength = storeArgsWithColors(tParamBuffer, aColorParameterMask, aNumberOfArgs, argp);
+// add data field header
+    uint8_t *tBufferPointer = &tParamBuffer[tLength];
+    *tBufferPointer++ = SYNC_TOKEN; // start new transmission block
+    *tBufferPointer++ = DATAFIELD_TAG_BYTE;
+    uint16_t tDataLength = va_arg(argp, int); // length in byte
+    *tBufferPointer++ = tDataLength;
+    *tBufferPointer++ = tDataLength >> 8;
+    uint8_t * aBufferPtr = (uint8_t *) va_arg(argp, int); // Buffer address
+    va_end(argp);
+
+    sendUSARTBufferNoSizeCheck(tParamBuffer, tLength + 4, aBufferPtr, tDataLength);
+}
+
 /**
  * send:
  * 1. Sync Byte A5
  * 2. Byte Function token
  * 3. Short length of parameters (here 5*2)
  * 4. Short n parameters
+ * If a palette is set, aColor is sent as one byte palette index
  */
 void sendUSART5Args(uint8_t aFunctionTag, uint16_t aXStart, uint16_t aYStart, uint16_t aXEnd, uint16_t aYEnd,
         uint16_t aColor) {
@@ -516,13 +852,24 @@ void sendUSART5Args(uint8_t aFunctionTag, uint16_t aXStart, uint16_t aYStart, ui
 
     uint16_t * tBufferPointer = &tParamBuffer[0];
     *tBufferPointer++ = aFunctionTag << 8 | SYNC_TOKEN; // add sync token
-    *tBufferPointer++ = 10;
+    int16_t tPaletteIndex = getPaletteIndexForSend(aColor);
+    if (tPaletteIndex != NO_PALETTE_INDEX) {
+        // 9 bytes, parameter 4 is palette index
+        *tBufferPointer++ = (1 << 4) << 8 | 9;
+    } else {
+        *tBufferPointer++ = 10;
+    }
     *tBufferPointer++ = aXStart;
     *tBufferPointer++ = aYStart;
     *tBufferPointer++ = aXEnd;
     *tBufferPointer++ = aYEnd;
-    *tBufferPointer++ = aColor;
-    sendUSARTBufferNoSizeCheck((uint8_t*) &tParamBuffer[0], 14, NULL, 0);
+    if (tPaletteIndex != NO_PALETTE_INDEX) {
+        *tBufferPointer = tPaletteIndex; // little endian, so lower byte is the first one
+        sendUSARTBufferNoSizeCheck((uint8_t*) &tParamBuffer[0], 13, NULL, 0);
+    } else {
+        *tBufferPointer = aColor;
+        sendUSARTBufferNoSizeCheck((uint8_t*) &tParamBuffer[0], 14, NULL, 0);
+    }
 }
 
 /**
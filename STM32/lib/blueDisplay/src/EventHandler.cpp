@@ -34,6 +34,7 @@
 
 #include "EventHandler.h"
 #include "BlueDisplay.h"
+#include "BDNumberFormat.h"
 
 #if defined(ARDUINO)
 #include <Arduino.h> // for millis()
@@ -43,7 +44,6 @@
 #  include "stm32f3_discovery.h"  // For LEDx
 #  endif
 #include "stm32fx0xPeripherals.h" // For Watchdog_reload()
-#include <stdio.h> // for printf
 #endif // ARDUINO
 
 #if defined(SUPPORT_LOCAL_DISPLAY)
@@ -361,6 +361,7 @@ extern "C" void handleEvent(struct BluetoothEvent *aEvent) {
         Serial.println(aEvent->EventType, HEX);
 #endif
     uint8_t tEventType = aEvent->EventType;
+    bool tIsConnectionBuildUp = false; // redraw after connection build up is recorded in journal
 
     // local copy of event since the values in the original event may be overwritten if the handler requires long time for its action
     struct BluetoothEvent tEvent = *aEvent;
@@ -549,6 +550,8 @@ extern "C" void handleEvent(struct BluetoothEvent *aEvent) {
         if (!BlueDisplay1.mBlueDisplayConnectionEstablished) {
             // if this is the first event, which sets mBlueDisplayConnectionEstablished to true, call connection callback anyway
             BlueDisplay1.mBlueDisplayConnectionEstablished = true;
+            startJournalRecording();
+            tIsConnectionBuildUp = true;
             if (sConnectCallback != NULL) {
                 sConnectCallback();
             }
@@ -582,10 +585,27 @@ extern "C" void handleEvent(struct BluetoothEvent *aEvent) {
 
         // first write a NOP command for synchronizing
         BlueDisplay1.sendSync();
+        // before sConnectCallback() or replay, since they send colors. The palette is not cleared by reset all.
+        BlueDisplay1.sendColorPalette();
 
-        if (sConnectCallback != NULL) {
-            sConnectCallback();
+        if (isJournalValid()) {
+            /*
+             * Replay the commands recorded at last connection build up instead of calling the connect callback.
+             * The host string table is rebuilt by the recorded string definitions, so interned strings are not reset.
+             * Recording is suspended until the redraw below is done.
+             */
+            replayJournal();
+        } else {
+            // a new connection has an empty host string table
+            BlueDisplay1.resetInternedStrings();
+            startJournalRecording();
+            if (sConnectCallback != NULL) {
+                sConnectCallback();
+            }
         }
+        tIsConnectionBuildUp = true;
+        // after replay or sConnectCallback(), since they tend to send a reset all command, which clears the host bitmap cache
+        BlueDisplay1.reuploadAllBitmaps();
         // Since with simpleSerial we have only buffer for 1 event, we must also call redraw here
         tEventType = EVENT_REDRAW;
 
@@ -618,9 +638,16 @@ extern "C" void handleEvent(struct BluetoothEvent *aEvent) {
          * Got current display size since host display size has changed (manually)
          */
         copyDisplaySizeAndTimestamp(&tEvent);
+        if (!tIsConnectionBuildUp) {
+            // display content changes, so journal must be recorded again at next connection build up
+            invalidateJournal();
+        }
         if (sRedrawCallback != NULL) {
             sRedrawCallback();
         }
+        // now the GUI is complete and only its changes are recorded
+        resumeJournalRecording();
+        endJournalRecording();
     }
     sBDEventJustReceived = true;
 #if defined(ARDUINO)
@@ -732,7 +759,19 @@ bool getDisplayXYValuesFlag(void) {
  */
 void printTPData(int x, int y, color16_t aColor, color16_t aBackColor) {
     char tStringBuffer[12];
-    snprintf(tStringBuffer, 12, "X:%03i Y:%03i", sCurrentPosition.TouchPosition.PosX, sCurrentPosition.TouchPosition.PosY);
+    // "X:%03i Y:%03i"
+    uint8_t tLength = 0;
+    tStringBuffer[tLength++] = 'X';
+    tStringBuffer[tLength++] = ':';
+    tLength += formatSignedDecimal(&tStringBuffer[tLength], sizeof(tStringBuffer) - tLength, sCurrentPosition.TouchPosition.PosX, 3,
+            FORMAT_PAD_ZERO);
+    if (tLength < sizeof(tStringBuffer) - 3) {
+        tStringBuffer[tLength++] = ' ';
+        tStringBuffer[tLength++] = 'Y';
+        tStringBuffer[tLength++] = ':';
+        formatSignedDecimal(&tStringBuffer[tLength], sizeof(tStringBuffer) - tLength, sCurrentPosition.TouchPosition.PosY, 3,
+                FORMAT_PAD_ZERO);
+    }
     BlueDisplay1.drawText(x, y, tStringBuffer, TEXT_SIZE_11, aColor, aBackColor);
 }
 #endif //SUPPORT_LOCAL_DISPLAY
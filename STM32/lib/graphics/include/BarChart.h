@@ -0,0 +1,59 @@
+/*
+ * BarChart.h
+ *
+ * Histogram drawn as bar chart with the axes and labels of Chart.
+ * Samples are binned one by one, and only the changed part of each bar is drawn.
+ * For the host, all changed parts of one color are sent as one rectangle list.
+ *
+ * @date 17.10.2026
+ * @author agent
+ * agent@local
+ * @copyright LGPL v3 (http://www.gnu.org/licenses/lgpl.html)
+ * @version 1.0.0
+ */
+
+#ifndef BAR_CHART_H_
+#define BAR_CHART_H_
+
+#include "Chart.h"
+
+// Number of rectangles sent with one FUNCTION_FILL_RECT_LIST command
+#define BAR_CHART_MAX_RECTS_PER_COMMAND 32
+
+class BarChart: public Chart {
+public:
+    BarChart(void);
+    bool initBins(uint16_t *aBinCounts, uint16_t *aBarHeights, uint16_t aNumberOfBins, int aFirstBinStartValue,
+            uint16_t aBinWidth);
+    void setBarColor(color16_t aBarColor);
+
+    /*
+     * Binning
+     */
+    void addSample(int aValue);
+    void addSamples(const int16_t *aDataPointer, uint16_t aNumberOfValues);
+    void clearBins(void);
+    uint16_t getBinCount(uint16_t aBinIndex) const;
+
+    /*
+     * Drawing
+     */
+    bool drawBars(void);
+    bool drawChangedBars(void);
+
+private:
+    void addRect(uint16_t *aRectBuffer, uint8_t *aNumberOfRects, color16_t aColor, uint16_t aX, uint16_t aY, uint16_t aWidth,
+            uint16_t aHeight);
+    void flushRects(uint16_t *aRectBuffer, uint8_t *aNumberOfRects, color16_t aColor);
+
+    uint16_t *mBinCounts; // NULL if not initialized
+    uint16_t *mBarHeights; // height in pixel of the bars on the display
+    uint16_t mNumberOfBins;
+    int mFirstBinStartValue;
+    uint16_t mBinWidth; // value range of one bin
+    color16_t mBarColor;
+    uint16_t mBarPitch; // pixel from start of one bar to start of next bar
+    uint16_t mBarWidth;
+};
+
+#endif // BAR_CHART_H_
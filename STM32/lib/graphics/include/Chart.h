@@ -16,6 +16,7 @@
  */
 
 #include "BlueDisplay.h"
+#include "ChartLTTB.h"
 
 #ifndef CHART_H_
 #define CHART_H_
@@ -30,6 +31,7 @@
 #define CHART_MODE_PIXEL 				0
 #define CHART_MODE_LINE 				1
 #define CHART_MODE_AREA 				2
+#define CHART_MODE_ENVELOPE 			3 // merge into the envelope, see initEnvelope()
 
 // Error codes
 #define CHART_ERROR_POS_X 		-1
@@ -45,6 +47,55 @@
 #define CHART_X_LABEL_INT 0x04 // else label is float
 #define CHART_Y_LABEL_USED 0x08
 #define CHART_Y_LABEL_INT 0x10 // else label is float
+#define CHART_CLEAR_DATA_BEFORE_DRAW 0x20 // host clears the last data of the same chart index before drawing
+#define CHART_X_PEAK_DETECT 0x40 // X compression shows min and max of the compressed values instead of average
+#define CHART_X_LTTB 0x80 // X compression selects the value by largest triangle three buckets instead of average
+
+// Line mode data is sent to host as one FUNCTION_DRAW_CHART byte buffer if chart is not wider
+#define CHART_MAX_HOST_BYTE_BUFFER_SIZE DISPLAY_DEFAULT_WIDTH
+
+// Points of X-Y charts are sent to host in chunks of this size. Clearing the last data works only for one chunk.
+#define CHART_MAX_HOST_XY_POINTS 256
+
+// Y display factor is normalized to a mantissa in [2^29, 2^30) and a shift, so that its precision is better than float
+#define CHART_Y_FACTOR_MANTISSA_MIN 0x20000000L
+#define CHART_Y_FACTOR_MAX_SHIFT 62
+
+// X scale modes of mXScaleFactor, used as template parameter for the sample to column loop
+#define CHART_X_SCALE_IDENTITY      0 // mXScaleFactor == 0
+#define CHART_X_SCALE_COMPRESS_1_5  1 // mXScaleFactor == -1
+#define CHART_X_SCALE_COMPRESS      2 // mXScaleFactor < -1
+#define CHART_X_SCALE_EXPAND_1_5    3 // mXScaleFactor == 1
+#define CHART_X_SCALE_EXPAND        4 // mXScaleFactor > 1
+
+// Size of the LTTB bucket buffer on stack, for bigger buckets average is used
+#define CHART_LTTB_BUCKET_BUFFER_SIZE 320 // 2 buckets of 160 values
+
+// Each trace uses the host chart index of its trace index, which is 4 bit
+#if !defined(CHART_MAX_NUMBER_OF_TRACES)
+#define CHART_MAX_NUMBER_OF_TRACES 4 // 16 is maximum
+#endif
+
+// Label cache per axis, only labels with changed text are redrawn by drawXAxis(true) and drawYAxis(true)
+#define CHART_MAX_NUMBER_OF_CACHED_LABELS 16 // if more labels are drawn, the cache is not used
+#define CHART_CACHED_LABEL_SIZE 8 // including terminating null, for longer labels the cache is not used
+
+struct ChartLabelCache {
+	char Labels[CHART_MAX_NUMBER_OF_CACHED_LABELS][CHART_CACHED_LABEL_SIZE];
+	bool IsValid;
+	uint8_t ClearDisplayCount; // BlueDisplay::mClearDisplayCount at drawing of the cached labels
+};
+
+struct ChartTrace {
+	const int16_t *DataPointer; // NULL if trace has no data
+	uint16_t DataLength;
+	color16_t Color;
+	color16_t ClearBeforeColor; // 0 -> host does not clear the last data of this trace
+	float YScale; // multiplied with the Y factor of the chart
+	int16_t YDisplayOffset; // in pixel, positive values move the trace up
+	bool HasChanged;
+};
+
 typedef union {
 	int IntValue;
 	float FloatValue;
@@ -64,6 +115,11 @@ public:
 	void initChartColors(const uint16_t aDataColor, const uint16_t aAxesColor, const uint16_t aGridColor,
 			const uint16_t aLabelColor, const uint16_t aBackgroundColor);
 	void setDataColor(uint16_t aDataColor);
+	void setHostChartIndex(uint8_t aChartIndex);
+	void setClearDataBeforeDraw(bool aDoClear);
+	void setXPeakDetect(bool aDoPeakDetect);
+	void setXLTTB(bool aDoLTTB);
+	void setDataLayer(uint8_t aLayer);
 
 	void clear(void);
 
@@ -82,8 +138,24 @@ public:
 	bool drawChartDataDirect(const uint8_t *aDataPointer, const uint16_t aDataLength, const uint8_t aMode);
     bool drawChartData(const int16_t *aDataPointer, const uint16_t aDataLength, const uint8_t aMode);
     bool drawChartData(const int16_t *aDataPointer, const int16_t * aDataEndPointer, const uint8_t aMode);
+	bool drawChartData(const int8_t *aDataPointer, const int8_t *aDataEndPointer, const uint8_t aMode);
+	bool drawChartData(const uint8_t *aDataPointer, const uint8_t *aDataEndPointer, const uint8_t aMode);
+	bool drawChartData(const uint16_t *aDataPointer, const uint16_t *aDataEndPointer, const uint8_t aMode);
+	bool drawChartData(const int32_t *aDataPointer, const int32_t *aDataEndPointer, const uint8_t aMode);
+	bool drawChartData(const float *aDataPointer, const float *aDataEndPointer, const uint8_t aMode);
     bool drawChartDataFloat(const float * aDataPointer, const float * aDataEndPointer, const uint8_t aMode);
+	bool initRollMode(uint8_t *aDisplayValueBuffer);
+	bool appendChartData(const int16_t *aDataPointer, uint16_t aNumberOfValues);
+	bool drawChartDataXY(const int16_t *aXDataPointer, const int16_t *aYDataPointer, uint16_t aNumberOfPoints);
+	bool drawChartDataXY(const float *aXDataPointer, const float *aYDataPointer, uint16_t aNumberOfPoints);
+	void setXDataFactor(float aXDataFactor);
+	bool initEnvelope(uint8_t *aEnvelopeBuffer, uint8_t aDecayPixelPerTrace);
+	void clearEnvelope(void);
+	bool initTrace(uint8_t aTraceIndex, color16_t aColor, float aYScale, int16_t aYDisplayOffset, color16_t aClearBeforeColor);
+	void setTraceData(uint8_t aTraceIndex, const int16_t *aDataPointer, uint16_t aDataLength);
+	bool drawChangedTraces(void);
 	void drawGrid(void);
+	void invalidateLabelCache(void);
 
 	/*
 	 * X Axis
@@ -162,7 +234,7 @@ public:
 	void setYTitleText(const char * aLabelText);
 	void drawYAxisTitle(const int aYOffset) const;
 
-private:
+protected:
 
     BlueDisplay * mDisplay; // The Display to use
 	// layout
@@ -178,6 +250,24 @@ private:
 	uint16_t mAxesColor;
 	uint16_t mGridColor;
 	uint16_t mLabelColor;
+	uint8_t mHostChartIndex; // 0 to 15, the host keeps the last data of each index for clearing
+	uint8_t mDataLayer; // host layer for data, LAYER_BACKGROUND -> data is drawn on the layer of grid and axes
+	// roll mode
+	uint8_t *mRollBuffer; // ring buffer of mWidthX display values, NULL if roll mode is not initialized
+	uint16_t mRollStartIndex; // index of leftmost column in mRollBuffer
+	uint16_t mRollNumberOfValues;
+	// envelope mode
+	uint8_t *mEnvelopeBuffer; // minimum and maximum display value of each of the mWidthX columns, NULL if not initialized
+	uint8_t mEnvelopeDecay; // pixel the envelope moves towards each new trace, 0 -> infinite persistence
+
+	// multi trace
+	ChartTrace mTraces[CHART_MAX_NUMBER_OF_TRACES];
+	float mYDisplayScale; // YScale of the trace currently drawn, 1 otherwise
+	int16_t mYDisplayOffset; // YDisplayOffset of the trace currently drawn, 0 otherwise
+
+	// labels currently on the display
+	ChartLabelCache mXLabelCache;
+	ChartLabelCache mYLabelCache;
 
 	/*
 	 *  X axis
@@ -201,6 +291,7 @@ private:
 	uint8_t mXNumVarsAfterDecimal;
 	uint8_t mXMinStringWidth;
 
+	float mXDataFactor; // Factor for X input to chart value, only used for X-Y charts
 	const char* mXTitleText; // No title text if NULL
 
 	/*
@@ -209,6 +300,13 @@ private:
 	int_float_union mYLabelStartValue;
 	int_float_union mYLabelIncrementValue; // Value difference between 2 grid labels - serves as Y scale factor
 	float mYDataFactor; // Factor for input (raw (int16_t) or float) to chart (not display!!!) value - e.g. (3.0 / 4096) for adc reading of 4096 for 3 Volt or 0.2 for 1000 display at 5000 raw value
+	// Fixed point factor for integer input -> display value, (input - mYInputOffset) * mYFactorMantissa >> mYFactorShift
+	int32_t mYFactorMantissa;
+	uint8_t mYFactorShift;
+	int mYInputOffset;
+	// Float factor and offset for float input -> display value
+	float mYDisplayFactor;
+	float mYInputOffsetFloat;
     uint8_t mGridYSpacing; // difference in pixel between 2 Y grid lines
 
 	// label formatting
@@ -218,6 +316,30 @@ private:
 	const char* mYTitleText; // No title text if NULL
 
 	uint8_t checkParameterValues();
+	bool isHostByteBufferUsable(void);
+	bool drawChartDataMinMax(const int16_t *aDataPointer, const int16_t *aDataEndPointer);
+	bool drawChartDataLTTB(const int16_t *aDataPointer, const int16_t *aDataEndPointer, const uint8_t aMode);
+	void sendHostByteBuffer(uint8_t *aByteBuffer, uint16_t aLength);
+	color16_t selectHostDataLayer(bool aDoClearData);
+	void deselectHostDataLayer(void);
+	void updateYDisplayFactor(void);
+	inline int getYDisplayValue(int aInputValue);
+	inline int getYDisplayValue(float aInputValue);
+	int getClippedYDisplayValue(int aInputValue, bool *aIsNotClipped);
+	template<typename T> bool drawChartDataGeneric(const T *aDataPointer, const T *aDataEndPointer, const uint8_t aMode);
+	template<typename T, uint8_t tXScaleMode> bool drawChartDataScaled(const T *aDataPointer, const T *aDataEndPointer,
+			const uint8_t aMode);
+	void drawRollBuffer(uint16_t aColor, bool aLocalDisplayOnly);
+	bool addToEnvelope(const uint8_t *aDisplayValues, uint16_t aNumberOfColumns);
+	void drawEnvelopeColumns(uint8_t *aMinMaxBuffer, uint16_t aFirstColumn, uint16_t aLastColumn, uint16_t aColor,
+			bool aUseHostByteBuffer);
+	template<typename T> bool drawChartDataXYGeneric(const T *aXDataPointer, const T *aYDataPointer, uint16_t aNumberOfPoints);
+	bool drawTrace(uint8_t aTraceIndex);
+	void drawXLabels(bool aClearLabelsBefore);
+	void drawYLabels(bool aClearLabelsBefore);
+	bool isLabelCacheUsable(ChartLabelCache *aLabelCache);
+	void drawLabel(ChartLabelCache *aLabelCache, uint8_t aLabelIndex, bool aUseCache, uint16_t aXPos, uint16_t aYPos,
+			const char *aLabelString);
 
 };
 
@@ -0,0 +1,63 @@
+/*
+ * ChartLTTB.h
+ *
+ * Largest triangle three buckets downsampling of chart data.
+ * Keeps the visual shape of long captures better than averaging or skipping values.
+ * Input is streamed, so any number of values can be reduced with a memory of two buckets.
+ * Has no display dependencies and can be used on a PC to reduce captured data.
+ *
+ * @date 17.10.2026
+ * @author agent
+ * agent@local
+ * @copyright LGPL v3 (http://www.gnu.org/licenses/lgpl.html)
+ * @version 1.0.0
+ */
+
+#ifndef CHART_LTTB_H_
+#define CHART_LTTB_H_
+
+#include <stdint.h>
+
+#define CHART_LTTB_MAX_BUCKET_SIZE 0x8000 // so that the sum of the Y values of a bucket fits in 32 bit
+
+class ChartLTTB {
+public:
+    static uint32_t getBucketBufferSize(uint32_t aNumberOfInputValues, uint16_t aNumberOfOutputValues);
+
+    bool init(uint32_t aNumberOfInputValues, uint16_t aNumberOfOutputValues, int16_t *aOutputBuffer, int16_t *aBucketBuffer);
+    void addValues(const int16_t *aDataPointer, uint32_t aNumberOfValues);
+    uint16_t getNumberOfOutputValues(void) const {
+        return mOutputIndex;
+    }
+
+private:
+    void addValue(int16_t aValue);
+    void selectFromBucket(int64_t aNextXSum, int32_t aNextYSum, uint16_t aNextCount);
+    void startBucket(uint32_t aBucketIndex);
+    void completeFillBucket(void);
+
+    uint32_t mNumberOfInputValues;
+    uint16_t mNumberOfOutputValues;
+    int16_t *mOutputBuffer;
+    uint16_t mOutputIndex;
+    uint32_t mInputIndex;
+
+    // Point selected last, it is the first point of the triangle
+    uint32_t mSelectedX;
+    int16_t mSelectedY;
+
+    // Bucket waiting for the average of the next bucket to select its point
+    int16_t *mSelectBucket;
+    uint32_t mSelectBucketStartX;
+    uint16_t mSelectBucketCount;
+
+    // Bucket currently filled
+    int16_t *mFillBucket;
+    uint32_t mFillBucketIndex;
+    uint32_t mFillBucketStartX;
+    uint32_t mFillBucketEndX; // first X of next bucket
+    uint16_t mFillBucketCount;
+    int32_t mFillBucketYSum;
+};
+
+#endif // CHART_LTTB_H_
@@ -0,0 +1,50 @@
+/*
+ * ChartSpectrum.h
+ *
+ * Spectrum of int16_t sample blocks by an in place fixed point FFT, for MCUs without FPU.
+ * Optional Hann window, magnitudes are converted to 1/10 dB by lookup tables.
+ * The spectrum can be drawn with Chart, e.g. with CHART_MODE_ENVELOPE for peak hold.
+ *
+ * @date 17.10.2026
+ * @author agent
+ * agent@local
+ * @copyright LGPL v3 (http://www.gnu.org/licenses/lgpl.html)
+ * @version 1.0.0
+ */
+
+#ifndef CHART_SPECTRUM_H_
+#define CHART_SPECTRUM_H_
+
+#include "Chart.h"
+
+#define CHART_SPECTRUM_MIN_FFT_SIZE 8
+#define CHART_SPECTRUM_MAX_FFT_SIZE 1024 // the sine table has 2 * CHART_SPECTRUM_MAX_FFT_SIZE entries for a full period
+#define CHART_SPECTRUM_SINE_TABLE_PERIOD (2 * CHART_SPECTRUM_MAX_FFT_SIZE)
+
+class ChartSpectrum {
+public:
+    bool init(uint16_t aFFTSize, int16_t *aRealBuffer, int16_t *aImaginaryBuffer, bool aUseHannWindow);
+    int16_t *getSampleBuffer(void) const {
+        return mRealBuffer;
+    }
+    uint16_t getNumberOfBins(void) const {
+        return mFFTSize / 2;
+    }
+
+    void computeSpectrum(void);
+    bool drawSpectrum(Chart *aChart, const uint8_t aMode);
+
+    static void computeFFT(int16_t *aRealBuffer, int16_t *aImaginaryBuffer, uint16_t aFFTSize);
+    static int16_t getLogMagnitude(int16_t aReal, int16_t aImaginary);
+    static int16_t getSine(uint16_t aIndex);
+
+private:
+    void applyHannWindow(void);
+
+    int16_t *mRealBuffer; // samples before, log magnitude of bins 0 to mFFTSize / 2 - 1 after computeSpectrum()
+    int16_t *mImaginaryBuffer;
+    uint16_t mFFTSize;
+    bool mUseHannWindow;
+};
+
+#endif // CHART_SPECTRUM_H_
@@ -0,0 +1,94 @@
+/*
+ * ChartTrigger.h
+ *
+ * Trigger search for oscilloscope like captures of int16_t or uint8_t samples.
+ * Supports edge triggers with hysteresis, level triggers and pulse width triggers.
+ * A capture ring buffer keeps the samples before the trigger, and the window aligned at the trigger
+ * is drawn with Chart.
+ *
+ * @date 17.10.2026
+ * @author agent
+ * agent@local
+ * @copyright LGPL v3 (http://www.gnu.org/licenses/lgpl.html)
+ * @version 1.0.0
+ */
+
+#ifndef CHART_TRIGGER_H_
+#define CHART_TRIGGER_H_
+
+#include "Chart.h"
+
+/*
+ * Trigger types, bit 0 set means falling direction
+ */
+#define CHART_TRIGGER_TYPE_RISING_EDGE      0
+#define CHART_TRIGGER_TYPE_FALLING_EDGE     1
+#define CHART_TRIGGER_TYPE_LEVEL_ABOVE      2 // first sample >= level
+#define CHART_TRIGGER_TYPE_LEVEL_BELOW      3 // first sample <= level
+#define CHART_TRIGGER_TYPE_POSITIVE_PULSE   4 // at the falling edge of a pulse with matching width
+#define CHART_TRIGGER_TYPE_NEGATIVE_PULSE   5 // at the rising edge of a pulse with matching width
+#define CHART_TRIGGER_TYPE_FALLING_MASK     0x01
+
+#define CHART_TRIGGER_NOT_FOUND             (-1)
+
+class ChartTrigger {
+public:
+    ChartTrigger(void);
+    void setTrigger(uint8_t aTriggerType, int16_t aLevel, uint16_t aHysteresis);
+    void setPulseWidth(uint32_t aMinimumWidth, uint32_t aMaximumWidth);
+
+    /*
+     * Search over consecutive buffers
+     */
+    void resetSearch(uint32_t aMinimumTriggerIndex);
+    int32_t findTrigger(const int16_t *aDataPointer, uint32_t aNumberOfValues);
+    int32_t findTrigger(const uint8_t *aDataPointer, uint32_t aNumberOfValues);
+
+    /*
+     * Window of a capture buffer
+     */
+    bool drawTriggeredWindow(Chart *aChart, const int16_t *aDataPointer, uint32_t aNumberOfValues, uint16_t aWindowSize,
+            uint16_t aPreTriggerSize, const uint8_t aMode);
+    bool drawTriggeredWindow(Chart *aChart, const uint8_t *aDataPointer, uint32_t aNumberOfValues, uint16_t aWindowSize,
+            uint16_t aPreTriggerSize, const uint8_t aMode);
+
+    /*
+     * Capture into ring buffer
+     */
+    void initCapture(int16_t *aRingBuffer, uint16_t aRingBufferSize, uint16_t aPreTriggerSize);
+    bool addSamples(const int16_t *aDataPointer, uint32_t aNumberOfValues);
+    bool isCaptureComplete(void) const {
+        return mCaptureIsComplete;
+    }
+    bool drawCapture(Chart *aChart, const uint8_t aMode);
+
+private:
+    template<typename T> int32_t findTriggerGeneric(const T *aDataPointer, uint32_t aNumberOfValues);
+    template<typename T> bool drawTriggeredWindowGeneric(Chart *aChart, const T *aDataPointer, uint32_t aNumberOfValues,
+            uint16_t aWindowSize, uint16_t aPreTriggerSize, const uint8_t aMode);
+    void copyToRingBuffer(const int16_t *aDataPointer, uint32_t aNumberOfValues);
+
+    uint8_t mTriggerType;
+    int16_t mLevel;
+    uint16_t mHysteresis;
+    uint32_t mMinimumPulseWidth;
+    uint32_t mMaximumPulseWidth;
+
+    // Search state, kept between calls of findTrigger()
+    bool mIsActive; // true if signal is beyond level in trigger direction and not yet back by hysteresis
+    bool mPulseStartIsValid;
+    uint32_t mPulseStartIndex;
+    uint32_t mSampleIndex; // index of first value of the current buffer since resetSearch()
+    uint32_t mMinimumTriggerIndex; // triggers before are ignored
+
+    // Capture state
+    int16_t *mRingBuffer;
+    uint16_t mRingBufferSize;
+    uint16_t mPreTriggerSize;
+    uint16_t mRingBufferWriteIndex;
+    uint16_t mPostTriggerCount; // samples still to capture after trigger
+    bool mIsTriggered;
+    bool mCaptureIsComplete;
+};
+
+#endif // CHART_TRIGGER_H_
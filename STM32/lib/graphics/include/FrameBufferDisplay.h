@@ -0,0 +1,73 @@
+/*
+ * FrameBufferDisplay.h
+ *
+ * In memory RGB565 display with the same drawing interface as the MI0283QT2 and SSD1289 drivers.
+ * Can be used as LocalDisplay by defining USE_FRAME_BUFFER_DISPLAY, e.g. to test and benchmark
+ * local rendering without display hardware. Frames can be written as PPM file.
+ *
+ * @date 16.10.2026
+ * @author agent
+ * agent@local
+ * @copyright LGPL v3 (http://www.gnu.org/licenses/lgpl.html)
+ * @version 1.0.0
+ */
+
+#ifndef FRAME_BUFFER_DISPLAY_H_
+#define FRAME_BUFFER_DISPLAY_H_
+
+#include <stdint.h>
+#include <stdio.h>
+
+class FrameBufferDisplay {
+public:
+    FrameBufferDisplay(uint16_t aWidth, uint16_t aHeight, uint16_t *aFrameBuffer = NULL);
+    ~FrameBufferDisplay();
+    bool init(void);
+
+    uint16_t getDisplayWidth(void) const {
+        return mWidth;
+    }
+    uint16_t getDisplayHeight(void) const {
+        return mHeight;
+    }
+    uint16_t *getFrameBuffer(void) const {
+        return mFrameBuffer;
+    }
+
+    void clearDisplay(uint16_t aColor);
+    void drawPixel(uint16_t aXPos, uint16_t aYPos, uint16_t aColor);
+    uint16_t readPixel(uint16_t aXPos, uint16_t aYPos) const;
+    void drawLine(uint16_t aXStart, uint16_t aYStart, uint16_t aXEnd, uint16_t aYEnd, uint16_t aColor);
+    void drawLineFastOneX(uint16_t aXStart, uint16_t aYStart, uint16_t aYEnd, uint16_t aColor);
+    void drawRect(uint16_t aXStart, uint16_t aYStart, uint16_t aXEnd, uint16_t aYEnd, uint16_t aColor);
+    void fillRect(uint16_t aXStart, uint16_t aYStart, uint16_t aXEnd, uint16_t aYEnd, uint16_t aColor);
+    void drawCircle(uint16_t aXCenter, uint16_t aYCenter, uint16_t aRadius, uint16_t aColor);
+    void fillCircle(uint16_t aXCenter, uint16_t aYCenter, uint16_t aRadius, uint16_t aColor);
+
+    uint16_t drawChar(uint16_t aPosX, uint16_t aPosY, char aChar, uint8_t aCharSize, uint16_t aFGColor, uint16_t aBGColor);
+    uint16_t drawText(uint16_t aPosX, uint16_t aPosY, const char *aStringPtr, uint8_t aCharSize, uint16_t aFGColor,
+            uint16_t aBGColor);
+    uint16_t drawTextPGM(uint16_t aPosX, uint16_t aPosY, const char *aPGMString, uint8_t aCharSize, uint16_t aFGColor,
+            uint16_t aBGColor);
+    uint16_t drawMLText(uint16_t aPosX, uint16_t aPosY, const char *aStringPtr, uint8_t aCharSize, uint16_t aFGColor,
+            uint16_t aBGColor);
+
+    bool writePPM(const char *aFilename) const;
+    bool writePPM(FILE *aFile) const;
+
+private:
+    void fillSpan(uint16_t *aStartPointer, uint16_t aLength, uint16_t aColor);
+    void drawHorizontalSpan(int aXStart, int aXEnd, int aYPos, uint16_t aColor);
+
+    uint16_t *mFrameBuffer;
+    uint16_t mWidth;
+    uint16_t mHeight;
+    bool mFrameBufferIsAllocated; // true if frame buffer was allocated by init() and must be freed
+};
+
+#if defined(USE_FRAME_BUFFER_DISPLAY)
+// Instance used as LocalDisplay - must be provided by main program
+extern FrameBufferDisplay LocalDisplay;
+#endif
+
+#endif // FRAME_BUFFER_DISPLAY_H_
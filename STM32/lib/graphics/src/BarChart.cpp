@@ -0,0 +1,185 @@
+/*
+ * BarChart.cpp
+ * Histogram with incremental binning and drawing of the changed bar parts.
+ *
+ * Bars are drawn from the row above the X axis upwards, the Y label settings of Chart convert counts to pixel.
+ * E.g. initYLabelInt(0, 10, 1.0, 3) with a Y grid spacing of 20 shows 10 counts per grid line.
+ * X labels are not related to the bins, use a X grid spacing of a multiple of the bar pitch to label the bins.
+ *
+ * @date 17.10.2026
+ * @author agent
+ * agent@local
+ * @copyright LGPL v3 (http://www.gnu.org/licenses/lgpl.html)
+ * @version 1.0.0
+ */
+
+#include "BarChart.h"
+
+#include <stddef.h> // for NULL
+
+/** @addtogroup Graphic_Library
+ * @{
+ */
+BarChart::BarChart(void) { // @suppress("Class members should be properly initialized")
+    mBinCounts = NULL;
+    mBarHeights = NULL;
+    mNumberOfBins = 0;
+    mBarColor = CHART_DEFAULT_AXES_COLOR;
+}
+
+/**
+ * Must be called after initChart(), since the bars are distributed over the chart width.
+ * @param aBinCounts buffer for aNumberOfBins counts
+ * @param aBarHeights buffer for aNumberOfBins bar heights
+ * @param aFirstBinStartValue lowest value of the first bin. Values below are counted in the first bin,
+ *        values above the last bin in the last bin.
+ * @param aBinWidth number of values counted in one bin
+ * @return false if the chart is too small for the bins
+ */
+bool BarChart::initBins(uint16_t *aBinCounts, uint16_t *aBarHeights, uint16_t aNumberOfBins, int aFirstBinStartValue,
+        uint16_t aBinWidth) {
+    mBinCounts = NULL;
+    mNumberOfBins = aNumberOfBins;
+    if (aNumberOfBins == 0 || aBinWidth == 0) {
+        return false;
+    }
+    // bars start right of Y axis
+    mBarPitch = (mWidthX - 1) / aNumberOfBins;
+    if (mBarPitch == 0) {
+        return false;
+    }
+    mBarWidth = mBarPitch;
+    if (mBarPitch > 2) {
+        // gap between bars
+        mBarWidth--;
+    }
+    mBinCounts = aBinCounts;
+    mBarHeights = aBarHeights;
+    mFirstBinStartValue = aFirstBinStartValue;
+    mBinWidth = aBinWidth;
+    clearBins();
+    for (uint16_t i = 0; i < aNumberOfBins; ++i) {
+        mBarHeights[i] = 0;
+    }
+    return true;
+}
+
+void BarChart::setBarColor(color16_t aBarColor) {
+    mBarColor = aBarColor;
+}
+
+void BarChart::addSample(int aValue) {
+    if (mBinCounts == NULL) {
+        return;
+    }
+    int tBinIndex = 0;
+    if (aValue > mFirstBinStartValue) {
+        tBinIndex = (aValue - mFirstBinStartValue) / mBinWidth;
+        if (tBinIndex >= mNumberOfBins) {
+            tBinIndex = mNumberOfBins - 1;
+        }
+    }
+    if (mBinCounts[tBinIndex] < 0xFFFF) {
+        mBinCounts[tBinIndex]++;
+    }
+}
+
+void BarChart::addSamples(const int16_t *aDataPointer, uint16_t aNumberOfValues) {
+    while (aNumberOfValues > 0) {
+        addSample(*aDataPointer++);
+        aNumberOfValues--;
+    }
+}
+
+/**
+ * Sets all counts to 0. Bars are removed by the next call of drawChangedBars().
+ */
+void BarChart::clearBins(void) {
+    if (mBinCounts == NULL) {
+        return;
+    }
+    for (uint16_t i = 0; i < mNumberOfBins; ++i) {
+        mBinCounts[i] = 0;
+    }
+}
+
+uint16_t BarChart::getBinCount(uint16_t aBinIndex) const {
+    if (mBinCounts == NULL || aBinIndex >= mNumberOfBins) {
+        return 0;
+    }
+    return mBinCounts[aBinIndex];
+}
+
+/*
+ * Rectangles are relative to the top left of the chart
+ */
+void BarChart::addRect(uint16_t *aRectBuffer, uint8_t *aNumberOfRects, color16_t aColor, uint16_t aX, uint16_t aY,
+        uint16_t aWidth, uint16_t aHeight) {
+    uint16_t *tRect = &aRectBuffer[4 * *aNumberOfRects];
+    tRect[0] = aX;
+    tRect[1] = aY;
+    tRect[2] = aWidth;
+    tRect[3] = aHeight;
+    (*aNumberOfRects)++;
+    if (*aNumberOfRects == BAR_CHART_MAX_RECTS_PER_COMMAND) {
+        flushRects(aRectBuffer, aNumberOfRects, aColor);
+    }
+}
+
+void BarChart::flushRects(uint16_t *aRectBuffer, uint8_t *aNumberOfRects, color16_t aColor) {
+    if (*aNumberOfRects > 0) {
+        mDisplay->fillRectList(mPositionX, mPositionY - (mHeightY - 1), aColor, aRectBuffer, *aNumberOfRects);
+        *aNumberOfRects = 0;
+    }
+}
+
+/**
+ * Clears the chart area and draws all bars. Call it after changing Y label values.
+ * @return false if a bar is clipped
+ */
+bool BarChart::drawBars(void) {
+    if (mBinCounts == NULL) {
+        return false;
+    }
+    clear();
+    for (uint16_t i = 0; i < mNumberOfBins; ++i) {
+        mBarHeights[i] = 0;
+    }
+    return drawChangedBars();
+}
+
+/**
+ * Draws only the part of each bar, which changed since the last call. Growing parts are sent as one rectangle list
+ * with the bar color, shrinking parts as one rectangle list with the background color.
+ * @return false if a bar is clipped
+ */
+bool BarChart::drawChangedBars(void) {
+    if (mBinCounts == NULL) {
+        return false;
+    }
+    bool tRetValue = true;
+    uint16_t tGrowRects[4 * BAR_CHART_MAX_RECTS_PER_COMMAND];
+    uint16_t tShrinkRects[4 * BAR_CHART_MAX_RECTS_PER_COMMAND];
+    uint8_t tNumberOfGrowRects = 0;
+    uint8_t tNumberOfShrinkRects = 0;
+    // row of display value 0 is the X axis, so bars end one row above it
+    uint16_t tXAxisRow = mHeightY - 1;
+
+    uint16_t tBarX = 1;
+    for (uint16_t i = 0; i < mNumberOfBins; ++i) {
+        int tHeight = getClippedYDisplayValue(mBinCounts[i], &tRetValue);
+        int tOldHeight = mBarHeights[i];
+        if (tHeight > tOldHeight) {
+            addRect(tGrowRects, &tNumberOfGrowRects, mBarColor, tBarX, tXAxisRow - tHeight, mBarWidth, tHeight - tOldHeight);
+        } else if (tHeight < tOldHeight) {
+            addRect(tShrinkRects, &tNumberOfShrinkRects, mChartBackgroundColor, tBarX, tXAxisRow - tOldHeight, mBarWidth,
+                    tOldHeight - tHeight);
+        }
+        mBarHeights[i] = tHeight;
+        tBarX += mBarPitch;
+    }
+    flushRects(tShrinkRects, &tNumberOfShrinkRects, mChartBackgroundColor);
+    flushRects(tGrowRects, &tNumberOfGrowRects, mBarColor);
+    return tRetValue;
+}
+/** @} */
@@ -28,9 +28,9 @@
 
 #include "Chart.h"
 #include "AssertErrorAndMisc.h"
+#include "BDNumberFormat.h"
 
 //#include "stm32f30x.h"
-#include <stdio.h>
 #include <string.h>
 #include <stdlib.h> // for srand
 /** @addtogroup Graphic_Library
@@ -47,7 +47,24 @@ Chart::Chart(void) {
     mLabelColor = CHART_DEFAULT_LABEL_COLOR;
     mFlags = 0;
     mXScaleFactor = 0;
+    mHostChartIndex = 0;
+    mDataLayer = LAYER_BACKGROUND;
     mXTitleText = NULL;
+    mRollBuffer = NULL;
+    mEnvelopeBuffer = NULL;
+    mYDisplayScale = 1.0;
+    mXDataFactor = 1.0;
+    mYDisplayOffset = 0;
+    mYFactorMantissa = 0;
+    mYFactorShift = 0;
+    mYDisplayFactor = 0;
+    mYInputOffsetFloat = 0;
+    mYInputOffset = 0;
+    for (uint8_t i = 0; i < CHART_MAX_NUMBER_OF_TRACES; ++i) {
+        mTraces[i].DataPointer = NULL;
+        mTraces[i].HasChanged = false;
+    }
+    invalidateLabelCache();
     mYTitleText = NULL;
 }
 
@@ -58,12 +75,72 @@ void Chart::initChartColors(const uint16_t aDataColor, const uint16_t aAxesColor
     mGridColor = aGridColor;
     mLabelColor = aLabelColor;
     mChartBackgroundColor = aBackgroundColor;
+    invalidateLabelCache();
 }
 
 void Chart::setDataColor(uint16_t aDataColor) {
     mDataColor = aDataColor;
 }
 
+/**
+ * @param aChartIndex 0 to 15. Charts with different index can be cleared independently by the host.
+ * Traces use the indexes aChartIndex to aChartIndex + CHART_MAX_NUMBER_OF_TRACES - 1,
+ * so the indexes of two multi trace charts must be at least CHART_MAX_NUMBER_OF_TRACES apart.
+ */
+void Chart::setHostChartIndex(uint8_t aChartIndex) {
+    mHostChartIndex = aChartIndex & 0x0F;
+}
+
+/**
+ * If true, the host clears the last line mode data with background color before drawing new data.
+ * Background color must not be 0 (black), since 0 disables clearing.
+ */
+void Chart::setClearDataBeforeDraw(bool aDoClear) {
+    if (aDoClear) {
+        mFlags |= CHART_CLEAR_DATA_BEFORE_DRAW;
+    } else {
+        mFlags &= ~CHART_CLEAR_DATA_BEFORE_DRAW;
+    }
+}
+
+/**
+ * If true, X compression (mXScaleFactor < -1) draws a vertical line from minimum to maximum
+ * of the compressed values for each column, so that spikes are not hidden by averaging.
+ */
+void Chart::setXPeakDetect(bool aDoPeakDetect) {
+    if (aDoPeakDetect) {
+        mFlags |= CHART_X_PEAK_DETECT;
+    } else {
+        mFlags &= ~CHART_X_PEAK_DETECT;
+    }
+}
+
+/**
+ * Largest triangle three buckets X compression, if mXScaleFactor < -1.
+ * Keeps the visual shape of the data better than average. Peak detect has precedence.
+ * For data with much more values than columns, use ChartLTTB directly and draw its output with X scale factor 0.
+ */
+void Chart::setXLTTB(bool aDoLTTB) {
+    if (aDoLTTB) {
+        mFlags |= CHART_X_LTTB;
+    } else {
+        mFlags &= ~CHART_X_LTTB;
+    }
+}
+
+/**
+ * Data is drawn on the host layer aLayer above grid, axes and labels, which stay on LAYER_BACKGROUND.
+ * Then clearing the old data is one clearLayer() instead of drawing it again with background color,
+ * so an update costs one clear plus one chart buffer. The whole layer is cleared, so each chart needs its own layer.
+ * Not for envelope mode. The local display has only one layer and clears with background color as before.
+ * @param aLayer LAYER_BACKGROUND disables the data layer
+ */
+void Chart::setDataLayer(uint8_t aLayer) {
+    if (aLayer < MAX_NUMBER_OF_LAYERS) {
+        mDataLayer = aLayer;
+    }
+}
+
 /**
  * aPositionX and aPositionY are the 0 coordinates of the grid and part of the axes
  */
@@ -81,6 +158,8 @@ uint8_t Chart::initChart(const uint16_t aPositionX, const uint16_t aPositionY, c
     }
     mGridXSpacing = aGridXResolution;
     mGridYSpacing = aGridYResolution;
+    updateYDisplayFactor();
+    invalidateLabelCache();
 
     return checkParameterValues();
 }
@@ -134,6 +213,7 @@ void Chart::initXLabelInt(const int aXLabelStartValue, const int aXLabelIncremen
     mXScaleFactor = aXLabelScaleFactor;
     mXMinStringWidth = aXMinStringWidth;
     mFlags |= CHART_X_LABEL_INT | CHART_X_LABEL_USED;
+    invalidateLabelCache();
 }
 
 /**
@@ -149,6 +229,7 @@ void Chart::iniXAxisInt(const uint8_t aGridXSpacing, const int aXLabelStartValue
     mXLabelBaseIncrementValue.IntValue = aXLabelIncrementValue;
     mXMinStringWidth = aXMinStringWidth;
     mFlags |= CHART_X_LABEL_INT;
+    invalidateLabelCache();
     if (mXMinStringWidth != 0) {
         mFlags |= CHART_X_LABEL_USED;
     }
@@ -170,6 +251,7 @@ void Chart::initXLabelFloat(const float aXLabelStartValue, const float aXLabelIn
     mXNumVarsAfterDecimal = aXNumVarsAfterDecimal;
     mXMinStringWidth = aXMinStringWidthIncDecimalPoint;
     mFlags &= ~CHART_X_LABEL_INT;
+    invalidateLabelCache();
     if (aXMinStringWidthIncDecimalPoint != 0) {
         mFlags |= CHART_X_LABEL_USED;
     }
@@ -188,7 +270,9 @@ void Chart::initYLabelInt(const int aYLabelStartValue, const int aYLabelIncremen
     mYLabelIncrementValue.IntValue = aYLabelIncrementValue;
     mYMinStringWidth = aYMinStringWidth;
     mFlags |= CHART_Y_LABEL_INT | CHART_Y_LABEL_USED;
+    invalidateLabelCache();
     mYDataFactor = aYFactor;
+    updateYDisplayFactor();
 }
 
 /**
@@ -206,16 +290,33 @@ void Chart::initYLabelFloat(const float aYLabelStartValue, const float aYLabelIn
     mYNumVarsAfterDecimal = aYNumVarsAfterDecimal;
     mYMinStringWidth = aYMinStringWidthIncDecimalPoint;
     mYDataFactor = aYFactor;
+    invalidateLabelCache();
     mFlags &= ~CHART_Y_LABEL_INT;
     mFlags |= CHART_Y_LABEL_USED;
+    updateYDisplayFactor();
 }
 
 /**
  * Render the chart on the lcd
+ * Axes, indicators and grid are sent as one command, labels are drawn after
  */
 void Chart::drawAxesAndGrid(void) {
-    drawAxes(false);
-    drawGrid();
+    uint8_t tGridFlags = 0;
+    if (mFlags & CHART_HAS_GRID) {
+        tGridFlags = CHART_GRID_FLAG_GRID_LINES;
+    } else {
+        // indicators are only drawn if labels are used
+        if (mFlags & CHART_X_LABEL_USED) {
+            tGridFlags |= CHART_GRID_FLAG_X_INDICATORS;
+        }
+        if (mFlags & CHART_Y_LABEL_USED) {
+            tGridFlags |= CHART_GRID_FLAG_Y_INDICATORS;
+        }
+    }
+    mDisplay->drawChartGrid(mPositionX, mPositionY, mWidthX, mHeightY, mGridXSpacing, mGridYSpacing, mAxesSize, tGridFlags,
+            mGridColor, mAxesColor);
+    drawXLabels(false);
+    drawYLabels(false);
 }
 
 void Chart::drawGrid(void) {
@@ -268,12 +369,54 @@ float Chart::adjustFloatWithXScaleFactor(float aValue) {
 }
 
 /**
- * draw x line with indicators and labels
+ * Forces drawXAxis(true) and drawYAxis(true) to clear the label stripes and to draw all labels.
+ * Call it if labels were overwritten by other drawings. Clearing the display is detected automatically.
  */
-void Chart::drawXAxis(bool aClearLabelsBefore) {
+void Chart::invalidateLabelCache(void) {
+    mXLabelCache.IsValid = false;
+    mYLabelCache.IsValid = false;
+}
 
-    char tLabelStringBuffer[32];
+bool Chart::isLabelCacheUsable(ChartLabelCache *aLabelCache) {
+    return aLabelCache->IsValid && aLabelCache->ClearDisplayCount == mDisplay->mClearDisplayCount;
+}
 
+/*
+ * Draws the label if aUseCache is false or if it differs from the cached label of aLabelIndex.
+ * If the new label is shorter than the cached one, only the remainder of the cached one is cleared.
+ * Labels which cannot be cached invalidate the cache, so they are all redrawn next time.
+ */
+void Chart::drawLabel(ChartLabelCache *aLabelCache, uint8_t aLabelIndex, bool aUseCache, uint16_t aXPos, uint16_t aYPos,
+        const char *aLabelString) {
+    uint8_t tLength = strlen(aLabelString);
+    if (aLabelIndex >= CHART_MAX_NUMBER_OF_CACHED_LABELS || tLength >= CHART_CACHED_LABEL_SIZE) {
+        aLabelCache->IsValid = false;
+        aUseCache = false;
+    }
+    if (aUseCache) {
+        char *tCachedLabel = aLabelCache->Labels[aLabelIndex];
+        if (strcmp(tCachedLabel, aLabelString) == 0) {
+            return;
+        }
+        uint8_t tCachedLength = strlen(tCachedLabel);
+        if (tCachedLength > tLength) {
+            mDisplay->fillRect(aXPos + (tLength * TEXT_SIZE_11_WIDTH), aYPos - TEXT_SIZE_11_ASCEND,
+                    aXPos + (tCachedLength * TEXT_SIZE_11_WIDTH) - 1, aYPos - TEXT_SIZE_11_ASCEND + TEXT_SIZE_11_HEIGHT,
+                    mChartBackgroundColor);
+        }
+    }
+    mDisplay->drawText(aXPos, aYPos, aLabelString, TEXT_SIZE_11, mLabelColor, mChartBackgroundColor);
+    if (aLabelCache->IsValid) {
+        strcpy(aLabelCache->Labels[aLabelIndex], aLabelString);
+    }
+}
+
+/**
+ * draw x line with indicators and labels
+ * @param aClearLabelsBefore if true, only labels which changed since the last call are redrawn,
+ *        if the label cache is invalid the label stripe is cleared and all labels are drawn
+ */
+void Chart::drawXAxis(bool aClearLabelsBefore) {
 // draw X line
     mDisplay->fillRectRel(mPositionX - (mAxesSize - 1), mPositionY, mWidthX + (mAxesSize - 1), mAxesSize, mAxesColor);
     if (mFlags & CHART_X_LABEL_USED) {
@@ -287,20 +430,31 @@ void Chart::drawXAxis(bool aClearLabelsBefore) {
             }
         }
 
-        /*
-         * draw labels (numbers)
-         */
+        drawXLabels(aClearLabelsBefore);
+    }
+}
+
+/*
+ * draw x labels (numbers)
+ */
+void Chart::drawXLabels(bool aClearLabelsBefore) {
+    if (mFlags & CHART_X_LABEL_USED) {
+        char tLabelStringBuffer[32];
         uint16_t tNumberYTop = mPositionY + 2 * mAxesSize;
         assertParamMessage((tNumberYTop <= (mDisplay->getDisplayHeight() - TEXT_SIZE_11_DECEND)), tNumberYTop,
                 "no space for x labels");
 
         // first offset is negative
-        tOffset = 1 - ((TEXT_SIZE_11_WIDTH * mXMinStringWidth) / 2);
-        if (aClearLabelsBefore) {
+        int16_t tOffset = 1 - ((TEXT_SIZE_11_WIDTH * mXMinStringWidth) / 2);
+        bool tUseCache = aClearLabelsBefore && isLabelCacheUsable(&mXLabelCache);
+        if (aClearLabelsBefore && !tUseCache) {
             // clear label space before
             mDisplay->fillRect(mPositionX + tOffset, tNumberYTop, mPositionX + mWidthX, tNumberYTop + TEXT_SIZE_11_HEIGHT,
                     mChartBackgroundColor);
         }
+        mXLabelCache.IsValid = true;
+        mXLabelCache.ClearDisplayCount = mDisplay->mClearDisplayCount;
+        uint8_t tLabelIndex = 0;
 
         // initialize both variables to avoid compiler warnings
         int tValue = mXLabelStartValue.IntValue;
@@ -313,15 +467,14 @@ void Chart::drawXAxis(bool aClearLabelsBefore) {
          */
         do {
             if (mFlags & CHART_X_LABEL_INT) {
-                snprintf(tLabelStringBuffer, sizeof tLabelStringBuffer, "%d", tValue);
+                formatSignedDecimal(tLabelStringBuffer, sizeof(tLabelStringBuffer), tValue);
                 tValue += tIncrementValue;
             } else {
-                snprintf(tLabelStringBuffer, sizeof tLabelStringBuffer, "%*.*f", mXMinStringWidth, mXNumVarsAfterDecimal,
-                        tValueFloat);
+                formatFloat(tLabelStringBuffer, sizeof(tLabelStringBuffer), tValueFloat, mXMinStringWidth, mXNumVarsAfterDecimal);
                 tValueFloat += tIncrementValueFloat;
             }
-            mDisplay->drawText(mPositionX + tOffset, tNumberYTop + TEXT_SIZE_11_ASCEND, tLabelStringBuffer,
-            TEXT_SIZE_11, mLabelColor, mChartBackgroundColor);
+            drawLabel(&mXLabelCache, tLabelIndex++, tUseCache, mPositionX + tOffset, tNumberYTop + TEXT_SIZE_11_ASCEND,
+                    tLabelStringBuffer);
             tOffset += mGridXSpacing;
         } while (tOffset <= mWidthX);
     }
@@ -395,11 +548,9 @@ void Chart::drawYAxisTitle(const int aYOffset) const {
 
 /**
  * draw y line with indicators and labels
+ * @param aClearLabelsBefore see drawXAxis()
  */
 void Chart::drawYAxis(const bool aClearLabelsBefore) {
-
-    char tLabelStringBuffer[32];
-
     mDisplay->fillRectRel(mPositionX - (mAxesSize - 1), mPositionY - (mHeightY - 1), mAxesSize, (mHeightY - 1), mAxesColor);
 
     if (mFlags & CHART_Y_LABEL_USED) {
@@ -413,19 +564,30 @@ void Chart::drawYAxis(const bool aClearLabelsBefore) {
             }
         }
 
-        /*
-         * draw labels (numbers)
-         */
+        drawYLabels(aClearLabelsBefore);
+    }
+}
+
+/*
+ * draw y labels (numbers)
+ */
+void Chart::drawYLabels(bool aClearLabelsBefore) {
+    if (mFlags & CHART_Y_LABEL_USED) {
+        char tLabelStringBuffer[32];
         int16_t tNumberXLeft = mPositionX - 2 * mAxesSize - 1 - (mYMinStringWidth * TEXT_SIZE_11_WIDTH);
         assertParamMessage((tNumberXLeft >= 0), tNumberXLeft, "no space for y labels");
 
         // first offset is half of character height
-        tOffset = TEXT_SIZE_11_HEIGHT / 2;
-        if (aClearLabelsBefore) {
+        uint16_t tOffset = TEXT_SIZE_11_HEIGHT / 2;
+        bool tUseCache = aClearLabelsBefore && isLabelCacheUsable(&mYLabelCache);
+        if (aClearLabelsBefore && !tUseCache) {
             // clear label space before
             mDisplay->fillRect(tNumberXLeft, mPositionY - mHeightY + 1, mPositionX - mAxesSize,
                     mPositionY - tOffset + TEXT_SIZE_11_HEIGHT + 1, mChartBackgroundColor);
         }
+        mYLabelCache.IsValid = true;
+        mYLabelCache.ClearDisplayCount = mDisplay->mClearDisplayCount;
+        uint8_t tLabelIndex = 0;
 
         // convert to string
         // initialize both variables to avoid compiler warnings
@@ -436,15 +598,14 @@ void Chart::drawYAxis(const bool aClearLabelsBefore) {
          */
         do {
             if (mFlags & CHART_Y_LABEL_INT) {
-                snprintf(tLabelStringBuffer, sizeof tLabelStringBuffer, "%ld", tValue);
+                formatSignedDecimal(tLabelStringBuffer, sizeof(tLabelStringBuffer), tValue);
                 tValue += mYLabelIncrementValue.IntValue;
             } else {
-                snprintf(tLabelStringBuffer, sizeof tLabelStringBuffer, "%*.*f", mYMinStringWidth, mYNumVarsAfterDecimal,
-                        tValueFloat);
+                formatFloat(tLabelStringBuffer, sizeof(tLabelStringBuffer), tValueFloat, mYMinStringWidth, mYNumVarsAfterDecimal);
                 tValueFloat += mYLabelIncrementValue.FloatValue;
             }
-            mDisplay->drawText(tNumberXLeft, mPositionY - tOffset + TEXT_SIZE_11_ASCEND, tLabelStringBuffer,
-            TEXT_SIZE_11, mLabelColor, mChartBackgroundColor);
+            drawLabel(&mYLabelCache, tLabelIndex++, tUseCache, tNumberXLeft, mPositionY - tOffset + TEXT_SIZE_11_ASCEND,
+                    tLabelStringBuffer);
             tOffset += mGridYSpacing;
         } while (tOffset <= (mHeightY + TEXT_SIZE_11_HEIGHT / 2));
     }
@@ -465,6 +626,7 @@ bool Chart::stepYLabelStartValueInt(const bool aDoIncrement, const int aMinValue
             tRetval = false;
         }
     }
+    updateYDisplayFactor();
     drawYAxis(true);
     return tRetval;
 }
@@ -479,7 +641,8 @@ float Chart::stepYLabelStartValueFloat(const int aSteps) {
     if (mYLabelStartValue.FloatValue < 0) {
         mYLabelStartValue.FloatValue = 0;
     }
-    drawYAxis(false);
+    updateYDisplayFactor();
+    drawYAxis(true);
     return mYLabelStartValue.FloatValue;
 }
 
@@ -492,41 +655,153 @@ void Chart::clear(void) {
     mDisplay->fillRectRel(mPositionX - (mAxesSize - 1), mPositionY, mWidthX + (mAxesSize - 1), mAxesSize, mAxesColor);
     //draw y line
     mDisplay->fillRectRel(mPositionX - (mAxesSize - 1), mPositionY - (mHeightY - 1), mAxesSize, mHeightY - 1, mAxesColor);
+    if (mDataLayer != LAYER_BACKGROUND) {
+        mDisplay->clearLayer(mDataLayer);
+    }
 }
 
-/**
- * Draws a chart  - Factor for float to chart value (mYFactor) is used to compute display values
- * @param aDataPointer pointer to raw data array
- * @param aDataEndPointer pointer to first element after data
- * @param aMode CHART_MODE_PIXEL, CHART_MODE_LINE or CHART_MODE_AREA
- * @return false if clipping occurs
+/*
+ * Host can not handle clipping and values must fit in one byte
  */
-bool Chart::drawChartDataFloat(const float *aDataPointer, const float *aDataEndPointer, const uint8_t aMode) {
+bool Chart::isHostByteBufferUsable(void) {
+    return USART_isBluetoothPaired() && mWidthX <= CHART_MAX_HOST_BYTE_BUFFER_SIZE && mHeightY <= 0x100
+            && !mDisplay->isClipActive();
+}
 
-    bool tRetValue = true;
-    float tInputValue;
+/*
+ * Selects the data layer for the following host chart buffer and clears it, if a data layer is set.
+ * @return color for the host to clear the last data of the chart index, 0 if no clearing is required
+ */
+color16_t Chart::selectHostDataLayer(bool aDoClearData) {
+    if (mDataLayer != LAYER_BACKGROUND) {
+        mDisplay->selectLayer(mDataLayer);
+        if (aDoClearData) {
+            mDisplay->clearLayer(mDataLayer);
+        }
+        return 0;
+    }
+    if (aDoClearData) {
+        return mChartBackgroundColor;
+    }
+    return 0;
+}
 
-// used only in line mode
-    int tLastValue = 0;
+void Chart::deselectHostDataLayer(void) {
+    if (mDataLayer != LAYER_BACKGROUND) {
+        mDisplay->selectLayer(LAYER_BACKGROUND);
+    }
+}
 
-    // Factor for Float -> Display value
-    float tYDisplayFactor = 1;
-    float tYOffset = 0;
+/*
+ * Values in aByteBuffer are relative to the top of the chart
+ */
+void Chart::sendHostByteBuffer(uint8_t *aByteBuffer, uint16_t aLength) {
+    if (aLength < 2) {
+        // host requires at least one line
+        return;
+    }
+    color16_t tClearBeforeColor = selectHostDataLayer(mFlags & CHART_CLEAR_DATA_BEFORE_DRAW);
+    mDisplay->drawChartByteBuffer(mPositionX, mPositionY - (mHeightY - 1), mDataColor, tClearBeforeColor, mHostChartIndex, true,
+            aByteBuffer, aLength);
+    deselectHostDataLayer();
+}
 
-    if (mFlags & CHART_Y_LABEL_INT) {
-        // mGridYSpacing / mYLabelIncrementValue.IntValue is factor float -> pixel e.g. 40 pixel for 200 value
-        tYDisplayFactor = (mYDataFactor * mGridYSpacing) / mYLabelIncrementValue.IntValue;
-        tYOffset = mYLabelStartValue.IntValue / mYDataFactor;
-    } else {
-        tYDisplayFactor = (mYDataFactor * mGridYSpacing) / mYLabelIncrementValue.FloatValue;
-        tYOffset = mYLabelStartValue.FloatValue / mYDataFactor;
+/*
+ * Integer only version of (int) (tYDisplayFactor * (aInputValue - tYOffset)) for MCUs without FPU.
+ * The mantissa holds the float factor exactly, so the product is rounded to 24 bit like the float multiplication
+ * to get exactly the same result.
+ */
+inline int Chart::getYDisplayValue(int aInputValue) {
+    int64_t tSignedProduct = (int64_t) (aInputValue - mYInputOffset) * mYFactorMantissa;
+    bool tIsNegative = tSignedProduct < 0;
+    uint64_t tProduct = tSignedProduct;
+    if (tIsNegative) {
+        // float conversion truncates towards zero
+        tProduct = -tSignedProduct;
+    }
+    if (tProduct >= (1UL << 24)) {
+        // round to nearest, ties to even
+        uint8_t tDropBits = (64 - 24) - __builtin_clzll(tProduct);
+        uint64_t tLSB = (uint64_t) 1 << tDropBits;
+        uint64_t tRemainder = tProduct & (tLSB - 1);
+        tProduct -= tRemainder;
+        if (tRemainder > (tLSB >> 1) || (tRemainder == (tLSB >> 1) && (tProduct & tLSB))) {
+            tProduct += tLSB;
+        }
+    }
+    int tDisplayValue = tProduct >> mYFactorShift;
+    if (tIsNegative) {
+        tDisplayValue = -tDisplayValue;
+    }
+    return tDisplayValue + mYDisplayOffset;
+}
+
+/*
+ * Float input uses the float factor, since it must be converted anyway
+ */
+inline int Chart::getYDisplayValue(float aInputValue) {
+    return (int) (mYDisplayFactor * (aInputValue - mYInputOffsetFloat)) + mYDisplayOffset;
+}
+
+/*
+ * Display value clipped to 0 to mHeightY - 1, e.g. for bar heights
+ * @param aIsNotClipped is set to false if clipping occurs
+ */
+int Chart::getClippedYDisplayValue(int aInputValue, bool *aIsNotClipped) {
+    int tDisplayValue = getYDisplayValue(aInputValue);
+    if (tDisplayValue < 0) {
+        tDisplayValue = 0;
+        *aIsNotClipped = false;
     }
+    if (tDisplayValue > mHeightY - 1) {
+        tDisplayValue = mHeightY - 1;
+        *aIsNotClipped = false;
+    }
+    return tDisplayValue;
+}
+
+/*
+ * Sum type for X compression and value type for Y conversion of each sample type
+ */
+template<typename T> struct ChartSampleTraits {
+    typedef int SumType;
+    typedef int ValueType;
+};
+template<> struct ChartSampleTraits<int32_t> {
+    typedef int64_t SumType;
+    typedef int ValueType;
+};
+template<> struct ChartSampleTraits<float> {
+    typedef float SumType;
+    typedef float ValueType;
+};
+
+/*
+ * Converts samples to columns and draws them. The X scale mode is a template parameter,
+ * so the compiler generates a loop without any check of mXScaleFactor for each mode.
+ */
+template<typename T, uint8_t tXScaleMode>
+bool Chart::drawChartDataScaled(const T *aDataPointer, const T *aDataEndPointer, const uint8_t aMode) {
+    typedef typename ChartSampleTraits<T>::SumType SumType;
+    typedef typename ChartSampleTraits<T>::ValueType ValueType;
+
+    if (aMode == CHART_MODE_ENVELOPE && (mEnvelopeBuffer == NULL || mWidthX > CHART_MAX_HOST_BYTE_BUFFER_SIZE)) {
+        return false;
+    }
+    bool tRetValue = true;
+
+// used only in line mode
+    int tLastValue = 0;
 
     uint16_t tXpos = mPositionX;
     bool tFirstValue = true;
 
+    // host draws a byte buffer always as line
+    bool tUseHostByteBuffer = aMode == CHART_MODE_LINE && isHostByteBufferUsable();
+    uint8_t tHostByteBuffer[CHART_MAX_HOST_BYTE_BUFFER_SIZE];
+
     int tXScaleCounter = mXScaleFactor;
-    if (mXScaleFactor < -1) {
+    if (tXScaleMode == CHART_X_SCALE_COMPRESS) {
         tXScaleCounter = -mXScaleFactor;
     }
 
@@ -534,26 +809,30 @@ bool Chart::drawChartDataFloat(const float *aDataPointer, const float *aDataEndP
         /*
          *  get data and perform X scaling
          */
-        if (mXScaleFactor == 0) {
+        ValueType tInputValue;
+        if (tXScaleMode == CHART_X_SCALE_IDENTITY) {
+            // check before reading, so that the last value is drawn too
+            if (aDataPointer >= aDataEndPointer) {
+                break;
+            }
             tInputValue = *aDataPointer++;
-        } else if (mXScaleFactor == -1) {
+        } else if (tXScaleMode == CHART_X_SCALE_COMPRESS_1_5) {
             // compress by factor 1.5 - every second value is the average of the next two values
             tInputValue = *aDataPointer++;
             tXScaleCounter--; // starts with 1
             if (tXScaleCounter < 0) {
                 // get average of actual and next value
-                tInputValue += *aDataPointer++;
-                tInputValue /= 2;
+                tInputValue = ((SumType) tInputValue + *aDataPointer++) / 2;
                 tXScaleCounter = 1;
             }
-        } else if (mXScaleFactor <= -1) {
+        } else if (tXScaleMode == CHART_X_SCALE_COMPRESS) {
             // compress - get average of multiple values
-            tInputValue = 0;
+            SumType tSum = 0;
             for (int j = 0; j < tXScaleCounter; ++j) {
-                tInputValue += *aDataPointer++;
+                tSum += *aDataPointer++;
             }
-            tInputValue /= tXScaleCounter;
-        } else if (mXScaleFactor == 1) {
+            tInputValue = tSum / tXScaleCounter;
+        } else if (tXScaleMode == CHART_X_SCALE_EXPAND_1_5) {
             // expand by factor 1.5 - every second value will be shown 2 times
             tInputValue = *aDataPointer++;
             tXScaleCounter--; // starts with 1
@@ -570,12 +849,12 @@ bool Chart::drawChartDataFloat(const float *aDataPointer, const float *aDataEndP
                 tXScaleCounter = mXScaleFactor;
             }
         }
-        // check for data pointer still in data buffer area
-        if (aDataPointer >= aDataEndPointer) {
+        // check for data pointer still in data buffer
+        if (tXScaleMode != CHART_X_SCALE_IDENTITY && aDataPointer >= aDataEndPointer) {
             break;
         }
 
-        uint16_t tDisplayValue = tYDisplayFactor * (tInputValue - tYOffset);
+        int tDisplayValue = getYDisplayValue(tInputValue);
         // clip to bottom line
         if (tDisplayValue < 0) {
             tDisplayValue = 0;
@@ -586,11 +865,25 @@ bool Chart::drawChartDataFloat(const float *aDataPointer, const float *aDataEndP
             tDisplayValue = mHeightY - 1;
             tRetValue = false;
         }
-        if (aMode == CHART_MODE_AREA) {
+        if (aMode == CHART_MODE_ENVELOPE) {
+            // tHostByteBuffer is only used as column buffer here
+            tHostByteBuffer[tXpos - mPositionX] = tDisplayValue;
+        } else if (tUseHostByteBuffer) {
+            tHostByteBuffer[tXpos - mPositionX] = (mHeightY - 1) - tDisplayValue;
+#if defined(SUPPORT_LOCAL_DISPLAY)
+            if (tFirstValue) {
+                LocalDisplay.drawPixel(tXpos, mPositionY - tDisplayValue, mDataColor);
+            } else {
+                LocalDisplay.drawLineFastOneX(tXpos - 1, mPositionY - tLastValue, mPositionY - tDisplayValue, mDataColor);
+            }
+#endif
+            tFirstValue = false;
+        } else if (aMode == CHART_MODE_AREA) {
             //since we draw a 1 pixel line for value 0
             tDisplayValue += 1;
             mDisplay->fillRectRel(tXpos, mPositionY - tDisplayValue, 1, tDisplayValue, mDataColor);
-        } else if (aMode == CHART_MODE_PIXEL || tFirstValue) { // even for line draw first value as pixel only
+        } else if (aMode == CHART_MODE_PIXEL || tFirstValue) {
+            // draw first value as pixel only
             tFirstValue = false;
             mDisplay->drawPixel(tXpos, mPositionY - tDisplayValue, mDataColor);
         } else if (aMode == CHART_MODE_LINE) {
@@ -599,14 +892,36 @@ bool Chart::drawChartDataFloat(const float *aDataPointer, const float *aDataEndP
         tLastValue = tDisplayValue;
         tXpos++;
     }
+    if (aMode == CHART_MODE_ENVELOPE) {
+        tRetValue &= addToEnvelope(tHostByteBuffer, tXpos - mPositionX);
+    } else if (tUseHostByteBuffer) {
+        sendHostByteBuffer(tHostByteBuffer, tXpos - mPositionX);
+    }
     return tRetValue;
 }
 
+/*
+ * Selects the loop for the current X scale factor
+ */
+template<typename T>
+bool Chart::drawChartDataGeneric(const T *aDataPointer, const T *aDataEndPointer, const uint8_t aMode) {
+    if (mXScaleFactor == 0) {
+        return drawChartDataScaled<T, CHART_X_SCALE_IDENTITY>(aDataPointer, aDataEndPointer, aMode);
+    } else if (mXScaleFactor == -1) {
+        return drawChartDataScaled<T, CHART_X_SCALE_COMPRESS_1_5>(aDataPointer, aDataEndPointer, aMode);
+    } else if (mXScaleFactor < -1) {
+        return drawChartDataScaled<T, CHART_X_SCALE_COMPRESS>(aDataPointer, aDataEndPointer, aMode);
+    } else if (mXScaleFactor == 1) {
+        return drawChartDataScaled<T, CHART_X_SCALE_EXPAND_1_5>(aDataPointer, aDataEndPointer, aMode);
+    }
+    return drawChartDataScaled<T, CHART_X_SCALE_EXPAND>(aDataPointer, aDataEndPointer, aMode);
+}
+
 /**
- * Draws a chart  - Factor for uint16_t values to chart value (mYFactor) is used to compute display values
+ * Draws a chart  - Factor for input to chart value (mYFactor) is used to compute display values
  * @param aDataPointer pointer to input data array
  * @param aDataEndPointer pointer to first element after data
- * @param aMode CHART_MODE_PIXEL, CHART_MODE_LINE or CHART_MODE_AREA
+ * @param aMode CHART_MODE_PIXEL, CHART_MODE_LINE or CHART_MODE_AREA. Line mode data is sent to host as one byte buffer.
  * @return false if clipping occurs
  */
 bool Chart::drawChartData(const int16_t *aDataPointer, const uint16_t aDataLength, const uint8_t aMode) {
@@ -614,105 +929,690 @@ bool Chart::drawChartData(const int16_t *aDataPointer, const uint16_t aDataLengt
 }
 
 bool Chart::drawChartData(const int16_t *aDataPointer, const int16_t *aDataEndPointer, const uint8_t aMode) {
+    if ((mFlags & CHART_X_PEAK_DETECT) && mXScaleFactor < -1 && aMode != CHART_MODE_ENVELOPE) {
+        return drawChartDataMinMax(aDataPointer, aDataEndPointer);
+    }
+    if ((mFlags & CHART_X_LTTB) && mXScaleFactor < -1) {
+        return drawChartDataLTTB(aDataPointer, aDataEndPointer, aMode);
+    }
+    return drawChartDataGeneric(aDataPointer, aDataEndPointer, aMode);
+}
+
+/*
+ * Reduces -mXScaleFactor values to one column by LTTB and draws the columns without X scaling.
+ * LTTB requires at least 3 columns, for the first value, the last value and one bucket.
+ * Otherwise, or if the input is too short for 3 columns, the columns are the average of their values.
+ * @return false if clipping occurs or LTTB cannot be initialized
+ */
+bool Chart::drawChartDataLTTB(const int16_t *aDataPointer, const int16_t *aDataEndPointer, const uint8_t aMode) {
+    uint16_t tNumberOfValuesPerColumn = -mXScaleFactor;
+    uint32_t tNumberOfColumns = (aDataEndPointer - aDataPointer) / tNumberOfValuesPerColumn;
+    if (tNumberOfColumns > mWidthX) {
+        tNumberOfColumns = mWidthX;
+    }
+    if (tNumberOfColumns > CHART_MAX_HOST_BYTE_BUFFER_SIZE) {
+        tNumberOfColumns = CHART_MAX_HOST_BYTE_BUFFER_SIZE;
+    }
+    if (tNumberOfColumns < 3) {
+        return drawChartDataGeneric(aDataPointer, aDataEndPointer, aMode);
+    }
+    uint32_t tNumberOfValues = tNumberOfColumns * tNumberOfValuesPerColumn;
+    if (ChartLTTB::getBucketBufferSize(tNumberOfValues, tNumberOfColumns) > CHART_LTTB_BUCKET_BUFFER_SIZE) {
+        // too few columns for the bucket buffer
+        return drawChartDataGeneric(aDataPointer, aDataEndPointer, aMode);
+    }
+
+    int16_t tColumnValues[CHART_MAX_HOST_BYTE_BUFFER_SIZE];
+    int16_t tBucketBuffer[CHART_LTTB_BUCKET_BUFFER_SIZE];
+    ChartLTTB tLTTB;
+    if (!tLTTB.init(tNumberOfValues, tNumberOfColumns, tColumnValues, tBucketBuffer)) {
+        return false;
+    }
+    tLTTB.addValues(aDataPointer, tNumberOfValues);
+    return drawChartDataScaled<int16_t, CHART_X_SCALE_IDENTITY>(tColumnValues,
+            tColumnValues + tLTTB.getNumberOfOutputValues(), aMode);
+}
+
+bool Chart::drawChartData(const int8_t *aDataPointer, const int8_t *aDataEndPointer, const uint8_t aMode) {
+    return drawChartDataGeneric(aDataPointer, aDataEndPointer, aMode);
+}
+
+bool Chart::drawChartData(const uint8_t *aDataPointer, const uint8_t *aDataEndPointer, const uint8_t aMode) {
+    return drawChartDataGeneric(aDataPointer, aDataEndPointer, aMode);
+}
+
+bool Chart::drawChartData(const uint16_t *aDataPointer, const uint16_t *aDataEndPointer, const uint8_t aMode) {
+    return drawChartDataGeneric(aDataPointer, aDataEndPointer, aMode);
+}
+
+bool Chart::drawChartData(const int32_t *aDataPointer, const int32_t *aDataEndPointer, const uint8_t aMode) {
+    return drawChartDataGeneric(aDataPointer, aDataEndPointer, aMode);
+}
+
+bool Chart::drawChartData(const float *aDataPointer, const float *aDataEndPointer, const uint8_t aMode) {
+    return drawChartDataGeneric(aDataPointer, aDataEndPointer, aMode);
+}
+
+bool Chart::drawChartDataFloat(const float *aDataPointer, const float *aDataEndPointer, const uint8_t aMode) {
+    return drawChartDataGeneric(aDataPointer, aDataEndPointer, aMode);
+}
+
+/*
+ * Minimum and maximum of aNumberOfValues values. Unrolled and with conditional moves instead of branches,
+ * since it is called for each column with 10 to 100 values.
+ */
+static inline void getMinMax(const int16_t *aDataPointer, uint16_t aNumberOfValues, int *aMin, int *aMax) {
+    int tMin = *aDataPointer;
+    int tMax = tMin;
+    while (aNumberOfValues >= 4) {
+        int tValue0 = aDataPointer[0];
+        int tValue1 = aDataPointer[1];
+        int tValue2 = aDataPointer[2];
+        int tValue3 = aDataPointer[3];
+        int tMin01 = (tValue0 < tValue1) ? tValue0 : tValue1;
+        int tMax01 = (tValue0 < tValue1) ? tValue1 : tValue0;
+        int tMin23 = (tValue2 < tValue3) ? tValue2 : tValue3;
+        int tMax23 = (tValue2 < tValue3) ? tValue3 : tValue2;
+        tMin01 = (tMin01 < tMin23) ? tMin01 : tMin23;
+        tMax01 = (tMax01 > tMax23) ? tMax01 : tMax23;
+        tMin = (tMin < tMin01) ? tMin : tMin01;
+        tMax = (tMax > tMax01) ? tMax : tMax01;
+        aDataPointer += 4;
+        aNumberOfValues -= 4;
+    }
+    while (aNumberOfValues > 0) {
+        int tValue = *aDataPointer++;
+        tMin = (tMin < tValue) ? tMin : tValue;
+        tMax = (tMax > tValue) ? tMax : tValue;
+        aNumberOfValues--;
+    }
+    *aMin = tMin;
+    *aMax = tMax;
+}
+
+/**
+ * Peak detect X compression. Draws a vertical line from minimum to maximum of the -mXScaleFactor values of each column.
+ * The last value of the previous column is included, so the lines of adjacent columns are connected.
+ * @return false if clipping occurs
+ */
+bool Chart::drawChartDataMinMax(const int16_t *aDataPointer, const int16_t *aDataEndPointer) {
 
     bool tRetValue = true;
-    int tDisplayValue;
 
-// used only in line mode
-    int tLastValue = 0;
+    uint16_t tNumberOfValuesPerColumn = -mXScaleFactor;
+    bool tUseHostByteBuffer = isHostByteBufferUsable();
+    uint8_t tHostMinMaxBuffer[2 * CHART_MAX_HOST_BYTE_BUFFER_SIZE];
+
+    uint16_t tColumn = 0;
+    int tLastValue = *aDataPointer;
+    while (tColumn < mWidthX && aDataPointer + tNumberOfValuesPerColumn <= aDataEndPointer) {
+        int tMin, tMax;
+        getMinMax(aDataPointer, tNumberOfValuesPerColumn, &tMin, &tMax);
+        tMin = (tMin < tLastValue) ? tMin : tLastValue;
+        tMax = (tMax > tLastValue) ? tMax : tLastValue;
+        aDataPointer += tNumberOfValuesPerColumn;
+        tLastValue = aDataPointer[-1];
+
+        int tMinDisplayValue = getYDisplayValue(tMin);
+        int tMaxDisplayValue = getYDisplayValue(tMax);
+        // clip to bottom line and to top value
+        if (tMinDisplayValue < 0) {
+            tMinDisplayValue = 0;
+            tRetValue = false;
+        }
+        if (tMaxDisplayValue > mHeightY - 1) {
+            tMaxDisplayValue = mHeightY - 1;
+            tRetValue = false;
+        }
+        if (tMaxDisplayValue < 0) {
+            tMaxDisplayValue = 0;
+        }
+        if (tMinDisplayValue > mHeightY - 1) {
+            tMinDisplayValue = mHeightY - 1;
+        }
 
-    // Factor for Input -> Display value
-    float tYDisplayFactor = 1;
-    int tYOffset = 0;
+        if (tUseHostByteBuffer) {
+            // values are relative to top of chart
+            tHostMinMaxBuffer[2 * tColumn] = (mHeightY - 1) - tMaxDisplayValue;
+            tHostMinMaxBuffer[(2 * tColumn) + 1] = (mHeightY - 1) - tMinDisplayValue;
+#if defined(SUPPORT_LOCAL_DISPLAY)
+            LocalDisplay.fillRect(mPositionX + tColumn, mPositionY - tMaxDisplayValue, mPositionX + tColumn,
+                    mPositionY - tMinDisplayValue, mDataColor);
+#endif
+        } else {
+            mDisplay->fillRectRel(mPositionX + tColumn, mPositionY - tMaxDisplayValue, 1, (tMaxDisplayValue - tMinDisplayValue) + 1,
+                    mDataColor);
+        }
+        tColumn++;
+    }
+
+    if (tUseHostByteBuffer && tColumn > 0) {
+        color16_t tClearBeforeColor = selectHostDataLayer(mFlags & CHART_CLEAR_DATA_BEFORE_DRAW);
+        mDisplay->drawChartMinMaxByteBuffer(mPositionX, mPositionY - (mHeightY - 1), mDataColor, tClearBeforeColor,
+                mHostChartIndex, tHostMinMaxBuffer, tColumn);
+        deselectHostDataLayer();
+    }
+    return tRetValue;
+}
 
+/*
+ * Computes the fixed point factor and offset for integer input -> display value.
+ * Must be called after each change of Y label values, Y data factor, Y grid spacing or trace Y scale.
+ * The factor includes the YScale of the trace currently drawn.
+ */
+void Chart::updateYDisplayFactor(void) {
     if (mFlags & CHART_Y_LABEL_INT) {
         // mGridYSpacing / mYLabelIncrementValue.IntValue is factor input -> pixel e.g. 40 pixel for 200 value
-        tYDisplayFactor = (mYDataFactor * mGridYSpacing) / mYLabelIncrementValue.IntValue;
-        tYOffset = mYLabelStartValue.IntValue / mYDataFactor;
+        mYDisplayFactor = (mYDataFactor * mGridYSpacing * mYDisplayScale) / mYLabelIncrementValue.IntValue;
+        mYInputOffsetFloat = mYLabelStartValue.IntValue / mYDataFactor;
     } else {
-        // Label is float
-        tYDisplayFactor = (mYDataFactor * mGridYSpacing) / mYLabelIncrementValue.FloatValue;
-        tYOffset = mYLabelStartValue.FloatValue / mYDataFactor;
+        mYDisplayFactor = (mYDataFactor * mGridYSpacing * mYDisplayScale) / mYLabelIncrementValue.FloatValue;
+        mYInputOffsetFloat = mYLabelStartValue.FloatValue / mYDataFactor;
     }
+    mYInputOffset = mYInputOffsetFloat;
 
-    uint16_t tXpos = mPositionX;
-    bool tFirstValue = true;
+    float tYDisplayFactor = mYDisplayFactor;
 
-    int tXScaleCounter = mXScaleFactor;
-    if (mXScaleFactor < -1) {
-        tXScaleCounter = -mXScaleFactor;
+    if (!(tYDisplayFactor > 0)) {
+        // also catches NaN of uninitialized or zero values
+        mYFactorMantissa = 0;
+        mYFactorShift = 0;
+        return;
+    }
+    if (tYDisplayFactor >= 2 * CHART_Y_FACTOR_MANTISSA_MIN) {
+        tYDisplayFactor = 2 * CHART_Y_FACTOR_MANTISSA_MIN - 1;
+    }
+    // Multiplying by 2 is exact, so the mantissa holds the complete float mantissa
+    uint8_t tShift = 0;
+    while (tYDisplayFactor < CHART_Y_FACTOR_MANTISSA_MIN && tShift < CHART_Y_FACTOR_MAX_SHIFT) {
+        tYDisplayFactor *= 2;
+        tShift++;
     }
+    mYFactorMantissa = tYDisplayFactor;
+    mYFactorShift = tShift;
+}
 
-    for (int i = mWidthX; i > 0; i--) {
+/**
+ * Multi trace: up to CHART_MAX_NUMBER_OF_TRACES traces with own color, scale and offset share the axes of the chart.
+ * Trace aTraceIndex is drawn with host chart index (host chart index of the chart + aTraceIndex), so the host can clear
+ * and redraw each trace without redrawing the axes. Local displays do not clear the last trace.
+ * @param aYScale additional factor to the Y factor of the chart
+ * @param aYDisplayOffset offset in pixel, e.g. to stack traces
+ * @param aClearBeforeColor color to clear the last data of the trace, 0 -> no clearing
+ * @return false if aTraceIndex is too big
+ */
+bool Chart::initTrace(uint8_t aTraceIndex, color16_t aColor, float aYScale, int16_t aYDisplayOffset, color16_t aClearBeforeColor) {
+    if (aTraceIndex >= CHART_MAX_NUMBER_OF_TRACES) {
+        return false;
+    }
+    ChartTrace *tTrace = &mTraces[aTraceIndex];
+    tTrace->DataPointer = NULL;
+    tTrace->Color = aColor;
+    tTrace->ClearBeforeColor = aClearBeforeColor;
+    tTrace->YScale = aYScale;
+    tTrace->YDisplayOffset = aYDisplayOffset;
+    tTrace->HasChanged = false;
+    return true;
+}
+
+/*
+ * Marks trace as changed. Call it also if only the content of the data buffer has changed.
+ */
+void Chart::setTraceData(uint8_t aTraceIndex, const int16_t *aDataPointer, uint16_t aDataLength) {
+    if (aTraceIndex < CHART_MAX_NUMBER_OF_TRACES) {
+        mTraces[aTraceIndex].DataPointer = aDataPointer;
+        mTraces[aTraceIndex].DataLength = aDataLength;
+        mTraces[aTraceIndex].HasChanged = true;
+    }
+}
+
+/*
+ * Draws trace in line mode with its own parameters, by temporarily replacing the chart parameters
+ */
+bool Chart::drawTrace(uint8_t aTraceIndex) {
+    ChartTrace *tTrace = &mTraces[aTraceIndex];
+
+    uint16_t tDataColor = mDataColor;
+    uint16_t tChartBackgroundColor = mChartBackgroundColor;
+    uint8_t tHostChartIndex = mHostChartIndex;
+    uint8_t tFlags = mFlags;
+
+    mDataColor = tTrace->Color;
+    mHostChartIndex = (tHostChartIndex + aTraceIndex) & 0x0F;
+    // the data layer is cleared once for all traces by drawChangedTraces()
+    if (tTrace->ClearBeforeColor != 0 && mDataLayer == LAYER_BACKGROUND) {
+        mChartBackgroundColor = tTrace->ClearBeforeColor;
+        mFlags |= CHART_CLEAR_DATA_BEFORE_DRAW;
+    } else {
+        mFlags &= ~CHART_CLEAR_DATA_BEFORE_DRAW;
+    }
+    mYDisplayScale = tTrace->YScale;
+    mYDisplayOffset = tTrace->YDisplayOffset;
+    updateYDisplayFactor();
+
+    bool tRetValue = drawChartData(tTrace->DataPointer, tTrace->DataPointer + tTrace->DataLength, CHART_MODE_LINE);
+
+    mDataColor = tDataColor;
+    mChartBackgroundColor = tChartBackgroundColor;
+    mHostChartIndex = tHostChartIndex;
+    mFlags = tFlags;
+    mYDisplayScale = 1.0;
+    mYDisplayOffset = 0;
+    updateYDisplayFactor();
+    return tRetValue;
+}
+
+/**
+ * Draws all traces changed by setTraceData() since last call.
+ * Call it between beginFrame() and endFrame() to render all traces at once.
+ * @return false if clipping occurs
+ */
+bool Chart::drawChangedTraces(void) {
+    bool tRetValue = true;
+    if (mDataLayer != LAYER_BACKGROUND && isHostByteBufferUsable()) {
         /*
-         *  get data and perform X scaling
+         * Clearing the data layer erases all traces, so all traces are drawn again after one clear
          */
-        if (mXScaleFactor == 0) {
-            tDisplayValue = *aDataPointer++;
-        } else if (mXScaleFactor == -1) {
-            // compress by factor 1.5 - every second value is the average of the next two values
-            tDisplayValue = *aDataPointer++;
-            tXScaleCounter--; // starts with 1
-            if (tXScaleCounter < 0) {
-                // get average of actual and next value
-                tDisplayValue += *aDataPointer++;
-                tDisplayValue /= 2;
-                tXScaleCounter = 1;
+        bool tTraceHasChanged = false;
+        for (uint8_t i = 0; i < CHART_MAX_NUMBER_OF_TRACES; ++i) {
+            if (mTraces[i].HasChanged && mTraces[i].DataPointer != NULL) {
+                tTraceHasChanged = true;
             }
-        } else if (mXScaleFactor <= -1) {
-            // compress - get average of multiple values
-            tDisplayValue = 0;
-            for (int j = 0; j < tXScaleCounter; ++j) {
-                tDisplayValue += *aDataPointer++;
+        }
+        if (!tTraceHasChanged) {
+            return true;
+        }
+        mDisplay->clearLayer(mDataLayer);
+        for (uint8_t i = 0; i < CHART_MAX_NUMBER_OF_TRACES; ++i) {
+            mTraces[i].HasChanged = true;
+        }
+    }
+    for (uint8_t i = 0; i < CHART_MAX_NUMBER_OF_TRACES; ++i) {
+        if (mTraces[i].HasChanged && mTraces[i].DataPointer != NULL) {
+            if (!drawTrace(i)) {
+                tRetValue = false;
             }
-            tDisplayValue /= tXScaleCounter;
-        } else if (mXScaleFactor == 1) {
-            // expand by factor 1.5 - every second value will be shown 2 times
-            tDisplayValue = *aDataPointer++;
-            tXScaleCounter--; // starts with 1
-            if (tXScaleCounter < 0) {
-                aDataPointer--;
-                tXScaleCounter = 2;
+            mTraces[i].HasChanged = false;
+        }
+    }
+    return tRetValue;
+}
+
+/**
+ * Roll mode: new values are appended at the right and the trace moves to the left like on a strip chart recorder.
+ * Each value occupies one column, X scale factor is not applied.
+ * For the host, the trace is scrolled and only the new columns are sent.
+ * Use setDataLayer() to keep the grid, otherwise the grid is scrolled too.
+ * @param aDisplayValueBuffer buffer of mWidthX bytes, which holds the visible trace
+ * @return false if chart is too high for byte display values
+ */
+bool Chart::initRollMode(uint8_t *aDisplayValueBuffer) {
+    if (mHeightY > 0x100) {
+        mRollBuffer = NULL;
+        return false;
+    }
+    mRollBuffer = aDisplayValueBuffer;
+    mRollStartIndex = 0;
+    mRollNumberOfValues = 0;
+    return true;
+}
+
+/**
+ * X-Y chart, e.g. for Lissajous figures or hysteresis. Draws a point for each pair of X and Y value.
+ * X values are converted by the X data factor, X label start and increment and the X grid spacing,
+ * like Y values are converted by the Y settings. X scale factor is applied to the X label increment only.
+ * Points are sent to host as pairs of byte values, which requires a chart of at most 256 x 256 pixel.
+ * @return false if clipping occurs or if X label increment is 0
+ */
+bool Chart::drawChartDataXY(const int16_t *aXDataPointer, const int16_t *aYDataPointer, uint16_t aNumberOfPoints) {
+    return drawChartDataXYGeneric(aXDataPointer, aYDataPointer, aNumberOfPoints);
+}
+
+bool Chart::drawChartDataXY(const float *aXDataPointer, const float *aYDataPointer, uint16_t aNumberOfPoints) {
+    return drawChartDataXYGeneric(aXDataPointer, aYDataPointer, aNumberOfPoints);
+}
+
+template<typename T>
+bool Chart::drawChartDataXYGeneric(const T *aXDataPointer, const T *aYDataPointer, uint16_t aNumberOfPoints) {
+    typedef typename ChartSampleTraits<T>::ValueType ValueType;
+
+    // X factor and offset are computed for each call, since they are not used for other charts
+    float tXIncrementValue;
+    float tXLabelStartValue;
+    if (mFlags & CHART_X_LABEL_INT) {
+        tXIncrementValue = adjustIntWithXScaleFactor(mXLabelBaseIncrementValue.IntValue);
+        tXLabelStartValue = mXLabelStartValue.IntValue;
+    } else {
+        tXIncrementValue = adjustFloatWithXScaleFactor(mXLabelBaseIncrementValue.FloatValue);
+        tXLabelStartValue = mXLabelStartValue.FloatValue;
+    }
+    if (tXIncrementValue == 0) {
+        return false;
+    }
+    float tXDisplayFactor = (mXDataFactor * mGridXSpacing) / tXIncrementValue;
+    float tXInputOffset = tXLabelStartValue / mXDataFactor;
+
+    bool tRetValue = true;
+    bool tUseHostByteBuffer = isHostByteBufferUsable() && mWidthX <= 0x100;
+    uint8_t tHostXYBuffer[2 * CHART_MAX_HOST_XY_POINTS];
+    uint16_t tBufferIndex = 0;
+    bool tDoClearData = mFlags & CHART_CLEAR_DATA_BEFORE_DRAW;
+
+    while (aNumberOfPoints > 0) {
+        int tXDisplayValue = (int) (tXDisplayFactor * (*aXDataPointer++ - tXInputOffset));
+        int tYDisplayValue = getYDisplayValue((ValueType) *aYDataPointer++);
+        aNumberOfPoints--;
+        // clip to chart area
+        if (tXDisplayValue < 0) {
+            tXDisplayValue = 0;
+            tRetValue = false;
+        }
+        if (tXDisplayValue > mWidthX - 1) {
+            tXDisplayValue = mWidthX - 1;
+            tRetValue = false;
+        }
+        if (tYDisplayValue < 0) {
+            tYDisplayValue = 0;
+            tRetValue = false;
+        }
+        if (tYDisplayValue > mHeightY - 1) {
+            tYDisplayValue = mHeightY - 1;
+            tRetValue = false;
+        }
+
+        if (tUseHostByteBuffer) {
+            // values are relative to top left of chart
+            tHostXYBuffer[tBufferIndex++] = tXDisplayValue;
+            tHostXYBuffer[tBufferIndex++] = (mHeightY - 1) - tYDisplayValue;
+#if defined(SUPPORT_LOCAL_DISPLAY)
+            LocalDisplay.drawPixel(mPositionX + tXDisplayValue, mPositionY - tYDisplayValue, mDataColor);
+#endif
+            if (tBufferIndex == sizeof(tHostXYBuffer) || aNumberOfPoints == 0) {
+                color16_t tClearBeforeColor = selectHostDataLayer(tDoClearData);
+                mDisplay->drawChartXYByteBuffer(mPositionX, mPositionY - (mHeightY - 1), mDataColor, tClearBeforeColor,
+                        mHostChartIndex, tHostXYBuffer, tBufferIndex / 2);
+                deselectHostDataLayer();
+                // only the first chunk clears, the host adds the following chunks to the data to clear next time
+                tDoClearData = false;
+                tBufferIndex = 0;
             }
         } else {
-            // expand - show value several times
-            tDisplayValue = *aDataPointer;
-            tXScaleCounter--;
-            if (tXScaleCounter == 0) {
-                aDataPointer++;
-                tXScaleCounter = mXScaleFactor;
+            mDisplay->drawPixel(mPositionX + tXDisplayValue, mPositionY - tYDisplayValue, mDataColor);
+        }
+    }
+    return tRetValue;
+}
+
+/**
+ * Envelope mode: drawChartData() with CHART_MODE_ENVELOPE merges the trace into a minimum and maximum per column,
+ * like the persistence of an analog scope. Only columns whose envelope changed are drawn.
+ * Decay moves minimum and maximum towards each new trace, so that old traces fade out.
+ * The host draws the envelope with the min max chart function, so do not use the host chart index for other data.
+ * @param aEnvelopeBuffer buffer of 2 * mWidthX bytes
+ * @param aDecayPixelPerTrace 0 -> envelope only grows until clearEnvelope() is called
+ * @return false if chart is too high for byte display values or too wide for the column buffer
+ */
+bool Chart::initEnvelope(uint8_t *aEnvelopeBuffer, uint8_t aDecayPixelPerTrace) {
+    if (mHeightY > 0x100 || mWidthX > CHART_MAX_HOST_BYTE_BUFFER_SIZE) {
+        mEnvelopeBuffer = NULL;
+        return false;
+    }
+    mEnvelopeBuffer = aEnvelopeBuffer;
+    mEnvelopeDecay = aDecayPixelPerTrace;
+    clearEnvelope();
+    return true;
+}
+
+/**
+ * Empties the envelope. Does not clear the chart area.
+ */
+void Chart::clearEnvelope(void) {
+    if (mEnvelopeBuffer == NULL) {
+        return;
+    }
+    for (uint16_t i = 0; i < mWidthX; ++i) {
+        // minimum > maximum marks an empty column
+        mEnvelopeBuffer[2 * i] = 0xFF;
+        mEnvelopeBuffer[(2 * i) + 1] = 0;
+    }
+}
+
+/*
+ * @param aEnvelope minimum and maximum of one column, minimum > maximum for an empty column
+ */
+static void getNextEnvelope(const uint8_t *aEnvelope, int aValue, uint8_t aDecay, int *aMin, int *aMax) {
+    int tMin = aValue;
+    int tMax = aValue;
+    if (aEnvelope[0] <= aEnvelope[1]) {
+        // decay towards the new value, but not beyond it
+        tMin = aEnvelope[0] + aDecay;
+        if (tMin > aValue) {
+            tMin = aValue;
+        }
+        tMax = aEnvelope[1] - aDecay;
+        if (tMax < aValue) {
+            tMax = aValue;
+        }
+    }
+    *aMin = tMin;
+    *aMax = tMax;
+}
+
+/*
+ * Draws one vertical line for each column
+ * @param aMinMaxBuffer pairs of top and bottom Y value relative to top of chart, as required by drawChartMinMaxByteBuffer()
+ */
+void Chart::drawEnvelopeColumns(uint8_t *aMinMaxBuffer, uint16_t aFirstColumn, uint16_t aLastColumn, uint16_t aColor,
+        bool aUseHostByteBuffer) {
+    uint16_t tChartTop = mPositionY - (mHeightY - 1);
+    if (aUseHostByteBuffer) {
+        mDisplay->drawChartMinMaxByteBuffer(mPositionX + aFirstColumn, tChartTop, aColor, 0, mHostChartIndex,
+                &aMinMaxBuffer[2 * aFirstColumn], (aLastColumn - aFirstColumn) + 1);
+    }
+    for (uint16_t tColumn = aFirstColumn; tColumn <= aLastColumn; ++tColumn) {
+        uint16_t tXpos = mPositionX + tColumn;
+        uint16_t tTop = tChartTop + aMinMaxBuffer[2 * tColumn];
+        uint16_t tBottom = tChartTop + aMinMaxBuffer[(2 * tColumn) + 1];
+        if (aUseHostByteBuffer) {
+#if defined(SUPPORT_LOCAL_DISPLAY)
+            LocalDisplay.fillRect(tXpos, tTop, tXpos, tBottom, aColor);
+#endif
+        } else {
+            mDisplay->fillRect(tXpos, tTop, tXpos, tBottom, aColor);
+        }
+    }
+}
+
+/*
+ * Merges the display values of one trace into the envelope and draws the changed columns.
+ * If the envelope of a column shrinks by decay, the old envelope of the changed columns is erased before.
+ * The first pass builds the erase list from the envelope before the update, the second pass updates the envelope
+ * and builds the draw list in the same buffer, so only one column buffer is on the stack.
+ * @return false if envelope mode is not initialized
+ */
+bool Chart::addToEnvelope(const uint8_t *aDisplayValues, uint16_t aNumberOfColumns) {
+    if (mEnvelopeBuffer == NULL) {
+        return false;
+    }
+    uint8_t tMinMax[2 * CHART_MAX_HOST_BYTE_BUFFER_SIZE];
+    int tFirstChangedColumn = -1;
+    uint16_t tLastChangedColumn = 0;
+    bool tHasShrunk = false;
+
+    for (uint16_t tColumn = 0; tColumn < aNumberOfColumns; ++tColumn) {
+        uint8_t *tEnvelope = &mEnvelopeBuffer[2 * tColumn];
+        int tMin;
+        int tMax;
+        getNextEnvelope(tEnvelope, aDisplayValues[tColumn], mEnvelopeDecay, &tMin, &tMax);
+        int tOldMin = tEnvelope[0];
+        int tOldMax = tEnvelope[1];
+        if (tOldMin > tOldMax) {
+            // empty column, nothing to erase
+            tOldMin = tMin;
+            tOldMax = tMax;
+        } else if (tMin > tOldMin || tMax < tOldMax) {
+            tHasShrunk = true;
+        }
+        tMinMax[2 * tColumn] = (mHeightY - 1) - tOldMax;
+        tMinMax[(2 * tColumn) + 1] = (mHeightY - 1) - tOldMin;
+        if (tMin != tEnvelope[0] || tMax != tEnvelope[1]) {
+            if (tFirstChangedColumn < 0) {
+                tFirstChangedColumn = tColumn;
             }
+            tLastChangedColumn = tColumn;
         }
-        // check for data pointer still in data buffer
-        if (aDataPointer >= aDataEndPointer) {
-            break;
+    }
+    if (tFirstChangedColumn < 0) {
+        return true;
+    }
+
+    bool tUseHostByteBuffer = isHostByteBufferUsable();
+    if (tHasShrunk) {
+        drawEnvelopeColumns(tMinMax, tFirstChangedColumn, tLastChangedColumn, mChartBackgroundColor, tUseHostByteBuffer);
+    }
+    for (uint16_t tColumn = tFirstChangedColumn; tColumn <= tLastChangedColumn; ++tColumn) {
+        uint8_t *tEnvelope = &mEnvelopeBuffer[2 * tColumn];
+        int tMin;
+        int tMax;
+        getNextEnvelope(tEnvelope, aDisplayValues[tColumn], mEnvelopeDecay, &tMin, &tMax);
+        tEnvelope[0] = tMin;
+        tEnvelope[1] = tMax;
+        tMinMax[2 * tColumn] = (mHeightY - 1) - tMax;
+        tMinMax[(2 * tColumn) + 1] = (mHeightY - 1) - tMin;
+    }
+    drawEnvelopeColumns(tMinMax, tFirstChangedColumn, tLastChangedColumn, mDataColor, tUseHostByteBuffer);
+    return true;
+}
+
+/*
+ * Draws the trace of the roll buffer with aColor. Used to erase and redraw the trace on displays which can not scroll.
+ * Column 0 is right of the Y axis.
+ */
+void Chart::drawRollBuffer(uint16_t aColor, bool aLocalDisplayOnly) {
+#if !defined(SUPPORT_LOCAL_DISPLAY)
+    if (aLocalDisplayOnly) {
+        return;
+    }
+#endif
+    uint16_t tIndex = mRollStartIndex;
+    int tLastValue = 0;
+    for (uint16_t tColumn = 0; tColumn < mRollNumberOfValues; ++tColumn) {
+        int tValue = mRollBuffer[tIndex];
+        uint16_t tXpos = mPositionX + 1 + tColumn;
+        if (aLocalDisplayOnly) {
+#if defined(SUPPORT_LOCAL_DISPLAY)
+            if (tColumn == 0) {
+                LocalDisplay.drawPixel(tXpos, mPositionY - tValue, aColor);
+            } else {
+                LocalDisplay.drawLineFastOneX(tXpos - 1, mPositionY - tLastValue, mPositionY - tValue, aColor);
+            }
+#endif
+        } else if (tColumn == 0) {
+            mDisplay->drawPixel(tXpos, mPositionY - tValue, aColor);
+        } else {
+            mDisplay->drawLineFastOneX(tXpos - 1, mPositionY - tLastValue, mPositionY - tValue, aColor);
+        }
+        tLastValue = tValue;
+        tIndex++;
+        if (tIndex >= mWidthX) {
+            tIndex = 0;
         }
+    }
+}
 
-        tDisplayValue = tYDisplayFactor * (tDisplayValue - tYOffset);
-        // clip to bottom line
-        if (tDisplayValue < 0) {
-            tDisplayValue = 0;
+/**
+ * Appends values to the roll mode trace. If the trace is full, it moves left by the number of new values.
+ * The host scrolls the chart area and gets only the new columns, other displays erase and redraw the whole trace.
+ * Values are clipped above the X axis, so that scrolling does not touch the axes.
+ * @return false if clipping occurs or roll mode is not initialized
+ */
+bool Chart::appendChartData(const int16_t *aDataPointer, uint16_t aNumberOfValues) {
+    if (mRollBuffer == NULL) {
+        return false;
+    }
+    if (aNumberOfValues > mWidthX) {
+        // only the last mWidthX values are visible
+        aDataPointer += aNumberOfValues - mWidthX;
+        aNumberOfValues = mWidthX;
+    }
+
+    bool tRetValue = true;
+    bool tUseHostByteBuffer = isHostByteBufferUsable();
+    // erase old trace
+    drawRollBuffer(mChartBackgroundColor, tUseHostByteBuffer);
+
+    /*
+     * Append to ring buffer
+     */
+    uint16_t tOldNumberOfValues = mRollNumberOfValues;
+    uint16_t tWriteIndex = mRollStartIndex + mRollNumberOfValues;
+    if (tWriteIndex >= mWidthX) {
+        tWriteIndex -= mWidthX;
+    }
+    for (uint16_t i = aNumberOfValues; i > 0; i--) {
+        int tDisplayValue = getYDisplayValue(*aDataPointer++);
+        if (tDisplayValue < 1) {
+            tDisplayValue = 1;
             tRetValue = false;
         }
-        // clip to top value
         if (tDisplayValue > mHeightY - 1) {
             tDisplayValue = mHeightY - 1;
             tRetValue = false;
         }
-        // draw first value as pixel only
-        if (aMode == CHART_MODE_PIXEL || tFirstValue) {
-            tFirstValue = false;
-            mDisplay->drawPixel(tXpos, mPositionY - tDisplayValue, mDataColor);
-        } else if (aMode == CHART_MODE_LINE) {
-            mDisplay->drawLineFastOneX(tXpos - 1, mPositionY - tLastValue, mPositionY - tDisplayValue, mDataColor);
-        } else if (aMode == CHART_MODE_AREA) {
-            //since we draw a 1 pixel line for value 0
-            tDisplayValue += 1;
-            mDisplay->fillRectRel(tXpos, mPositionY - tDisplayValue, 1, tDisplayValue, mDataColor);
+        mRollBuffer[tWriteIndex++] = tDisplayValue;
+        if (tWriteIndex >= mWidthX) {
+            tWriteIndex = 0;
+        }
+        if (mRollNumberOfValues < mWidthX) {
+            mRollNumberOfValues++;
+        } else {
+            // overwrite oldest value
+            mRollStartIndex++;
+            if (mRollStartIndex >= mWidthX) {
+                mRollStartIndex = 0;
+            }
         }
-        tLastValue = tDisplayValue;
-        tXpos++;
     }
+
+    if (!tUseHostByteBuffer) {
+        drawRollBuffer(mDataColor, false);
+        return tRetValue;
+    }
+    drawRollBuffer(mDataColor, true);
+
+    selectHostDataLayer(false);
+    uint16_t tScrollPixel = (tOldNumberOfValues + aNumberOfValues) - mRollNumberOfValues;
+    if (tScrollPixel > 0) {
+        mDisplay->scrollRectLeft(mPositionX + 1, mPositionY - (mHeightY - 1), mWidthX, mHeightY - 1, tScrollPixel,
+                mChartBackgroundColor);
+    }
+
+    /*
+     * Send the new columns, starting with the last old one to connect the lines
+     */
+    uint16_t tFirstColumn = mRollNumberOfValues - aNumberOfValues;
+    if (tFirstColumn > 0) {
+        tFirstColumn--;
+    }
+    uint8_t tHostByteBuffer[CHART_MAX_HOST_BYTE_BUFFER_SIZE];
+    uint16_t tIndex = mRollStartIndex + tFirstColumn;
+    if (tIndex >= mWidthX) {
+        tIndex -= mWidthX;
+    }
+    uint16_t tLength = mRollNumberOfValues - tFirstColumn;
+    for (uint16_t i = 0; i < tLength; ++i) {
+        // values are relative to top of chart
+        tHostByteBuffer[i] = (mHeightY - 1) - mRollBuffer[tIndex++];
+        if (tIndex >= mWidthX) {
+            tIndex = 0;
+        }
+    }
+    if (tLength >= 2) {
+        // no clear before, old columns were scrolled
+        mDisplay->drawChartByteBuffer(mPositionX + 1 + tFirstColumn, mPositionY - (mHeightY - 1), mDataColor, 0,
+                mHostChartIndex, true, tHostByteBuffer, tLength);
+    }
+    deselectHostDataLayer();
     return tRetValue;
 }
 
@@ -785,26 +1685,33 @@ uint16_t Chart::getWidthX(void) const {
 
 void Chart::setHeightY(uint16_t heightY) {
     mHeightY = heightY;
+    invalidateLabelCache();
 }
 
 void Chart::setPositionX(uint16_t positionX) {
     mPositionX = positionX;
+    invalidateLabelCache();
 }
 
 void Chart::setPositionY(uint16_t positionY) {
     mPositionY = positionY;
+    invalidateLabelCache();
 }
 
 void Chart::setWidthX(uint16_t widthX) {
     mWidthX = widthX;
+    invalidateLabelCache();
 }
 
 void Chart::setXGridSpacing(uint8_t aXGridSpacing) {
     mGridXSpacing = aXGridSpacing;
+    invalidateLabelCache();
 }
 
 void Chart::setYGridSpacing(uint8_t aYGridSpacing) {
     mGridYSpacing = aYGridSpacing;
+    updateYDisplayFactor();
+    invalidateLabelCache();
 }
 
 uint8_t Chart::getXGridSpacing(void) const {
@@ -839,14 +1746,24 @@ void Chart::setXLabelStartValueFloat(float xLabelStartValueFloat) {
 
 void Chart::setYLabelStartValue(int yLabelStartValue) {
     mYLabelStartValue.IntValue = yLabelStartValue;
+    updateYDisplayFactor();
 }
 
 void Chart::setYLabelStartValueFloat(float yLabelStartValueFloat) {
     mYLabelStartValue.FloatValue = yLabelStartValueFloat;
+    updateYDisplayFactor();
+}
+
+/**
+ * Factor for X input to chart value for drawChartDataXY(), like the Y factor of initYLabelInt()
+ */
+void Chart::setXDataFactor(float aXDataFactor) {
+    mXDataFactor = aXDataFactor;
 }
 
 void Chart::setYDataFactor(float aYDataFactor) {
     mYDataFactor = aYDataFactor;
+    updateYDisplayFactor();
 }
 
 /**
@@ -875,10 +1792,12 @@ void Chart::setXLabelBaseIncrementValueFloat(float xLabelBaseIncrementValueFloat
 
 void Chart::setYLabelBaseIncrementValue(int yLabelBaseIncrementValue) {
     mYLabelIncrementValue.IntValue = yLabelBaseIncrementValue;
+    updateYDisplayFactor();
 }
 
 void Chart::setYLabelBaseIncrementValueFloat(float yLabelBaseIncrementValueFloat) {
     mYLabelIncrementValue.FloatValue = yLabelBaseIncrementValueFloat;
+    updateYDisplayFactor();
 }
 
 int_float_union Chart::getXLabelStartValue(void) const {
@@ -945,7 +1864,12 @@ void getScaleFactorAsString(char *tStringBuffer, int aScaleFactor) {
         *tStringBuffer++ = '5';
         *tStringBuffer++ = '\0';
     } else {
-        snprintf(tStringBuffer, 5, "%-3d", adjustIntWithScaleFactor(1, aScaleFactor));
+        // left aligned like "%-3d"
+        uint8_t tLength = formatSignedDecimal(tStringBuffer, FORMAT_BUFFER_SIZE_FOR_LONG, adjustIntWithScaleFactor(1, aScaleFactor));
+        while (tLength < 3) {
+            tStringBuffer[tLength++] = ' ';
+        }
+        tStringBuffer[tLength] = '\0';
     }
 
 }
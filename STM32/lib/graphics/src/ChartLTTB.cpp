@@ -0,0 +1,178 @@
+/*
+ * ChartLTTB.cpp
+ * Largest triangle three buckets downsampling, see Sveinn Steinarsson, "Downsampling Time Series for Visual Representation".
+ *
+ * The first and the last input value are always output. The values between are divided into aNumberOfOutputValues - 2
+ * buckets, and from each bucket the value is selected, which forms the largest triangle with the value selected
+ * from the previous bucket and the average of the next bucket.
+ * Since the average of the next bucket is required, two buckets are stored and the output lags one bucket behind the input.
+ *
+ * @date 17.10.2026
+ * @author agent
+ * agent@local
+ * @copyright LGPL v3 (http://www.gnu.org/licenses/lgpl.html)
+ * @version 1.0.0
+ */
+
+#include "ChartLTTB.h"
+
+#include <stddef.h> // for NULL
+
+/** @addtogroup Graphic_Library
+ * @{
+ */
+/**
+ * @return number of int16_t values required for aBucketBuffer, 0 if values are only copied
+ */
+uint32_t ChartLTTB::getBucketBufferSize(uint32_t aNumberOfInputValues, uint16_t aNumberOfOutputValues) {
+    if (aNumberOfOutputValues < 3 || aNumberOfInputValues <= aNumberOfOutputValues) {
+        return 0;
+    }
+    uint32_t tNumberOfBuckets = aNumberOfOutputValues - 2;
+    return 2 * (((aNumberOfInputValues - 2) + tNumberOfBuckets - 1) / tNumberOfBuckets);
+}
+
+/**
+ * If there are not more input than output values, input values are just copied.
+ * If less than 3 output values are requested, the output is the first and the last input value.
+ * @param aOutputBuffer buffer for aNumberOfOutputValues values
+ * @param aBucketBuffer buffer for getBucketBufferSize() values, not used if getBucketBufferSize() returns 0
+ * @return false if buckets are bigger than CHART_LTTB_MAX_BUCKET_SIZE
+ */
+bool ChartLTTB::init(uint32_t aNumberOfInputValues, uint16_t aNumberOfOutputValues, int16_t *aOutputBuffer,
+        int16_t *aBucketBuffer) {
+    mNumberOfInputValues = aNumberOfInputValues;
+    mNumberOfOutputValues = aNumberOfOutputValues;
+    mOutputBuffer = aOutputBuffer;
+    mOutputIndex = 0;
+    mInputIndex = 0;
+    mSelectBucket = NULL;
+    mFillBucket = NULL;
+
+    uint32_t tBucketBufferSize = getBucketBufferSize(aNumberOfInputValues, aNumberOfOutputValues);
+    if (tBucketBufferSize == 0) {
+        return true;
+    }
+    if (tBucketBufferSize / 2 > CHART_LTTB_MAX_BUCKET_SIZE) {
+        return false;
+    }
+    mSelectBucket = aBucketBuffer;
+    mSelectBucketCount = 0;
+    mFillBucket = aBucketBuffer + (tBucketBufferSize / 2);
+    startBucket(0);
+    return true;
+}
+
+/*
+ * Bucket b contains the values with index 1 + ceil(b * M / B) to index ceil((b + 1) * M / B),
+ * with M as number of values between first and last and B as number of buckets.
+ */
+void ChartLTTB::startBucket(uint32_t aBucketIndex) {
+    uint64_t tNumberOfMiddleValues = mNumberOfInputValues - 2;
+    uint32_t tNumberOfBuckets = mNumberOfOutputValues - 2;
+    mFillBucketIndex = aBucketIndex;
+    mFillBucketStartX = 1 + ((aBucketIndex * tNumberOfMiddleValues) + tNumberOfBuckets - 1) / tNumberOfBuckets;
+    mFillBucketEndX = 1 + (((aBucketIndex + 1) * tNumberOfMiddleValues) + tNumberOfBuckets - 1) / tNumberOfBuckets;
+    mFillBucketCount = 0;
+    mFillBucketYSum = 0;
+}
+
+/*
+ * Selects the value of the select bucket, which forms the largest triangle with the last selected value
+ * and the average of the next bucket. The average is given as sums to avoid a division.
+ */
+void ChartLTTB::selectFromBucket(int64_t aNextXSum, int32_t aNextYSum, uint16_t aNextCount) {
+    int64_t tXA = mSelectedX;
+    int64_t tYA = mSelectedY;
+    // Vector from last selected point to average of next bucket, multiplied by aNextCount
+    int64_t tDeltaXAC = aNextXSum - (tXA * aNextCount);
+    int64_t tDeltaYAC = aNextYSum - (tYA * aNextCount);
+
+    uint64_t tMaxArea = 0;
+    uint16_t tMaxIndex = 0;
+    for (uint16_t i = 0; i < mSelectBucketCount; ++i) {
+        // double triangle area is the absolute value of the cross product
+        int64_t tArea = ((int64_t) (mSelectBucketStartX + i) - tXA) * tDeltaYAC - (mSelectBucket[i] - tYA) * tDeltaXAC;
+        if (tArea < 0) {
+            tArea = -tArea;
+        }
+        if ((uint64_t) tArea > tMaxArea) {
+            tMaxArea = tArea;
+            tMaxIndex = i;
+        }
+    }
+    mSelectedX = mSelectBucketStartX + tMaxIndex;
+    mSelectedY = mSelectBucket[tMaxIndex];
+    mOutputBuffer[mOutputIndex++] = mSelectedY;
+    mSelectBucketCount = 0;
+}
+
+/*
+ * Now the average of the fill bucket is known, so the point of the select bucket can be selected.
+ * Then the fill bucket becomes the select bucket.
+ */
+void ChartLTTB::completeFillBucket(void) {
+    if (mSelectBucketCount > 0) {
+        int64_t tFillBucketXSum = ((int64_t) mFillBucketStartX * mFillBucketCount)
+                + (((int64_t) mFillBucketCount * (mFillBucketCount - 1)) / 2);
+        selectFromBucket(tFillBucketXSum, mFillBucketYSum, mFillBucketCount);
+    }
+    int16_t *tBucket = mSelectBucket;
+    mSelectBucket = mFillBucket;
+    mFillBucket = tBucket;
+    mSelectBucketStartX = mFillBucketStartX;
+    mSelectBucketCount = mFillBucketCount;
+}
+
+void ChartLTTB::addValue(int16_t aValue) {
+    uint32_t tX = mInputIndex++;
+    if (tX >= mNumberOfInputValues) {
+        return;
+    }
+    if (mFillBucket == NULL) {
+        // no reduction required or no bucket between first and last value
+        if (mNumberOfInputValues <= mNumberOfOutputValues || tX == 0
+                || (tX == mNumberOfInputValues - 1 && mNumberOfOutputValues == 2)) {
+            if (mOutputIndex < mNumberOfOutputValues) {
+                mOutputBuffer[mOutputIndex++] = aValue;
+            }
+        }
+        return;
+    }
+
+    if (tX == 0) {
+        mSelectedX = 0;
+        mSelectedY = aValue;
+        mOutputBuffer[mOutputIndex++] = aValue;
+        return;
+    }
+
+    if (tX == mNumberOfInputValues - 1) {
+        // last value is the next "bucket" of the last bucket
+        completeFillBucket();
+        if (mSelectBucketCount > 0) {
+            selectFromBucket(tX, aValue, 1);
+        }
+        mOutputBuffer[mOutputIndex++] = aValue;
+        return;
+    }
+
+    if (tX >= mFillBucketEndX) {
+        completeFillBucket();
+        startBucket(mFillBucketIndex + 1);
+    }
+    mFillBucket[mFillBucketCount++] = aValue;
+    mFillBucketYSum += aValue;
+}
+
+/**
+ * Can be called several times with consecutive parts of the input.
+ * Values after aNumberOfInputValues given at init() are ignored.
+ */
+void ChartLTTB::addValues(const int16_t *aDataPointer, uint32_t aNumberOfValues) {
+    while (aNumberOfValues > 0) {
+        addValue(*aDataPointer++);
+        aNumberOfValues--;
+    }
+}
+/** @} */
@@ -0,0 +1,227 @@
+/*
+ * ChartSpectrum.cpp
+ * Radix-2 decimation in time FFT with Q15 values. Each stage scales by 1/2 to avoid overflow,
+ * so the result is the DFT divided by the FFT size and a full scale sine gives a bin of half scale.
+ * Only integer operations are used, twiddle factors and window are taken from one quarter wave sine table.
+ *
+ * @date 17.10.2026
+ * @author agent
+ * agent@local
+ * @copyright LGPL v3 (http://www.gnu.org/licenses/lgpl.html)
+ * @version 1.0.0
+ */
+
+#include "ChartSpectrum.h"
+
+/*
+ * 32767 * sin(2 * PI * i / CHART_SPECTRUM_SINE_TABLE_PERIOD) for the first quarter period including its end
+ */
+static const int16_t sQuarterSineTable[(CHART_SPECTRUM_SINE_TABLE_PERIOD / 4) + 1] = {
+        0, 101, 201, 302, 402, 503, 603, 704, 804, 905, 1005, 1106,
+        1206, 1307, 1407, 1507, 1608, 1708, 1809, 1909, 2009, 2110, 2210, 2310,
+        2410, 2511, 2611, 2711, 2811, 2911, 3012, 3112, 3212, 3312, 3412, 3512,
+        3612, 3712, 3811, 3911, 4011, 4111, 4210, 4310, 4410, 4509, 4609, 4708,
+        4808, 4907, 5007, 5106, 5205, 5305, 5404, 5503, 5602, 5701, 5800, 5899,
+        5998, 6096, 6195, 6294, 6393, 6491, 6590, 6688, 6786, 6885, 6983, 7081,
+        7179, 7277, 7375, 7473, 7571, 7669, 7767, 7864, 7962, 8059, 8157, 8254,
+        8351, 8448, 8545, 8642, 8739, 8836, 8933, 9030, 9126, 9223, 9319, 9416,
+        9512, 9608, 9704, 9800, 9896, 9992, 10087, 10183, 10278, 10374, 10469, 10564,
+        10659, 10754, 10849, 10944, 11039, 11133, 11228, 11322, 11417, 11511, 11605, 11699,
+        11793, 11886, 11980, 12074, 12167, 12260, 12353, 12446, 12539, 12632, 12725, 12817,
+        12910, 13002, 13094, 13187, 13279, 13370, 13462, 13554, 13645, 13736, 13828, 13919,
+        14010, 14101, 14191, 14282, 14372, 14462, 14553, 14643, 14732, 14822, 14912, 15001,
+        15090, 15180, 15269, 15358, 15446, 15535, 15623, 15712, 15800, 15888, 15976, 16063,
+        16151, 16238, 16325, 16413, 16499, 16586, 16673, 16759, 16846, 16932, 17018, 17104,
+        17189, 17275, 17360, 17445, 17530, 17615, 17700, 17784, 17869, 17953, 18037, 18121,
+        18204, 18288, 18371, 18454, 18537, 18620, 18703, 18785, 18868, 18950, 19032, 19113,
+        19195, 19276, 19357, 19438, 19519, 19600, 19680, 19761, 19841, 19921, 20000, 20080,
+        20159, 20238, 20317, 20396, 20475, 20553, 20631, 20709, 20787, 20865, 20942, 21019,
+        21096, 21173, 21250, 21326, 21403, 21479, 21554, 21630, 21705, 21781, 21856, 21930,
+        22005, 22079, 22154, 22227, 22301, 22375, 22448, 22521, 22594, 22667, 22739, 22812,
+        22884, 22956, 23027, 23099, 23170, 23241, 23311, 23382, 23452, 23522, 23592, 23662,
+        23731, 23801, 23870, 23938, 24007, 24075, 24143, 24211, 24279, 24346, 24413, 24480,
+        24547, 24613, 24680, 24746, 24811, 24877, 24942, 25007, 25072, 25137, 25201, 25265,
+        25329, 25393, 25456, 25519, 25582, 25645, 25708, 25770, 25832, 25893, 25955, 26016,
+        26077, 26138, 26198, 26259, 26319, 26378, 26438, 26497, 26556, 26615, 26674, 26732,
+        26790, 26848, 26905, 26962, 27019, 27076, 27133, 27189, 27245, 27300, 27356, 27411,
+        27466, 27521, 27575, 27629, 27683, 27737, 27790, 27843, 27896, 27949, 28001, 28053,
+        28105, 28157, 28208, 28259, 28310, 28360, 28411, 28460, 28510, 28560, 28609, 28658,
+        28706, 28755, 28803, 28850, 28898, 28945, 28992, 29039, 29085, 29131, 29177, 29223,
+        29268, 29313, 29358, 29403, 29447, 29491, 29534, 29578, 29621, 29664, 29706, 29749,
+        29791, 29832, 29874, 29915, 29956, 29997, 30037, 30077, 30117, 30156, 30195, 30234,
+        30273, 30311, 30349, 30387, 30424, 30462, 30498, 30535, 30571, 30607, 30643, 30679,
+        30714, 30749, 30783, 30818, 30852, 30885, 30919, 30952, 30985, 31017, 31050, 31082,
+        31113, 31145, 31176, 31206, 31237, 31267, 31297, 31327, 31356, 31385, 31414, 31442,
+        31470, 31498, 31526, 31553, 31580, 31607, 31633, 31659, 31685, 31710, 31736, 31760,
+        31785, 31809, 31833, 31857, 31880, 31903, 31926, 31949, 31971, 31993, 32014, 32036,
+        32057, 32077, 32098, 32118, 32137, 32157, 32176, 32195, 32213, 32232, 32250, 32267,
+        32285, 32302, 32318, 32335, 32351, 32367, 32382, 32397, 32412, 32427, 32441, 32455,
+        32469, 32482, 32495, 32508, 32521, 32533, 32545, 32556, 32567, 32578, 32589, 32599,
+        32609, 32619, 32628, 32637, 32646, 32655, 32663, 32671, 32678, 32685, 32692, 32699,
+        32705, 32711, 32717, 32722, 32728, 32732, 32737, 32741, 32745, 32748, 32752, 32755,
+        32757, 32759, 32761, 32763, 32765, 32766, 32766, 32767, 32767
+};
+
+/*
+ * 256 * log2(1 + i / 32)
+ */
+static const uint16_t sLog2FractionTable[33] = {
+        0, 11, 22, 33, 44, 54, 63, 73, 82, 92, 100, 109, 118, 126, 134, 142, 150,
+        157, 165, 172, 179, 186, 193, 200, 207, 213, 220, 226, 232, 238, 244, 250, 256
+};
+
+/** @addtogroup Graphic_Library
+ * @{
+ */
+/**
+ * @param aFFTSize power of 2 from CHART_SPECTRUM_MIN_FFT_SIZE to CHART_SPECTRUM_MAX_FFT_SIZE
+ * @param aRealBuffer buffer of aFFTSize samples, which is filled by the application before computeSpectrum()
+ * @param aImaginaryBuffer buffer of aFFTSize values
+ * @return false if aFFTSize is not supported
+ */
+bool ChartSpectrum::init(uint16_t aFFTSize, int16_t *aRealBuffer, int16_t *aImaginaryBuffer, bool aUseHannWindow) {
+    if (aFFTSize < CHART_SPECTRUM_MIN_FFT_SIZE || aFFTSize > CHART_SPECTRUM_MAX_FFT_SIZE || (aFFTSize & (aFFTSize - 1)) != 0) {
+        mFFTSize = 0;
+        return false;
+    }
+    mFFTSize = aFFTSize;
+    mRealBuffer = aRealBuffer;
+    mImaginaryBuffer = aImaginaryBuffer;
+    mUseHannWindow = aUseHannWindow;
+    return true;
+}
+
+/**
+ * @param aIndex 0 to CHART_SPECTRUM_SINE_TABLE_PERIOD - 1 for one period
+ * @return sine in Q15
+ */
+int16_t ChartSpectrum::getSine(uint16_t aIndex) {
+    aIndex &= (CHART_SPECTRUM_SINE_TABLE_PERIOD - 1);
+    uint16_t tQuarter = CHART_SPECTRUM_SINE_TABLE_PERIOD / 4;
+    if (aIndex < tQuarter) {
+        return sQuarterSineTable[aIndex];
+    } else if (aIndex < 2 * tQuarter) {
+        return sQuarterSineTable[(2 * tQuarter) - aIndex];
+    } else if (aIndex < 3 * tQuarter) {
+        return -sQuarterSineTable[aIndex - (2 * tQuarter)];
+    }
+    return -sQuarterSineTable[(4 * tQuarter) - aIndex];
+}
+
+/*
+ * w(n) = sin(PI * n / N)^2, which is 0.5 - 0.5 * cos(2 * PI * n / N)
+ */
+void ChartSpectrum::applyHannWindow(void) {
+    uint16_t tIndexStep = (CHART_SPECTRUM_SINE_TABLE_PERIOD / 2) / mFFTSize;
+    for (uint16_t i = 0; i < mFFTSize; ++i) {
+        int32_t tSine = getSine(i * tIndexStep);
+        int32_t tWindow = (tSine * tSine) >> 15;
+        mRealBuffer[i] = (mRealBuffer[i] * tWindow) >> 15;
+    }
+}
+
+/**
+ * In place complex FFT. Result is the DFT divided by aFFTSize, in bit normal order.
+ * @param aFFTSize power of 2 up to CHART_SPECTRUM_MAX_FFT_SIZE
+ */
+void ChartSpectrum::computeFFT(int16_t *aRealBuffer, int16_t *aImaginaryBuffer, uint16_t aFFTSize) {
+    /*
+     * bit reversal permutation
+     */
+    uint16_t j = 0;
+    for (uint16_t i = 0; i < aFFTSize - 1; ++i) {
+        if (i < j) {
+            int16_t tTemp = aRealBuffer[i];
+            aRealBuffer[i] = aRealBuffer[j];
+            aRealBuffer[j] = tTemp;
+            tTemp = aImaginaryBuffer[i];
+            aImaginaryBuffer[i] = aImaginaryBuffer[j];
+            aImaginaryBuffer[j] = tTemp;
+        }
+        uint16_t tBit = aFFTSize >> 1;
+        while (j & tBit) {
+            j ^= tBit;
+            tBit >>= 1;
+        }
+        j |= tBit;
+    }
+
+    /*
+     * butterflies, each stage scales by 1/2
+     */
+    uint16_t tTwiddleStep = CHART_SPECTRUM_SINE_TABLE_PERIOD / 2;
+    for (uint16_t tHalfSize = 1; tHalfSize < aFFTSize; tHalfSize <<= 1) {
+        for (uint16_t k = 0; k < tHalfSize; ++k) {
+            // W = cos - i * sin of 2 * PI * k / (2 * tHalfSize)
+            int32_t tCos = getSine((k * tTwiddleStep) + (CHART_SPECTRUM_SINE_TABLE_PERIOD / 4));
+            int32_t tSin = getSine(k * tTwiddleStep);
+            for (uint16_t i = k; i < aFFTSize; i += 2 * tHalfSize) {
+                uint16_t tOdd = i + tHalfSize;
+                int32_t tReal = aRealBuffer[tOdd];
+                int32_t tImaginary = aImaginaryBuffer[tOdd];
+                int32_t tProductReal = ((tReal * tCos) + (tImaginary * tSin)) >> 15;
+                int32_t tProductImaginary = ((tImaginary * tCos) - (tReal * tSin)) >> 15;
+                int32_t tEvenReal = aRealBuffer[i];
+                int32_t tEvenImaginary = aImaginaryBuffer[i];
+                aRealBuffer[i] = (tEvenReal + tProductReal) >> 1;
+                aImaginaryBuffer[i] = (tEvenImaginary + tProductImaginary) >> 1;
+                aRealBuffer[tOdd] = (tEvenReal - tProductReal) >> 1;
+                aImaginaryBuffer[tOdd] = (tEvenImaginary - tProductImaginary) >> 1;
+            }
+        }
+        tTwiddleStep >>= 1;
+    }
+}
+
+/**
+ * @return 20 * log10(magnitude) in 1/10 dB, 0 for magnitude 0 and 1
+ */
+int16_t ChartSpectrum::getLogMagnitude(int16_t aReal, int16_t aImaginary) {
+    uint32_t tSquare = ((int32_t) aReal * aReal) + ((int32_t) aImaginary * aImaginary);
+    if (tSquare == 0) {
+        return 0;
+    }
+    // log2 in Q8, integer part by leading zeros, fraction by table with linear interpolation
+    uint8_t tIntegerPart = 31 - __builtin_clz(tSquare);
+    uint32_t tNormalized = tSquare << (31 - tIntegerPart); // leading one is bit 31
+    uint8_t tTableIndex = (tNormalized >> 26) & 0x1F;
+    uint16_t tInterpolation = (tNormalized >> 18) & 0xFF;
+    uint32_t tLog2 = (tIntegerPart << 8) + sLog2FractionTable[tTableIndex]
+            + (((sLog2FractionTable[tTableIndex + 1] - sLog2FractionTable[tTableIndex]) * tInterpolation) >> 8);
+    // 10 * log10(square) = 3.0103 * log2(square), 7706 is 30.103 / 256 * 65536
+    return ((tLog2 * 7706) + 0x8000) >> 16;
+}
+
+/**
+ * Applies the window to the samples, computes the FFT and stores the log magnitude of the first half of the bins
+ * in the sample buffer.
+ */
+void ChartSpectrum::computeSpectrum(void) {
+    if (mFFTSize == 0) {
+        return;
+    }
+    if (mUseHannWindow) {
+        applyHannWindow();
+    }
+    for (uint16_t i = 0; i < mFFTSize; ++i) {
+        mImaginaryBuffer[i] = 0;
+    }
+    computeFFT(mRealBuffer, mImaginaryBuffer, mFFTSize);
+    for (uint16_t i = 0; i < mFFTSize / 2; ++i) {
+        mRealBuffer[i] = getLogMagnitude(mRealBuffer[i], mImaginaryBuffer[i]);
+    }
+}
+
+/**
+ * Draws the spectrum computed last. Y labels of the chart are in 1/10 dB, e.g. initYLabelInt(0, 10, 0.1, 2)
+ * shows 10 dB per grid line. The X scale factor of the chart can be used to fit the bins to the chart width.
+ * @param aMode e.g. CHART_MODE_LINE or CHART_MODE_ENVELOPE for peak hold
+ * @return false if clipping occurs
+ */
+bool ChartSpectrum::drawSpectrum(Chart *aChart, const uint8_t aMode) {
+    if (mFFTSize == 0) {
+        return false;
+    }
+    return aChart->drawChartData(mRealBuffer, mRealBuffer + getNumberOfBins(), aMode);
+}
+/** @} */
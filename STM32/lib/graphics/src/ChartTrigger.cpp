@@ -0,0 +1,394 @@
+/*
+ * ChartTrigger.cpp
+ * Edge and pulse triggers use a Schmitt trigger: the signal becomes active when reaching the level
+ * and inactive when going back by more than the hysteresis. Edge triggers fire when the signal becomes active,
+ * pulse triggers when it becomes inactive after an active time between the minimum and maximum pulse width.
+ *
+ * The search always looks for the next value crossing one threshold. It tests blocks of values without a branch,
+ * uint8_t values 4 at a time in one 32 bit word, so that the loop runs at memory speed and compilers can vectorize it.
+ *
+ * @date 17.10.2026
+ * @author agent
+ * agent@local
+ * @copyright LGPL v3 (http://www.gnu.org/licenses/lgpl.html)
+ * @version 1.0.0
+ */
+
+#include "ChartTrigger.h"
+
+#include <stddef.h> // for NULL
+#include <string.h> // for memcpy
+
+#define CHART_TRIGGER_BLOCK_SIZE 8 // int16_t values tested without a branch
+
+/*
+ * @return index of first value >= aThreshold starting at aIndex, aEndIndex if not found
+ */
+static uint32_t findAtLeast(const int16_t *aDataPointer, uint32_t aIndex, uint32_t aEndIndex, int32_t aThreshold) {
+    if (aThreshold > INT16_MAX) {
+        return aEndIndex;
+    }
+    if (aThreshold <= INT16_MIN) {
+        return aIndex;
+    }
+    int16_t tThreshold = aThreshold;
+    while (aIndex + CHART_TRIGGER_BLOCK_SIZE <= aEndIndex) {
+        const int16_t *tBlockPointer = &aDataPointer[aIndex];
+        uint8_t tFound = 0;
+        for (uint8_t i = 0; i < CHART_TRIGGER_BLOCK_SIZE; ++i) {
+            tFound |= (tBlockPointer[i] >= tThreshold);
+        }
+        if (tFound) {
+            break;
+        }
+        aIndex += CHART_TRIGGER_BLOCK_SIZE;
+    }
+    while (aIndex < aEndIndex && aDataPointer[aIndex] < tThreshold) {
+        aIndex++;
+    }
+    return aIndex;
+}
+
+/*
+ * @return index of first value <= aThreshold starting at aIndex, aEndIndex if not found
+ */
+static uint32_t findAtMost(const int16_t *aDataPointer, uint32_t aIndex, uint32_t aEndIndex, int32_t aThreshold) {
+    if (aThreshold < INT16_MIN) {
+        return aEndIndex;
+    }
+    if (aThreshold >= INT16_MAX) {
+        return aIndex;
+    }
+    int16_t tThreshold = aThreshold;
+    while (aIndex + CHART_TRIGGER_BLOCK_SIZE <= aEndIndex) {
+        const int16_t *tBlockPointer = &aDataPointer[aIndex];
+        uint8_t tFound = 0;
+        for (uint8_t i = 0; i < CHART_TRIGGER_BLOCK_SIZE; ++i) {
+            tFound |= (tBlockPointer[i] <= tThreshold);
+        }
+        if (tFound) {
+            break;
+        }
+        aIndex += CHART_TRIGGER_BLOCK_SIZE;
+    }
+    while (aIndex < aEndIndex && aDataPointer[aIndex] > tThreshold) {
+        aIndex++;
+    }
+    return aIndex;
+}
+
+/*
+ * Compares the 4 bytes of two words as unsigned values.
+ * @return word with bit 7 of a byte set if this byte of aX >= the byte of aY
+ */
+static inline uint32_t getBytesGreaterOrEqual(uint32_t aX, uint32_t aY) {
+    // bit 7 of each byte is the result for the lower 7 bits, no borrow into the next byte can occur
+    uint32_t tLowBitsCompare = (aX | 0x80808080) - (aY & 0x7F7F7F7F);
+    // if bit 7 of both bytes differ, the result is bit 7 of aX
+    return ((aX & ~aY) | (~(aX ^ aY) & tLowBitsCompare)) & 0x80808080;
+}
+
+static uint32_t findAtLeast(const uint8_t *aDataPointer, uint32_t aIndex, uint32_t aEndIndex, int32_t aThreshold) {
+    if (aThreshold > UINT8_MAX) {
+        return aEndIndex;
+    }
+    if (aThreshold <= 0) {
+        return aIndex;
+    }
+    uint32_t tThresholds = aThreshold * 0x01010101;
+    while (aIndex + sizeof(uint32_t) <= aEndIndex) {
+        uint32_t tValues;
+        memcpy(&tValues, &aDataPointer[aIndex], sizeof(uint32_t)); // compiles to one load
+        if (getBytesGreaterOrEqual(tValues, tThresholds) != 0) {
+            break;
+        }
+        aIndex += sizeof(uint32_t);
+    }
+    while (aIndex < aEndIndex && aDataPointer[aIndex] < aThreshold) {
+        aIndex++;
+    }
+    return aIndex;
+}
+
+static uint32_t findAtMost(const uint8_t *aDataPointer, uint32_t aIndex, uint32_t aEndIndex, int32_t aThreshold) {
+    if (aThreshold < 0) {
+        return aEndIndex;
+    }
+    if (aThreshold >= UINT8_MAX) {
+        return aIndex;
+    }
+    uint32_t tThresholds = aThreshold * 0x01010101;
+    while (aIndex + sizeof(uint32_t) <= aEndIndex) {
+        uint32_t tValues;
+        memcpy(&tValues, &aDataPointer[aIndex], sizeof(uint32_t));
+        if (getBytesGreaterOrEqual(tThresholds, tValues) != 0) {
+            break;
+        }
+        aIndex += sizeof(uint32_t);
+    }
+    while (aIndex < aEndIndex && aDataPointer[aIndex] > aThreshold) {
+        aIndex++;
+    }
+    return aIndex;
+}
+
+/*
+ * Reverses the values from aStartPointer to aEndPointer - 1
+ */
+static void reverseValues(int16_t *aStartPointer, int16_t *aEndPointer) {
+    while (aStartPointer < --aEndPointer) {
+        int16_t tTemp = *aStartPointer;
+        *aStartPointer++ = *aEndPointer;
+        *aEndPointer = tTemp;
+    }
+}
+
+/** @addtogroup Graphic_Library
+ * @{
+ */
+ChartTrigger::ChartTrigger(void) {
+    mTriggerType = CHART_TRIGGER_TYPE_RISING_EDGE;
+    mLevel = 0;
+    mHysteresis = 0;
+    mMinimumPulseWidth = 0;
+    mMaximumPulseWidth = UINT32_MAX;
+    mRingBuffer = NULL;
+    mRingBufferSize = 0;
+    mPreTriggerSize = 0;
+    mRingBufferWriteIndex = 0;
+    mPostTriggerCount = 0;
+    mIsTriggered = false;
+    mCaptureIsComplete = false;
+    resetSearch(0);
+}
+
+/**
+ * @param aTriggerType one of CHART_TRIGGER_TYPE_*
+ * @param aLevel for uint8_t values it must be between 0 and 255
+ * @param aHysteresis the signal must go back by more than this value below the level (above for falling direction)
+ *        before the next edge or the end of a pulse is detected. Not used for level triggers.
+ */
+void ChartTrigger::setTrigger(uint8_t aTriggerType, int16_t aLevel, uint16_t aHysteresis) {
+    mTriggerType = aTriggerType;
+    mLevel = aLevel;
+    mHysteresis = aHysteresis;
+}
+
+/**
+ * Width in samples from reaching the level to going back by more than the hysteresis
+ */
+void ChartTrigger::setPulseWidth(uint32_t aMinimumWidth, uint32_t aMaximumWidth) {
+    mMinimumPulseWidth = aMinimumWidth;
+    mMaximumPulseWidth = aMaximumWidth;
+}
+
+/**
+ * Starts a new search. Edges and pulses are only detected after the signal was inactive once,
+ * so a search starting within a pulse does not trigger.
+ * @param aMinimumTriggerIndex triggers at an index lower than this are ignored, e.g. to get enough pre trigger values
+ */
+void ChartTrigger::resetSearch(uint32_t aMinimumTriggerIndex) {
+    mIsActive = true;
+    mPulseStartIsValid = false;
+    mPulseStartIndex = 0;
+    mSampleIndex = 0;
+    mMinimumTriggerIndex = aMinimumTriggerIndex;
+}
+
+template<typename T>
+int32_t ChartTrigger::findTriggerGeneric(const T *aDataPointer, uint32_t aNumberOfValues) {
+    bool tIsFalling = mTriggerType & CHART_TRIGGER_TYPE_FALLING_MASK;
+    int32_t tTriggerIndex = CHART_TRIGGER_NOT_FOUND;
+
+    if (mTriggerType == CHART_TRIGGER_TYPE_LEVEL_ABOVE || mTriggerType == CHART_TRIGGER_TYPE_LEVEL_BELOW) {
+        uint32_t tStartIndex = 0;
+        if (mMinimumTriggerIndex > mSampleIndex) {
+            tStartIndex = mMinimumTriggerIndex - mSampleIndex;
+        }
+        if (tStartIndex < aNumberOfValues) {
+            uint32_t tIndex =
+                    tIsFalling ?
+                            findAtMost(aDataPointer, tStartIndex, aNumberOfValues, mLevel) :
+                            findAtLeast(aDataPointer, tStartIndex, aNumberOfValues, mLevel);
+            if (tIndex < aNumberOfValues) {
+                tTriggerIndex = tIndex;
+            }
+        }
+        mSampleIndex += aNumberOfValues;
+        return tTriggerIndex;
+    }
+
+    bool tIsPulse = mTriggerType >= CHART_TRIGGER_TYPE_POSITIVE_PULSE;
+    int32_t tInactiveLevel = tIsFalling ? (int32_t) mLevel + mHysteresis + 1 : (int32_t) mLevel - mHysteresis - 1;
+    uint32_t tIndex = 0;
+    while (tIndex < aNumberOfValues) {
+        if (!mIsActive) {
+            tIndex = tIsFalling ?
+                    findAtMost(aDataPointer, tIndex, aNumberOfValues, mLevel) :
+                    findAtLeast(aDataPointer, tIndex, aNumberOfValues, mLevel);
+            if (tIndex >= aNumberOfValues) {
+                break;
+            }
+            mIsActive = true;
+            if (tIsPulse) {
+                mPulseStartIndex = mSampleIndex + tIndex;
+                mPulseStartIsValid = true;
+            } else if (mSampleIndex + tIndex >= mMinimumTriggerIndex) {
+                tTriggerIndex = tIndex;
+                break;
+            }
+        } else {
+            tIndex = tIsFalling ?
+                    findAtLeast(aDataPointer, tIndex, aNumberOfValues, tInactiveLevel) :
+                    findAtMost(aDataPointer, tIndex, aNumberOfValues, tInactiveLevel);
+            if (tIndex >= aNumberOfValues) {
+                break;
+            }
+            mIsActive = false;
+            if (tIsPulse && mPulseStartIsValid && mSampleIndex + tIndex >= mMinimumTriggerIndex) {
+                uint32_t tPulseWidth = (mSampleIndex + tIndex) - mPulseStartIndex;
+                if (tPulseWidth >= mMinimumPulseWidth && tPulseWidth <= mMaximumPulseWidth) {
+                    tTriggerIndex = tIndex;
+                    break;
+                }
+            }
+        }
+    }
+    mSampleIndex += aNumberOfValues;
+    return tTriggerIndex;
+}
+
+/**
+ * Searches the trigger in consecutive buffers, the search state is kept between calls.
+ * After a trigger was found, resetSearch() must be called before the next search.
+ * @return index of trigger value in this buffer or CHART_TRIGGER_NOT_FOUND
+ */
+int32_t ChartTrigger::findTrigger(const int16_t *aDataPointer, uint32_t aNumberOfValues) {
+    return findTriggerGeneric(aDataPointer, aNumberOfValues);
+}
+
+int32_t ChartTrigger::findTrigger(const uint8_t *aDataPointer, uint32_t aNumberOfValues) {
+    return findTriggerGeneric(aDataPointer, aNumberOfValues);
+}
+
+template<typename T>
+bool ChartTrigger::drawTriggeredWindowGeneric(Chart *aChart, const T *aDataPointer, uint32_t aNumberOfValues,
+        uint16_t aWindowSize, uint16_t aPreTriggerSize, const uint8_t aMode) {
+    if (aPreTriggerSize >= aWindowSize || aNumberOfValues < aWindowSize) {
+        return false;
+    }
+    resetSearch(aPreTriggerSize);
+    // the trigger must leave room for the values after it
+    int32_t tTriggerIndex = findTrigger(aDataPointer, (aNumberOfValues - aWindowSize) + aPreTriggerSize + 1);
+    if (tTriggerIndex == CHART_TRIGGER_NOT_FOUND) {
+        return false;
+    }
+    const T *tWindowStartPointer = aDataPointer + (tTriggerIndex - aPreTriggerSize);
+    aChart->drawChartData(tWindowStartPointer, tWindowStartPointer + aWindowSize, aMode);
+    return true;
+}
+
+/**
+ * Searches the first trigger in a capture buffer and draws aWindowSize values with the trigger at aPreTriggerSize.
+ * @return false if no trigger was found, then nothing is drawn
+ */
+bool ChartTrigger::drawTriggeredWindow(Chart *aChart, const int16_t *aDataPointer, uint32_t aNumberOfValues,
+        uint16_t aWindowSize, uint16_t aPreTriggerSize, const uint8_t aMode) {
+    return drawTriggeredWindowGeneric(aChart, aDataPointer, aNumberOfValues, aWindowSize, aPreTriggerSize, aMode);
+}
+
+bool ChartTrigger::drawTriggeredWindow(Chart *aChart, const uint8_t *aDataPointer, uint32_t aNumberOfValues,
+        uint16_t aWindowSize, uint16_t aPreTriggerSize, const uint8_t aMode) {
+    return drawTriggeredWindowGeneric(aChart, aDataPointer, aNumberOfValues, aWindowSize, aPreTriggerSize, aMode);
+}
+
+/**
+ * Starts a capture with the current trigger settings
+ * @param aRingBufferSize number of values drawn by drawCapture()
+ * @param aPreTriggerSize number of values before the trigger value
+ */
+void ChartTrigger::initCapture(int16_t *aRingBuffer, uint16_t aRingBufferSize, uint16_t aPreTriggerSize) {
+    if (aPreTriggerSize >= aRingBufferSize) {
+        aPreTriggerSize = aRingBufferSize - 1;
+    }
+    mRingBuffer = aRingBuffer;
+    mRingBufferSize = aRingBufferSize;
+    mPreTriggerSize = aPreTriggerSize;
+    mRingBufferWriteIndex = 0;
+    mPostTriggerCount = 0;
+    mIsTriggered = false;
+    mCaptureIsComplete = false;
+    resetSearch(aPreTriggerSize);
+}
+
+void ChartTrigger::copyToRingBuffer(const int16_t *aDataPointer, uint32_t aNumberOfValues) {
+    if (aNumberOfValues > mRingBufferSize) {
+        // only the last values are kept
+        uint32_t tSkipCount = aNumberOfValues - mRingBufferSize;
+        mRingBufferWriteIndex = (mRingBufferWriteIndex + tSkipCount) % mRingBufferSize;
+        aDataPointer += tSkipCount;
+        aNumberOfValues = mRingBufferSize;
+    }
+    while (aNumberOfValues > 0) {
+        uint32_t tCount = mRingBufferSize - mRingBufferWriteIndex;
+        if (tCount > aNumberOfValues) {
+            tCount = aNumberOfValues;
+        }
+        memcpy(&mRingBuffer[mRingBufferWriteIndex], aDataPointer, tCount * sizeof(int16_t));
+        mRingBufferWriteIndex += tCount;
+        if (mRingBufferWriteIndex >= mRingBufferSize) {
+            mRingBufferWriteIndex = 0;
+        }
+        aDataPointer += tCount;
+        aNumberOfValues -= tCount;
+    }
+}
+
+/**
+ * Adds consecutive values, e.g. from an ADC DMA buffer, to the capture.
+ * @return true if the capture is complete, values added afterwards are ignored
+ */
+bool ChartTrigger::addSamples(const int16_t *aDataPointer, uint32_t aNumberOfValues) {
+    if (mCaptureIsComplete || mRingBuffer == NULL) {
+        return mCaptureIsComplete;
+    }
+    if (!mIsTriggered) {
+        int32_t tTriggerIndex = findTrigger(aDataPointer, aNumberOfValues);
+        if (tTriggerIndex == CHART_TRIGGER_NOT_FOUND) {
+            copyToRingBuffer(aDataPointer, aNumberOfValues);
+            return false;
+        }
+        copyToRingBuffer(aDataPointer, tTriggerIndex);
+        mIsTriggered = true;
+        mPostTriggerCount = mRingBufferSize - mPreTriggerSize; // including trigger value
+        aDataPointer += tTriggerIndex;
+        aNumberOfValues -= tTriggerIndex;
+    }
+    if (aNumberOfValues > mPostTriggerCount) {
+        aNumberOfValues = mPostTriggerCount;
+    }
+    copyToRingBuffer(aDataPointer, aNumberOfValues);
+    mPostTriggerCount -= aNumberOfValues;
+    mCaptureIsComplete = (mPostTriggerCount == 0);
+    return mCaptureIsComplete;
+}
+
+/**
+ * Rotates the ring buffer in place, so that the trigger value is at index aPreTriggerSize, and draws it.
+ * @return false if capture is not complete, then nothing is drawn
+ */
+bool ChartTrigger::drawCapture(Chart *aChart, const uint8_t aMode) {
+    if (!mCaptureIsComplete) {
+        return false;
+    }
+    if (mRingBufferWriteIndex != 0) {
+        // the oldest value is at the write index
+        reverseValues(mRingBuffer, &mRingBuffer[mRingBufferWriteIndex]);
+        reverseValues(&mRingBuffer[mRingBufferWriteIndex], &mRingBuffer[mRingBufferSize]);
+        reverseValues(mRingBuffer, &mRingBuffer[mRingBufferSize]);
+        mRingBufferWriteIndex = 0;
+    }
+    aChart->drawChartData(mRingBuffer, mRingBuffer + mRingBufferSize, aMode);
+    return true;
+}
+/** @} */
@@ -0,0 +1,379 @@
+/*
+ * FrameBufferDisplay.cpp
+ * In memory RGB565 display. Lines are written as spans and spans are filled with 32 bit writes.
+ *
+ * @date 16.10.2026
+ * @author agent
+ * agent@local
+ * @copyright LGPL v3 (http://www.gnu.org/licenses/lgpl.html)
+ * @version 1.0.0
+ *
+ *  Font interface used (same as MI0283QT2):
+ *      - FONT_WIDTH (max 8), FONT_HEIGHT, FONT_START, FONT_END
+ *      - font_PGM[] 1 byte per row, MSB is left pixel
+ */
+
+#include "FrameBufferDisplay.h"
+#include "Colors.h" // for COLOR16_NO_BACKGROUND
+#include "fonts.h"
+
+#include <stdlib.h> // for malloc
+#include <string.h> // for memcpy
+
+/** @addtogroup Graphic_Library
+ * @{
+ */
+/**
+ * @param aFrameBuffer if NULL, a buffer of aWidth * aHeight pixel is allocated by init()
+ */
+FrameBufferDisplay::FrameBufferDisplay(uint16_t aWidth, uint16_t aHeight, uint16_t *aFrameBuffer) { // @suppress("Class members should be properly initialized")
+    mWidth = aWidth;
+    mHeight = aHeight;
+    mFrameBuffer = aFrameBuffer;
+    mFrameBufferIsAllocated = false;
+}
+
+FrameBufferDisplay::~FrameBufferDisplay() {
+    if (mFrameBufferIsAllocated) {
+        free(mFrameBuffer);
+    }
+}
+
+/**
+ * @return false if frame buffer could not be allocated
+ */
+bool FrameBufferDisplay::init(void) {
+    if (mFrameBuffer == NULL) {
+        mFrameBuffer = (uint16_t*) malloc(sizeof(uint16_t) * mWidth * mHeight);
+        if (mFrameBuffer == NULL) {
+            return false;
+        }
+        mFrameBufferIsAllocated = true;
+    }
+    clearDisplay(0);
+    return true;
+}
+
+/*
+ * Writes 2 pixel at once after aligning the pointer to 32 bit.
+ * The 32 bit stores use memcpy(), since the buffer is an uint16_t array and must not be accessed by an uint32_t pointer.
+ */
+void FrameBufferDisplay::fillSpan(uint16_t *aStartPointer, uint16_t aLength, uint16_t aColor) {
+    if (aLength > 0 && ((uintptr_t) aStartPointer & 0x02) != 0) {
+        *aStartPointer++ = aColor;
+        aLength--;
+    }
+    uint32_t tColorPair = ((uint32_t) aColor << 16) | aColor;
+    for (uint16_t i = aLength / 2; i > 0; i--) {
+        memcpy(aStartPointer, &tColorPair, sizeof(tColorPair));
+        aStartPointer += 2;
+    }
+    if (aLength & 0x01) {
+        *aStartPointer = aColor;
+    }
+}
+
+/*
+ * Clipped horizontal line, end is included
+ */
+void FrameBufferDisplay::drawHorizontalSpan(int aXStart, int aXEnd, int aYPos, uint16_t aColor) {
+    if (aYPos < 0 || aYPos >= mHeight) {
+        return;
+    }
+    if (aXStart < 0) {
+        aXStart = 0;
+    }
+    if (aXEnd >= mWidth) {
+        aXEnd = mWidth - 1;
+    }
+    if (aXStart <= aXEnd) {
+        fillSpan(&mFrameBuffer[aYPos * mWidth + aXStart], aXEnd - aXStart + 1, aColor);
+    }
+}
+
+void FrameBufferDisplay::clearDisplay(uint16_t aColor) {
+    // 32 bit length, since the display may have more than 65535 pixel
+    uint32_t tNumberOfPixel = (uint32_t) mWidth * mHeight;
+    uint16_t *tPixelPointer = mFrameBuffer;
+    while (tNumberOfPixel > 0) {
+        uint16_t tLength = 0xFFFE;
+        if (tNumberOfPixel < tLength) {
+            tLength = tNumberOfPixel;
+        }
+        fillSpan(tPixelPointer, tLength, aColor);
+        tPixelPointer += tLength;
+        tNumberOfPixel -= tLength;
+    }
+}
+
+void FrameBufferDisplay::drawPixel(uint16_t aXPos, uint16_t aYPos, uint16_t aColor) {
+    if (aXPos < mWidth && aYPos < mHeight) {
+        mFrameBuffer[aYPos * mWidth + aXPos] = aColor;
+    }
+}
+
+/**
+ * @return 0 for positions outside the display
+ */
+uint16_t FrameBufferDisplay::readPixel(uint16_t aXPos, uint16_t aYPos) const {
+    if (aXPos < mWidth && aYPos < mHeight) {
+        return mFrameBuffer[aYPos * mWidth + aXPos];
+    }
+    return 0;
+}
+
+/**
+ * Bresenham with fast path for horizontal and vertical lines
+ */
+void FrameBufferDisplay::drawLine(uint16_t aXStart, uint16_t aYStart, uint16_t aXEnd, uint16_t aYEnd, uint16_t aColor) {
+    if (aXStart == aXEnd || aYStart == aYEnd) {
+        // horizontal or vertical line
+        fillRect(aXStart, aYStart, aXEnd, aYEnd, aColor);
+        return;
+    }
+    int tDeltaX = (int) aXEnd - aXStart;
+    int tDeltaY = (int) aYEnd - aYStart;
+    int tStepX = 1;
+    int tStepY = 1;
+    if (tDeltaX < 0) {
+        tDeltaX = -tDeltaX;
+        tStepX = -1;
+    }
+    if (tDeltaY < 0) {
+        tDeltaY = -tDeltaY;
+        tStepY = -1;
+    }
+    int tError = tDeltaX - tDeltaY;
+    int tXPos = aXStart;
+    int tYPos = aYStart;
+    while (true) {
+        drawPixel(tXPos, tYPos, aColor);
+        if (tXPos == aXEnd && tYPos == aYEnd) {
+            break;
+        }
+        int tError2 = 2 * tError;
+        if (tError2 > -tDeltaY) {
+            tError -= tDeltaY;
+            tXPos += tStepX;
+        }
+        if (tError2 < tDeltaX) {
+            tError += tDeltaX;
+            tYPos += tStepY;
+        }
+    }
+}
+
+void FrameBufferDisplay::drawLineFastOneX(uint16_t aXStart, uint16_t aYStart, uint16_t aYEnd, uint16_t aColor) {
+    fillRect(aXStart, aYStart, aXStart, aYEnd, aColor);
+}
+
+void FrameBufferDisplay::drawRect(uint16_t aXStart, uint16_t aYStart, uint16_t aXEnd, uint16_t aYEnd, uint16_t aColor) {
+    fillRect(aXStart, aYStart, aXEnd, aYStart, aColor);
+    fillRect(aXStart, aYEnd, aXEnd, aYEnd, aColor);
+    fillRect(aXStart, aYStart, aXStart, aYEnd, aColor);
+    fillRect(aXEnd, aYStart, aXEnd, aYEnd, aColor);
+}
+
+/**
+ * End values are included. First line is filled by fillSpan() and then copied to the other lines.
+ */
+void FrameBufferDisplay::fillRect(uint16_t aXStart, uint16_t aYStart, uint16_t aXEnd, uint16_t aYEnd, uint16_t aColor) {
+    if (aXStart > aXEnd) {
+        uint16_t tTemp = aXStart;
+        aXStart = aXEnd;
+        aXEnd = tTemp;
+    }
+    if (aYStart > aYEnd) {
+        uint16_t tTemp = aYStart;
+        aYStart = aYEnd;
+        aYEnd = tTemp;
+    }
+    if (aXStart >= mWidth || aYStart >= mHeight) {
+        return;
+    }
+    if (aXEnd >= mWidth) {
+        aXEnd = mWidth - 1;
+    }
+    if (aYEnd >= mHeight) {
+        aYEnd = mHeight - 1;
+    }
+    uint16_t tLength = aXEnd - aXStart + 1;
+    uint16_t *tFirstLinePointer = &mFrameBuffer[aYStart * mWidth + aXStart];
+    fillSpan(tFirstLinePointer, tLength, aColor);
+    uint16_t *tLinePointer = tFirstLinePointer;
+    for (uint16_t tYPos = aYStart + 1; tYPos <= aYEnd; ++tYPos) {
+        tLinePointer += mWidth;
+        memcpy(tLinePointer, tFirstLinePointer, tLength * sizeof(uint16_t));
+    }
+}
+
+/**
+ * Midpoint circle algorithm
+ */
+void FrameBufferDisplay::drawCircle(uint16_t aXCenter, uint16_t aYCenter, uint16_t aRadius, uint16_t aColor) {
+    int tError = 1 - aRadius;
+    int tX = 0;
+    int tY = aRadius;
+    while (tX <= tY) {
+        drawPixel(aXCenter + tX, aYCenter + tY, aColor);
+        drawPixel(aXCenter - tX, aYCenter + tY, aColor);
+        drawPixel(aXCenter + tX, aYCenter - tY, aColor);
+        drawPixel(aXCenter - tX, aYCenter - tY, aColor);
+        drawPixel(aXCenter + tY, aYCenter + tX, aColor);
+        drawPixel(aXCenter - tY, aYCenter + tX, aColor);
+        drawPixel(aXCenter + tY, aYCenter - tX, aColor);
+        drawPixel(aXCenter - tY, aYCenter - tX, aColor);
+        tX++;
+        if (tError < 0) {
+            tError += 2 * tX + 1;
+        } else {
+            tY--;
+            tError += 2 * (tX - tY) + 1;
+        }
+    }
+}
+
+/**
+ * Like drawCircle(), but draws horizontal spans between the symmetric points
+ */
+void FrameBufferDisplay::fillCircle(uint16_t aXCenter, uint16_t aYCenter, uint16_t aRadius, uint16_t aColor) {
+    int tError = 1 - aRadius;
+    int tX = 0;
+    int tY = aRadius;
+    while (tX <= tY) {
+        drawHorizontalSpan(aXCenter - tX, aXCenter + tX, aYCenter + tY, aColor);
+        drawHorizontalSpan(aXCenter - tX, aXCenter + tX, aYCenter - tY, aColor);
+        drawHorizontalSpan(aXCenter - tY, aXCenter + tY, aYCenter + tX, aColor);
+        drawHorizontalSpan(aXCenter - tY, aXCenter + tY, aYCenter - tX, aColor);
+        tX++;
+        if (tError < 0) {
+            tError += 2 * tX + 1;
+        } else {
+            tY--;
+            tError += 2 * (tX - tY) + 1;
+        }
+    }
+}
+
+/**
+ * @param aCharSize 1 for normal font, 2 for double size etc.
+ * @param aBGColor if COLOR16_NO_BACKGROUND, then the background will not filled
+ * @return start x for next character
+ */
+uint16_t FrameBufferDisplay::drawChar(uint16_t aPosX, uint16_t aPosY, char aChar, uint8_t aCharSize, uint16_t aFGColor,
+        uint16_t aBGColor) {
+    uint8_t tChar = aChar;
+    if (tChar < FONT_START || tChar > FONT_END) {
+        tChar = '?';
+    }
+    if (aBGColor != COLOR16_NO_BACKGROUND) {
+        fillRect(aPosX, aPosY, aPosX + (FONT_WIDTH * aCharSize) - 1, aPosY + (FONT_HEIGHT * aCharSize) - 1, aBGColor);
+    }
+    const uint8_t *tFontPointer = &font_PGM[(tChar - FONT_START) * FONT_HEIGHT];
+    uint16_t tYPos = aPosY;
+    for (uint8_t tRow = 0; tRow < FONT_HEIGHT; ++tRow) {
+        uint8_t tRowBits = *tFontPointer++;
+        uint16_t tXPos = aPosX;
+        for (uint8_t tColumn = 0; tColumn < FONT_WIDTH; ++tColumn) {
+            if (tRowBits & 0x80) {
+                if (aCharSize == 1) {
+                    drawPixel(tXPos, tYPos, aFGColor);
+                } else {
+                    fillRect(tXPos, tYPos, tXPos + aCharSize - 1, tYPos + aCharSize - 1, aFGColor);
+                }
+            }
+            tRowBits <<= 1;
+            tXPos += aCharSize;
+        }
+        tYPos += aCharSize;
+    }
+    return aPosX + (FONT_WIDTH * aCharSize);
+}
+
+/**
+ * Characters beyond the right border are not drawn
+ * @return start x for next character
+ */
+uint16_t FrameBufferDisplay::drawText(uint16_t aPosX, uint16_t aPosY, const char *aStringPtr, uint8_t aCharSize,
+        uint16_t aFGColor, uint16_t aBGColor) {
+    while (*aStringPtr != '\0' && aPosX < mWidth) {
+        aPosX = drawChar(aPosX, aPosY, *aStringPtr++, aCharSize, aFGColor, aBGColor);
+    }
+    return aPosX;
+}
+
+/*
+ * Program memory is directly addressable on ARM
+ */
+uint16_t FrameBufferDisplay::drawTextPGM(uint16_t aPosX, uint16_t aPosY, const char *aPGMString, uint8_t aCharSize,
+        uint16_t aFGColor, uint16_t aBGColor) {
+    return drawText(aPosX, aPosY, aPGMString, aCharSize, aFGColor, aBGColor);
+}
+
+/**
+ * Handles '\n' and wraps at the right border
+ * @return start y for next line
+ */
+uint16_t FrameBufferDisplay::drawMLText(uint16_t aPosX, uint16_t aPosY, const char *aStringPtr, uint8_t aCharSize,
+        uint16_t aFGColor, uint16_t aBGColor) {
+    uint16_t tXPos = aPosX;
+    uint16_t tLineHeight = FONT_HEIGHT * aCharSize;
+    while (*aStringPtr != '\0' && aPosY < mHeight) {
+        char tChar = *aStringPtr++;
+        if (tChar == '\n') {
+            tXPos = aPosX;
+            aPosY += tLineHeight;
+            continue;
+        }
+        if (tXPos + (FONT_WIDTH * aCharSize) > mWidth) {
+            tXPos = aPosX;
+            aPosY += tLineHeight;
+        }
+        tXPos = drawChar(tXPos, aPosY, tChar, aCharSize, aFGColor, aBGColor);
+    }
+    return aPosY + tLineHeight;
+}
+
+/**
+ * Writes a binary PPM (P6) file. RGB565 is expanded to 8 bit per color by replicating the upper bits.
+ */
+bool FrameBufferDisplay::writePPM(FILE *aFile) const {
+    if (fprintf(aFile, "P6\n%u %u\n255\n", mWidth, mHeight) < 0) {
+        return false;
+    }
+    uint8_t tLineBuffer[3 * 64];
+    uint32_t tNumberOfPixel = (uint32_t) mWidth * mHeight;
+    const uint16_t *tPixelPointer = mFrameBuffer;
+    while (tNumberOfPixel > 0) {
+        uint8_t tNumberOfPixelInBuffer = 0;
+        uint8_t *tBufferPointer = tLineBuffer;
+        while (tNumberOfPixelInBuffer < 64 && tNumberOfPixel > 0) {
+            uint16_t tColor = *tPixelPointer++;
+            uint8_t tRed = (tColor >> 11) & 0x1F;
+            uint8_t tGreen = (tColor >> 5) & 0x3F;
+            uint8_t tBlue = tColor & 0x1F;
+            *tBufferPointer++ = (tRed << 3) | (tRed >> 2);
+            *tBufferPointer++ = (tGreen << 2) | (tGreen >> 4);
+            *tBufferPointer++ = (tBlue << 3) | (tBlue >> 2);
+            tNumberOfPixelInBuffer++;
+            tNumberOfPixel--;
+        }
+        if (fwrite(tLineBuffer, 3, tNumberOfPixelInBuffer, aFile) != tNumberOfPixelInBuffer) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool FrameBufferDisplay::writePPM(const char *aFilename) const {
+    FILE *tFile = fopen(aFilename, "wb");
+    if (tFile == NULL) {
+        return false;
+    }
+    bool tResult = writePPM(tFile);
+    if (fclose(tFile) != 0) {
+        tResult = false;
+    }
+    return tResult;
+}
+/** @} */
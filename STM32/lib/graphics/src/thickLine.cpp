@@ -11,7 +11,9 @@
 
 #include "thickline.h"
 // for LocalDisplay.drawPixel(), LocalDisplay.drawLine() and LocalDisplay.fillRect()
-#if defined(USE_HY32D)
+#if defined(USE_FRAME_BUFFER_DISPLAY)
+#include "FrameBufferDisplay.h"
+#elif defined(USE_HY32D)
 #include "SSD1289.h"
 #else
 #include "MI0283QT2.h"
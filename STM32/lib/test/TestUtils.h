@@ -0,0 +1,62 @@
+/*
+ * TestUtils.h
+ *
+ * Minimal check and timing helpers for the host tests and benchmarks.
+ *
+ * @date 17.10.2026
+ * @author agent
+ * agent@local
+ * @copyright LGPL v3 (http://www.gnu.org/licenses/lgpl.html)
+ * @version 1.0.0
+ */
+
+#ifndef TEST_UTILS_H_
+#define TEST_UTILS_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+static unsigned long sNumberOfChecks = 0;
+static unsigned long sNumberOfFailedChecks = 0;
+
+/*
+ * Prints only the first failures, so that a systematic error does not flood the output
+ */
+#define CHECK(aCondition, ...) do { \
+    sNumberOfChecks++; \
+    if (!(aCondition)) { \
+        if (sNumberOfFailedChecks++ < 10) { \
+            printf("%s:%d: check failed: %s: ", __FILE__, __LINE__, #aCondition); \
+            printf(__VA_ARGS__); \
+            printf("\n"); \
+        } \
+    } \
+} while (0)
+
+/*
+ * @return exit code for main()
+ */
+static inline int printCheckSummary(void) {
+    printf("%lu checks, %lu failed\n", sNumberOfChecks, sNumberOfFailedChecks);
+    return sNumberOfFailedChecks == 0 ? 0 : 1;
+}
+
+static inline double getSeconds(void) {
+    struct timespec tTime;
+    clock_gettime(CLOCK_MONOTONIC, &tTime);
+    return tTime.tv_sec + (tTime.tv_nsec * 1e-9);
+}
+
+/*
+ * Xorshift generator, so that results do not depend on the C library
+ */
+static uint32_t sRandomState = 2463534242UL;
+static inline uint32_t getRandom(void) {
+    sRandomState ^= sRandomState << 13;
+    sRandomState ^= sRandomState >> 17;
+    sRandomState ^= sRandomState << 5;
+    return sRandomState;
+}
+
+#endif // TEST_UTILS_H_
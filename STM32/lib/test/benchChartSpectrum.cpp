@@ -0,0 +1,127 @@
+/*
+ * benchChartSpectrum.cpp
+ *
+ * Compares the speed of ChartSpectrum::computeSpectrum() with the same radix-2 FFT, Hann window and log10
+ * computed in float, and prints the deviation of the fixed point spectrum from the float one.
+ * On the host the FPU is fast, so the speedup on an MCU without FPU is much bigger.
+ *
+ * @date 17.10.2026
+ * @author agent
+ * agent@local
+ * @copyright LGPL v3 (http://www.gnu.org/licenses/lgpl.html)
+ * @version 1.0.0
+ */
+
+#include "TestUtils.h"
+#include "BDNumberFormat.cpp"
+#include "ChartLTTB.cpp"
+#include "Chart.cpp"
+#include "ChartSpectrum.cpp"
+
+#include <math.h>
+
+BlueDisplay BlueDisplay1;
+
+#define NUMBER_OF_SAMPLES (1024L * 1024L) // per FFT size
+
+static int16_t sSamples[CHART_SPECTRUM_MAX_FFT_SIZE];
+static int16_t sReal[CHART_SPECTRUM_MAX_FFT_SIZE];
+static int16_t sImaginary[CHART_SPECTRUM_MAX_FFT_SIZE];
+static float sFloatReal[CHART_SPECTRUM_MAX_FFT_SIZE];
+static float sFloatImaginary[CHART_SPECTRUM_MAX_FFT_SIZE];
+static float sFloatSine[CHART_SPECTRUM_SINE_TABLE_PERIOD]; // full period, like the twiddle factors of ChartSpectrum
+static volatile int32_t sCheckSum; // avoids that the compiler removes the loops
+
+/*
+ * Same algorithm as ChartSpectrum::computeSpectrum() in float, including the scaling by 1/N.
+ * Window and twiddle factors are taken from a table as well.
+ */
+static void computeFloatSpectrum(const int16_t *aSamples, uint16_t aFFTSize) {
+    uint16_t tIndexStep = (CHART_SPECTRUM_SINE_TABLE_PERIOD / 2) / aFFTSize;
+    for (uint16_t i = 0; i < aFFTSize; ++i) {
+        float tWindow = sFloatSine[i * tIndexStep];
+        sFloatReal[i] = aSamples[i] * tWindow * tWindow;
+        sFloatImaginary[i] = 0;
+    }
+    uint16_t j = 0;
+    for (uint16_t i = 0; i < aFFTSize - 1; ++i) {
+        if (i < j) {
+            float tTemp = sFloatReal[i];
+            sFloatReal[i] = sFloatReal[j];
+            sFloatReal[j] = tTemp;
+        }
+        uint16_t tBit = aFFTSize >> 1;
+        while (j & tBit) {
+            j ^= tBit;
+            tBit >>= 1;
+        }
+        j |= tBit;
+    }
+    uint16_t tTwiddleStep = CHART_SPECTRUM_SINE_TABLE_PERIOD / 2;
+    for (uint16_t tHalfSize = 1; tHalfSize < aFFTSize; tHalfSize <<= 1) {
+        for (uint16_t k = 0; k < tHalfSize; ++k) {
+            float tCos = sFloatSine[((k * tTwiddleStep) + (CHART_SPECTRUM_SINE_TABLE_PERIOD / 4))
+                    & (CHART_SPECTRUM_SINE_TABLE_PERIOD - 1)];
+            float tSin = sFloatSine[k * tTwiddleStep];
+            for (uint16_t i = k; i < aFFTSize; i += 2 * tHalfSize) {
+                uint16_t tOdd = i + tHalfSize;
+                float tProductReal = (sFloatReal[tOdd] * tCos) + (sFloatImaginary[tOdd] * tSin);
+                float tProductImaginary = (sFloatImaginary[tOdd] * tCos) - (sFloatReal[tOdd] * tSin);
+                float tEvenReal = sFloatReal[i];
+                float tEvenImaginary = sFloatImaginary[i];
+                sFloatReal[i] = (tEvenReal + tProductReal) * 0.5f;
+                sFloatImaginary[i] = (tEvenImaginary + tProductImaginary) * 0.5f;
+                sFloatReal[tOdd] = (tEvenReal - tProductReal) * 0.5f;
+                sFloatImaginary[tOdd] = (tEvenImaginary - tProductImaginary) * 0.5f;
+            }
+        }
+        tTwiddleStep >>= 1;
+    }
+    for (uint16_t i = 0; i < aFFTSize / 2; ++i) {
+        float tSquare = (sFloatReal[i] * sFloatReal[i]) + (sFloatImaginary[i] * sFloatImaginary[i]);
+        sFloatReal[i] = (tSquare < 1) ? 0 : 100 * log10f(tSquare);
+    }
+}
+
+int main(void) {
+    for (uint16_t i = 0; i < CHART_SPECTRUM_SINE_TABLE_PERIOD; ++i) {
+        sFloatSine[i] = sinf(2 * (float) M_PI * i / CHART_SPECTRUM_SINE_TABLE_PERIOD);
+    }
+    // Two sines and noise
+    for (uint16_t i = 0; i < CHART_SPECTRUM_MAX_FFT_SIZE; ++i) {
+        sSamples[i] = (int16_t) ((16000 * sinf(0.3f * i)) + (4000 * sinf(1.7f * i)) + (int16_t) (getRandom() % 2001) - 1000);
+    }
+
+    ChartSpectrum tSpectrum;
+    for (uint16_t tFFTSize = 64; tFFTSize <= CHART_SPECTRUM_MAX_FFT_SIZE; tFFTSize <<= 2) {
+        tSpectrum.init(tFFTSize, sReal, sImaginary, true);
+        long tNumberOfLoops = NUMBER_OF_SAMPLES / tFFTSize;
+
+        double tStart = getSeconds();
+        for (long tLoop = 0; tLoop < tNumberOfLoops; ++tLoop) {
+            memcpy(sReal, sSamples, tFFTSize * sizeof(int16_t));
+            tSpectrum.computeSpectrum();
+            sCheckSum += sReal[tLoop & (tFFTSize / 2 - 1)];
+        }
+        double tFixedSeconds = getSeconds() - tStart;
+
+        tStart = getSeconds();
+        for (long tLoop = 0; tLoop < tNumberOfLoops; ++tLoop) {
+            computeFloatSpectrum(sSamples, tFFTSize);
+            sCheckSum += (int32_t) sFloatReal[tLoop & (tFFTSize / 2 - 1)];
+        }
+        double tFloatSeconds = getSeconds() - tStart;
+
+        // Deviation of the bins 40 dB above the rounding noise of 1 LSB
+        float tMaxDeviation = 0;
+        for (uint16_t i = 0; i < tFFTSize / 2; ++i) {
+            if (sFloatReal[i] > 400) {
+                tMaxDeviation = fmaxf(tMaxDeviation, fabsf(sReal[i] - sFloatReal[i]));
+            }
+        }
+        printf("computeSpectrum(%4u) %8.2f us  float %8.2f us  speedup %.1f  max deviation %.1f dB\n", tFFTSize,
+                tFixedSeconds * 1e6 / tNumberOfLoops, tFloatSeconds * 1e6 / tNumberOfLoops, tFloatSeconds / tFixedSeconds,
+                tMaxDeviation / 10);
+    }
+    return 0;
+}
@@ -0,0 +1,131 @@
+/*
+ * benchChartTrigger.cpp
+ *
+ * Compares the speed of ChartTrigger::findTrigger() with a sample by sample search for captures of 16 M samples,
+ * where the trigger is near the end, so the whole capture is scanned.
+ * The trigger index must be the same as the one of the sample by sample search, otherwise the benchmark fails.
+ *
+ * @date 17.10.2026
+ * @author agent
+ * agent@local
+ * @copyright LGPL v3 (http://www.gnu.org/licenses/lgpl.html)
+ * @version 1.0.0
+ */
+
+#include "TestUtils.h"
+#include "BDNumberFormat.cpp"
+#include "ChartLTTB.cpp"
+#include "Chart.cpp"
+#include "ChartTrigger.cpp"
+
+#include <stdlib.h>
+
+BlueDisplay BlueDisplay1;
+
+#define NUMBER_OF_SAMPLES (16UL * 1024UL * 1024UL)
+#define NUMBER_OF_LOOPS 5
+#define TEST_LEVEL_16 2000
+#define TEST_LEVEL_8 200
+#define TEST_HYSTERESIS 10
+#define TEST_EDGE_LEVEL_OFFSET 20 // the spikes do not reach the edge level
+
+/*
+ * Schmitt trigger as described in ChartTrigger.cpp, one comparison per sample
+ */
+template<typename T>
+static int32_t findReferenceTrigger(const T *aDataPointer, uint32_t aNumberOfValues, uint8_t aTriggerType, int32_t aLevel,
+        int32_t aHysteresis, uint32_t aMinimumPulseWidth, uint32_t aMaximumPulseWidth) {
+    bool tIsFalling = aTriggerType & CHART_TRIGGER_TYPE_FALLING_MASK;
+    bool tIsPulse = aTriggerType >= CHART_TRIGGER_TYPE_POSITIVE_PULSE;
+    bool tIsActive = true;
+    bool tPulseStartIsValid = false;
+    uint32_t tPulseStartIndex = 0;
+    for (uint32_t i = 0; i < aNumberOfValues; ++i) {
+        int32_t tValue = aDataPointer[i];
+        if (!tIsActive) {
+            if (tIsFalling ? tValue <= aLevel : tValue >= aLevel) {
+                tIsActive = true;
+                if (!tIsPulse) {
+                    return i;
+                }
+                tPulseStartIndex = i;
+                tPulseStartIsValid = true;
+            }
+        } else if (tIsFalling ? tValue > aLevel + aHysteresis : tValue < aLevel - aHysteresis) {
+            tIsActive = false;
+            uint32_t tPulseWidth = i - tPulseStartIndex;
+            if (tIsPulse && tPulseStartIsValid && tPulseWidth >= aMinimumPulseWidth && tPulseWidth <= aMaximumPulseWidth) {
+                return i;
+            }
+        }
+    }
+    return CHART_TRIGGER_NOT_FOUND;
+}
+
+/*
+ * Noise below the level with short spikes just above it, which are too short for the pulse trigger,
+ * and one long pulse near the end, which is also above the level of the edge trigger
+ */
+template<typename T>
+static void fillCapture(T *aDataPointer, int32_t aNoiseRange, int32_t aLevel) {
+    for (uint32_t i = 0; i < NUMBER_OF_SAMPLES; ++i) {
+        aDataPointer[i] = getRandom() % aNoiseRange;
+    }
+    for (uint32_t i = 1000; i < NUMBER_OF_SAMPLES - 1000; i += 4096 + (getRandom() % 4096)) {
+        aDataPointer[i] = aLevel + 1;
+    }
+    for (uint32_t i = NUMBER_OF_SAMPLES - 1000; i < NUMBER_OF_SAMPLES - 900; ++i) {
+        aDataPointer[i] = aLevel + TEST_EDGE_LEVEL_OFFSET + 1;
+    }
+}
+
+template<typename T>
+static bool runBenchmark(const char *aName, const T *aDataPointer, uint8_t aTriggerType, int16_t aLevel) {
+    ChartTrigger tTrigger;
+    tTrigger.setTrigger(aTriggerType, aLevel, TEST_HYSTERESIS);
+    tTrigger.setPulseWidth(50, 200);
+    int32_t tTriggerIndex = 0;
+    double tStart = getSeconds();
+    for (uint16_t tLoop = 0; tLoop < NUMBER_OF_LOOPS; ++tLoop) {
+        tTrigger.resetSearch(0);
+        tTriggerIndex = tTrigger.findTrigger(aDataPointer, NUMBER_OF_SAMPLES);
+    }
+    double tTriggerSeconds = (getSeconds() - tStart) / NUMBER_OF_LOOPS;
+
+    int32_t tReferenceIndex = 0;
+    tStart = getSeconds();
+    for (uint16_t tLoop = 0; tLoop < NUMBER_OF_LOOPS; ++tLoop) {
+        tReferenceIndex = findReferenceTrigger(aDataPointer, NUMBER_OF_SAMPLES, aTriggerType, aLevel, TEST_HYSTERESIS, 50,
+                200);
+    }
+    double tReferenceSeconds = (getSeconds() - tStart) / NUMBER_OF_LOOPS;
+
+    printf("%-22s %7.2f ms %6.0f MS/s  sample by sample %7.2f ms  speedup %.1f\n", aName, tTriggerSeconds * 1e3,
+            NUMBER_OF_SAMPLES / tTriggerSeconds / 1e6, tReferenceSeconds * 1e3, tReferenceSeconds / tTriggerSeconds);
+    if (tTriggerIndex != tReferenceIndex || tTriggerIndex == CHART_TRIGGER_NOT_FOUND) {
+        printf("%s: trigger at %ld, expected %ld\n", aName, (long) tTriggerIndex, (long) tReferenceIndex);
+        return false;
+    }
+    return true;
+}
+
+int main(void) {
+    int16_t *tSamples16 = (int16_t*) malloc(NUMBER_OF_SAMPLES * sizeof(int16_t));
+    uint8_t *tSamples8 = (uint8_t*) malloc(NUMBER_OF_SAMPLES);
+    if (tSamples16 == NULL || tSamples8 == NULL) {
+        printf("Not enough memory\n");
+        return 1;
+    }
+    fillCapture(tSamples16, 1000, TEST_LEVEL_16);
+    fillCapture(tSamples8, 100, TEST_LEVEL_8);
+
+    bool tIsOK = runBenchmark("int16_t rising edge", tSamples16, CHART_TRIGGER_TYPE_RISING_EDGE,
+            TEST_LEVEL_16 + TEST_EDGE_LEVEL_OFFSET);
+    tIsOK &= runBenchmark("int16_t positive pulse", tSamples16, CHART_TRIGGER_TYPE_POSITIVE_PULSE, TEST_LEVEL_16);
+    tIsOK &= runBenchmark("uint8_t rising edge", tSamples8, CHART_TRIGGER_TYPE_RISING_EDGE,
+            TEST_LEVEL_8 + TEST_EDGE_LEVEL_OFFSET);
+    tIsOK &= runBenchmark("uint8_t positive pulse", tSamples8, CHART_TRIGGER_TYPE_POSITIVE_PULSE, TEST_LEVEL_8);
+    free(tSamples16);
+    free(tSamples8);
+    return tIsOK ? 0 : 1;
+}
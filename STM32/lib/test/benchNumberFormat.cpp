@@ -0,0 +1,81 @@
+/*
+ * benchNumberFormat.cpp
+ *
+ * Compares the speed of the BDNumberFormat functions with snprintf() for typical label and debug values.
+ *
+ * @date 17.10.2026
+ * @author agent
+ * agent@local
+ * @copyright LGPL v3 (http://www.gnu.org/licenses/lgpl.html)
+ * @version 1.0.0
+ */
+
+#include "TestUtils.h"
+#include "BDNumberFormat.cpp"
+
+#define NUMBER_OF_VALUES 4096
+#define NUMBER_OF_LOOPS 500
+
+static int32_t sValues[NUMBER_OF_VALUES];
+static float sFloatValues[NUMBER_OF_VALUES];
+static volatile uint32_t sCheckSum; // avoids that the compiler removes the loops
+
+static void printResult(const char *aName, double aFormatSeconds, double aSnprintfSeconds) {
+    double tCalls = (double) NUMBER_OF_VALUES * NUMBER_OF_LOOPS;
+    printf("%-28s %7.1f ns  snprintf %7.1f ns  speedup %.1f\n", aName, aFormatSeconds * 1e9 / tCalls,
+            aSnprintfSeconds * 1e9 / tCalls, aSnprintfSeconds / aFormatSeconds);
+}
+
+int main(void) {
+    char tBuffer[FORMAT_BUFFER_SIZE_FOR_FLOAT];
+    for (uint16_t i = 0; i < NUMBER_OF_VALUES; ++i) {
+        sValues[i] = (int32_t) (getRandom() % 200001) - 100000;
+        sFloatValues[i] = sValues[i] / 1000.0f;
+    }
+
+    double tStart = getSeconds();
+    for (uint16_t tLoop = 0; tLoop < NUMBER_OF_LOOPS; ++tLoop) {
+        for (uint16_t i = 0; i < NUMBER_OF_VALUES; ++i) {
+            sCheckSum += formatSignedDecimal(tBuffer, sizeof(tBuffer), sValues[i], 6);
+        }
+    }
+    double tFormatSeconds = getSeconds() - tStart;
+    tStart = getSeconds();
+    for (uint16_t tLoop = 0; tLoop < NUMBER_OF_LOOPS; ++tLoop) {
+        for (uint16_t i = 0; i < NUMBER_OF_VALUES; ++i) {
+            sCheckSum += snprintf(tBuffer, sizeof(tBuffer), "%6d", (int) sValues[i]);
+        }
+    }
+    printResult("formatSignedDecimal(\"%6d\")", tFormatSeconds, getSeconds() - tStart);
+
+    tStart = getSeconds();
+    for (uint16_t tLoop = 0; tLoop < NUMBER_OF_LOOPS; ++tLoop) {
+        for (uint16_t i = 0; i < NUMBER_OF_VALUES; ++i) {
+            sCheckSum += formatHex(tBuffer, sizeof(tBuffer), sValues[i], 4);
+        }
+    }
+    tFormatSeconds = getSeconds() - tStart;
+    tStart = getSeconds();
+    for (uint16_t tLoop = 0; tLoop < NUMBER_OF_LOOPS; ++tLoop) {
+        for (uint16_t i = 0; i < NUMBER_OF_VALUES; ++i) {
+            sCheckSum += snprintf(tBuffer, sizeof(tBuffer), "%.4X", (unsigned int) sValues[i]);
+        }
+    }
+    printResult("formatHex(\"%.4X\")", tFormatSeconds, getSeconds() - tStart);
+
+    tStart = getSeconds();
+    for (uint16_t tLoop = 0; tLoop < NUMBER_OF_LOOPS; ++tLoop) {
+        for (uint16_t i = 0; i < NUMBER_OF_VALUES; ++i) {
+            sCheckSum += formatFloat(tBuffer, sizeof(tBuffer), sFloatValues[i], 7, 2);
+        }
+    }
+    tFormatSeconds = getSeconds() - tStart;
+    tStart = getSeconds();
+    for (uint16_t tLoop = 0; tLoop < NUMBER_OF_LOOPS; ++tLoop) {
+        for (uint16_t i = 0; i < NUMBER_OF_VALUES; ++i) {
+            sCheckSum += snprintf(tBuffer, sizeof(tBuffer), "%7.2f", sFloatValues[i]);
+        }
+    }
+    printResult("formatFloat(\"%7.2f\")", tFormatSeconds, getSeconds() - tStart);
+    return 0;
+}
@@ -0,0 +1,32 @@
+/*
+ * AssertErrorAndMisc.h
+ *
+ * Stub for the host tests. Parameter errors are counted, so that tests can check them.
+ *
+ * @date 17.10.2026
+ * @author agent
+ * agent@local
+ * @copyright LGPL v3 (http://www.gnu.org/licenses/lgpl.html)
+ * @version 1.0.0
+ */
+
+#ifndef ASSERT_ERROR_AND_MISC_H_
+#define ASSERT_ERROR_AND_MISC_H_
+
+static unsigned long sNumberOfParamErrors = 0;
+
+static inline void assertParamMessage(bool aCondition, int aParam, const char *aMessage) {
+    (void) aParam;
+    (void) aMessage;
+    if (!aCondition) {
+        sNumberOfParamErrors++;
+    }
+}
+
+static inline void failParamMessage(int aParam, const char *aMessage) {
+    (void) aParam;
+    (void) aMessage;
+    sNumberOfParamErrors++;
+}
+
+#endif // ASSERT_ERROR_AND_MISC_H_
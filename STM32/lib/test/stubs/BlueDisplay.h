@@ -0,0 +1,154 @@
+/*
+ * BlueDisplay.h
+ *
+ * Stub for the host tests. Contains only the functions used by the graphics sources under test.
+ * Drawing to the local display does nothing, the host chart and rectangle list commands are recorded in sChartCalls,
+ * so that tests can check the bytes the host would get.
+ *
+ * @date 17.10.2026
+ * @author agent
+ * agent@local
+ * @copyright LGPL v3 (http://www.gnu.org/licenses/lgpl.html)
+ * @version 1.0.0
+ */
+
+#ifndef BLUEDISPLAY_H_
+#define BLUEDISPLAY_H_
+
+#include "Colors.h"
+#include "BlueDisplayProtocol.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#define DISPLAY_DEFAULT_HEIGHT  240
+#define DISPLAY_DEFAULT_WIDTH   320
+
+#define TEXT_SIZE_11 11
+#define TEXT_SIZE_11_WIDTH 7
+#define TEXT_SIZE_11_HEIGHT 12
+#define TEXT_SIZE_11_ASCEND 9
+#define TEXT_SIZE_11_DECEND 3
+
+#define COLOR_WHITE COLOR16_WHITE
+#define COLOR_BLACK COLOR16_BLACK
+#define COLOR_RED   COLOR16_RED
+#define COLOR_GREEN COLOR16_GREEN
+#define COLOR_BLUE  COLOR16_BLUE
+
+/*
+ * One recorded host chart command
+ */
+#define STUB_CHART_CALL_LINE      0
+#define STUB_CHART_CALL_MIN_MAX   1
+#define STUB_CHART_CALL_XY        2
+#define STUB_CHART_CALL_RECT_LIST 3
+#define STUB_MAX_CHART_CALLS      32
+#define STUB_MAX_CHART_DATA       1024
+struct StubChartCall {
+    uint8_t Type;
+    uint16_t XOffset;
+    uint16_t YOffset;
+    color16_t Color;
+    color16_t ClearBeforeColor;
+    uint8_t ChartIndex; // number of rectangles for STUB_CHART_CALL_RECT_LIST
+    uint16_t DataLength; // in byte, like the length of the data field the host reads
+    uint8_t Data[STUB_MAX_CHART_DATA];
+};
+
+static struct StubChartCall sChartCalls[STUB_MAX_CHART_CALLS];
+static uint8_t sNumberOfChartCalls = 0;
+static bool sIsBluetoothPaired = true;
+
+static inline bool USART_isBluetoothPaired(void) {
+    return sIsBluetoothPaired;
+}
+
+static inline void recordChartCall(uint8_t aType, uint16_t aXOffset, uint16_t aYOffset, color16_t aColor,
+        color16_t aClearBeforeColor, uint8_t aChartIndex, const uint8_t *aData, size_t aDataLength) {
+    if (sNumberOfChartCalls >= STUB_MAX_CHART_CALLS) {
+        return;
+    }
+    struct StubChartCall *tCall = &sChartCalls[sNumberOfChartCalls++];
+    tCall->Type = aType;
+    tCall->XOffset = aXOffset;
+    tCall->YOffset = aYOffset;
+    tCall->Color = aColor;
+    tCall->ClearBeforeColor = aClearBeforeColor;
+    tCall->ChartIndex = aChartIndex;
+    if (aDataLength > STUB_MAX_CHART_DATA) {
+        aDataLength = STUB_MAX_CHART_DATA;
+    }
+    tCall->DataLength = aDataLength;
+    memcpy(tCall->Data, aData, aDataLength);
+}
+
+class BlueDisplay {
+public:
+    BlueDisplay() {
+        mClearDisplayCount = 0;
+    }
+    uint16_t getDisplayWidth(void) {
+        return DISPLAY_DEFAULT_WIDTH;
+    }
+    uint16_t getDisplayHeight(void) {
+        return DISPLAY_DEFAULT_HEIGHT;
+    }
+    bool isClipActive(void) {
+        return false;
+    }
+    void selectLayer(uint8_t aLayer) {
+        (void) aLayer;
+    }
+    void clearLayer(uint8_t aLayer) {
+        (void) aLayer;
+    }
+    void scrollRectLeft(uint16_t, uint16_t, uint16_t, uint16_t, uint16_t, color16_t) {
+    }
+    void drawPixel(uint16_t, uint16_t, color16_t) {
+    }
+    void drawLineRel(uint16_t, uint16_t, uint16_t, uint16_t, color16_t) {
+    }
+    void drawLineFastOneX(uint16_t, uint16_t, uint16_t, color16_t) {
+    }
+    void fillRect(uint16_t, uint16_t, uint16_t, uint16_t, color16_t) {
+    }
+    void fillRectRel(uint16_t, uint16_t, uint16_t, uint16_t, color16_t) {
+    }
+    uint16_t drawText(uint16_t aXStart, uint16_t, const char *aStringPtr, uint16_t, color16_t, color16_t) {
+        return aXStart + strlen(aStringPtr) * TEXT_SIZE_11_WIDTH;
+    }
+    void drawChartGrid(uint16_t, uint16_t, uint16_t, uint16_t, uint8_t, uint8_t, uint8_t, uint8_t, color16_t, color16_t) {
+    }
+
+    void drawChartByteBuffer(uint16_t aXOffset, uint16_t aYOffset, color16_t aColor, color16_t aClearBeforeColor,
+            uint8_t aChartIndex, bool aDoDrawDirect, uint8_t *aByteBuffer, size_t aByteBufferLength) {
+        (void) aDoDrawDirect;
+        recordChartCall(STUB_CHART_CALL_LINE, aXOffset, aYOffset, aColor, aClearBeforeColor, aChartIndex, aByteBuffer,
+                aByteBufferLength);
+    }
+    void drawChartMinMaxByteBuffer(uint16_t aXOffset, uint16_t aYOffset, color16_t aColor, color16_t aClearBeforeColor,
+            uint8_t aChartIndex, uint8_t *aMinMaxByteBuffer, uint16_t aNumberOfColumns) {
+        recordChartCall(STUB_CHART_CALL_MIN_MAX, aXOffset, aYOffset, aColor, aClearBeforeColor, aChartIndex,
+                aMinMaxByteBuffer, 2 * aNumberOfColumns);
+    }
+    void drawChartXYByteBuffer(uint16_t aXOffset, uint16_t aYOffset, color16_t aColor, color16_t aClearBeforeColor,
+            uint8_t aChartIndex, uint8_t *aXYByteBuffer, uint16_t aNumberOfPoints) {
+        recordChartCall(STUB_CHART_CALL_XY, aXOffset, aYOffset, aColor, aClearBeforeColor, aChartIndex, aXYByteBuffer,
+                2 * aNumberOfPoints);
+    }
+
+    /*
+     * Records the data field like BlueDisplay::fillRectList() sends it, i.e. 4 little endian shorts for each rectangle
+     */
+    void fillRectList(uint16_t aXOffset, uint16_t aYOffset, color16_t aColor, uint16_t *aRectBuffer, uint8_t aNumberOfRects) {
+        recordChartCall(STUB_CHART_CALL_RECT_LIST, aXOffset, aYOffset, aColor, 0, aNumberOfRects, (uint8_t*) aRectBuffer,
+                aNumberOfRects * 4 * sizeof(uint16_t));
+    }
+
+    uint8_t mClearDisplayCount;
+};
+
+extern BlueDisplay BlueDisplay1;
+
+#endif // BLUEDISPLAY_H_
@@ -0,0 +1,30 @@
+/*
+ * Colors.h
+ *
+ * Stub for the host tests. Contains only the colors used by the library sources under test.
+ *
+ * @date 17.10.2026
+ * @author agent
+ * agent@local
+ * @copyright LGPL v3 (http://www.gnu.org/licenses/lgpl.html)
+ * @version 1.0.0
+ */
+
+#ifndef COLORS_H_
+#define COLORS_H_
+
+#include <stdint.h>
+
+typedef uint16_t color16_t;
+
+#define RGB(r,g,b) ((color16_t)((((r)&0xF8)<<8)|(((g)&0xFC)<<3)|((b)>>3)))
+
+#define COLOR16_WHITE     ((color16_t)0xFFFF)
+#define COLOR16_BLACK     ((color16_t)0x0001) // 0 is used as no color
+#define COLOR16_RED       ((color16_t)0xF800)
+#define COLOR16_GREEN     ((color16_t)0x07E0)
+#define COLOR16_BLUE      ((color16_t)0x001F)
+#define COLOR16_YELLOW    ((color16_t)0xFFE0)
+#define COLOR16_NO_BACKGROUND ((color16_t)0XFFFE)
+
+#endif // COLORS_H_
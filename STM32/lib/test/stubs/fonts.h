@@ -0,0 +1,33 @@
+/*
+ * fonts.h
+ *
+ * Stub for the host tests. Generated 8x8 glyphs, whose pattern depends on character and row,
+ * so that every character renders differently. Interface is the same as the real fonts.h.
+ *
+ * @date 17.10.2026
+ * @author agent
+ * agent@local
+ * @copyright LGPL v3 (http://www.gnu.org/licenses/lgpl.html)
+ * @version 1.0.0
+ */
+
+#ifndef FONTS_H_
+#define FONTS_H_
+
+#include <stdint.h>
+
+#define FONT_WIDTH 8
+#define FONT_HEIGHT 8
+#define FONT_START 0x20
+#define FONT_END 0x7E
+
+#define GLYPH_ROW(c, r) ((uint8_t) (((c) * 0x9D) ^ ((r) * 0x35)))
+#define GLYPH(c) GLYPH_ROW(c, 0), GLYPH_ROW(c, 1), GLYPH_ROW(c, 2), GLYPH_ROW(c, 3), \
+        GLYPH_ROW(c, 4), GLYPH_ROW(c, 5), GLYPH_ROW(c, 6), GLYPH_ROW(c, 7)
+#define GLYPHS_8(c) GLYPH(c), GLYPH(c + 1), GLYPH(c + 2), GLYPH(c + 3), GLYPH(c + 4), GLYPH(c + 5), GLYPH(c + 6), GLYPH(c + 7)
+
+static const uint8_t font_PGM[(FONT_END - FONT_START + 1) * FONT_HEIGHT] = { GLYPHS_8(0x20), GLYPHS_8(0x28), GLYPHS_8(0x30),
+        GLYPHS_8(0x38), GLYPHS_8(0x40), GLYPHS_8(0x48), GLYPHS_8(0x50), GLYPHS_8(0x58), GLYPHS_8(0x60), GLYPHS_8(0x68),
+        GLYPHS_8(0x70), GLYPH(0x78), GLYPH(0x79), GLYPH(0x7A), GLYPH(0x7B), GLYPH(0x7C), GLYPH(0x7D), GLYPH(0x7E) };
+
+#endif // FONTS_H_
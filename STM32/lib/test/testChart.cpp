@@ -0,0 +1,494 @@
+/*
+ * testChart.cpp
+ *
+ * Checks the data the Chart sends to the host, which is recorded by the BlueDisplay stub.
+ * The integer Y scaling must give exactly the same display values as the former float computation.
+ * The streaming LTTB must select the same values as a direct implementation, which has all input at once.
+ * X-Y data must be sent in chunks, which the host can clear together.
+ * The bar chart must send only the changed parts of the bars, as rectangle lists of 4 little endian shorts per rectangle.
+ * The envelope must erase the old min max of changed columns before drawing the new one, if it shrinks by decay.
+ *
+ * @date 17.10.2026
+ * @author agent
+ * agent@local
+ * @copyright LGPL v3 (http://www.gnu.org/licenses/lgpl.html)
+ * @version 1.0.0
+ */
+
+#include "TestUtils.h"
+#include "BDNumberFormat.cpp"
+#include "ChartLTTB.cpp"
+#include "Chart.cpp"
+#include "BarChart.cpp"
+
+#include <stdlib.h>
+#include <string.h>
+
+BlueDisplay BlueDisplay1;
+
+#define TEST_CHART_X 20
+#define TEST_CHART_Y 220
+#define TEST_CHART_WIDTH 300
+#define TEST_CHART_HEIGHT 200
+
+#define TEST_LTTB_MAX_INPUT 5000
+
+static int16_t sData[TEST_LTTB_MAX_INPUT];
+
+static float getRandomFactor(void) {
+    static const float sFactors[] = { 1.0, 0.2, 0.1, 3.0 / 4096, 5.0 / 1024, 2.5, 0.3 };
+    uint8_t tIndex = getRandom() % (sizeof(sFactors) / sizeof(sFactors[0]) + 1);
+    if (tIndex < sizeof(sFactors) / sizeof(sFactors[0])) {
+        return sFactors[tIndex];
+    }
+    return (getRandom() % 10000 + 1) / 1000.0;
+}
+
+/*
+ * Host byte of the former float computation, see Chart::getYDisplayFactorAndOffset() of version 3
+ */
+static uint8_t getReferenceByte(float aYDisplayFactor, int aYOffset, int16_t aYDisplayOffset, int aValue) {
+    int tDisplayValue = (int) (aYDisplayFactor * (aValue - aYOffset)) + aYDisplayOffset;
+    if (tDisplayValue < 0) {
+        tDisplayValue = 0;
+    }
+    if (tDisplayValue > TEST_CHART_HEIGHT - 1) {
+        tDisplayValue = TEST_CHART_HEIGHT - 1;
+    }
+    return (TEST_CHART_HEIGHT - 1) - tDisplayValue;
+}
+
+static void fillRandomData(int aCenter, int aRange) {
+    for (int i = 0; i < TEST_LTTB_MAX_INPUT; ++i) {
+        int tValue = aCenter + (int) (getRandom() % (2 * aRange + 1)) - aRange;
+        if (tValue > INT16_MAX) {
+            tValue = INT16_MAX;
+        }
+        if (tValue < INT16_MIN) {
+            tValue = INT16_MIN;
+        }
+        sData[i] = tValue;
+    }
+}
+
+/*
+ * Random label, factor and grid configurations with data around the visible range
+ */
+static void testYScaling(void) {
+    Chart tChart;
+    for (int i = 0; i < 20000; ++i) {
+        uint8_t tGridYSpacing = getRandom() % 60 + 5;
+        float tYFactor = getRandomFactor();
+        bool tIsIntLabel = (i & 1) == 0;
+        float tYDisplayFactor;
+        int tYOffset;
+        tChart.initChart(TEST_CHART_X, TEST_CHART_Y, TEST_CHART_WIDTH, TEST_CHART_HEIGHT, 2, true, 30, tGridYSpacing);
+        if (tIsIntLabel) {
+            int tStart = (int) (getRandom() % 2001) - 1000;
+            int tIncrement = getRandom() % 500 + 1;
+            tChart.initYLabelInt(tStart, tIncrement, tYFactor, 4);
+            tYDisplayFactor = (tYFactor * tGridYSpacing * 1.0f) / tIncrement;
+            tYOffset = tStart / tYFactor;
+        } else {
+            float tStart = ((int) (getRandom() % 2001) - 1000) / 10.0;
+            float tIncrement = (getRandom() % 500 + 1) / 100.0;
+            tChart.initYLabelFloat(tStart, tIncrement, tYFactor, 5, 1);
+            tYDisplayFactor = (tYFactor * tGridYSpacing * 1.0f) / tIncrement;
+            tYOffset = tStart / tYFactor;
+        }
+        // data from below the chart to above the chart
+        int tVisibleRange = (TEST_CHART_HEIGHT / tYDisplayFactor) + 1;
+        fillRandomData(tYOffset + (tVisibleRange / 2), tVisibleRange);
+
+        sNumberOfChartCalls = 0;
+        tChart.drawChartData(sData, TEST_CHART_WIDTH, CHART_MODE_LINE);
+        CHECK(sNumberOfChartCalls == 1 && sChartCalls[0].DataLength == TEST_CHART_WIDTH, "%u calls", sNumberOfChartCalls);
+        for (int j = 0; j < TEST_CHART_WIDTH; ++j) {
+            uint8_t tExpected = getReferenceByte(tYDisplayFactor, tYOffset, 0, sData[j]);
+            CHECK(sChartCalls[0].Data[j] == tExpected, "factor %.9g offset %d value %d: %u, expected %u",
+                    (double) tYDisplayFactor, tYOffset, sData[j], sChartCalls[0].Data[j], tExpected);
+        }
+    }
+}
+
+/*
+ * The trace Y scale is part of the integer factor, the trace display offset is added after scaling
+ */
+static void testTraceScaling(void) {
+    Chart tChart;
+    tChart.initChart(TEST_CHART_X, TEST_CHART_Y, TEST_CHART_WIDTH, TEST_CHART_HEIGHT, 2, true, 30, 20);
+    tChart.initYLabelInt(0, 100, 0.5, 4);
+    tChart.setHostChartIndex(4);
+    for (int i = 0; i < 2000; ++i) {
+        float tYScale = (getRandom() % 400 + 1) / 100.0;
+        int16_t tYDisplayOffset = (int) (getRandom() % 101) - 50;
+        tChart.initTrace(1, COLOR16_RED, tYScale, tYDisplayOffset, 0);
+        fillRandomData(0, 1000);
+        tChart.setTraceData(1, sData, TEST_CHART_WIDTH);
+        sNumberOfChartCalls = 0;
+        tChart.drawChangedTraces();
+        CHECK(sNumberOfChartCalls == 1 && sChartCalls[0].ChartIndex == 5, "trace 1 uses host chart index %u, expected 5",
+                sChartCalls[0].ChartIndex);
+        float tYDisplayFactor = (0.5f * 20 * tYScale) / 100;
+        for (int j = 0; j < TEST_CHART_WIDTH; ++j) {
+            uint8_t tExpected = getReferenceByte(tYDisplayFactor, 0, tYDisplayOffset, sData[j]);
+            CHECK(sChartCalls[0].Data[j] == tExpected, "scale %.9g value %d: %u, expected %u", (double) tYScale, sData[j],
+                    sChartCalls[0].Data[j], tExpected);
+        }
+    }
+}
+
+/*
+ * Direct LTTB with the bucket boundaries of ChartLTTB. The average of the next bucket is kept as sums,
+ * so that the areas are exact and ties are resolved like in ChartLTTB.
+ */
+static uint16_t getReferenceLTTB(const int16_t *aInput, uint32_t aNumberOfInputValues, uint16_t aNumberOfOutputValues,
+        int16_t *aOutput) {
+    if (aNumberOfInputValues <= aNumberOfOutputValues) {
+        memcpy(aOutput, aInput, aNumberOfInputValues * sizeof(int16_t));
+        return aNumberOfInputValues;
+    }
+    if (aNumberOfOutputValues < 3) {
+        if (aNumberOfOutputValues > 0) {
+            aOutput[0] = aInput[0];
+        }
+        if (aNumberOfOutputValues > 1) {
+            aOutput[1] = aInput[aNumberOfInputValues - 1];
+        }
+        return aNumberOfOutputValues;
+    }
+    int64_t tNumberOfMiddleValues = aNumberOfInputValues - 2;
+    int64_t tNumberOfBuckets = aNumberOfOutputValues - 2;
+    uint16_t tOutputIndex = 0;
+    aOutput[tOutputIndex++] = aInput[0];
+    int64_t tXA = 0;
+    int64_t tYA = aInput[0];
+    for (int64_t b = 0; b < tNumberOfBuckets; ++b) {
+        int64_t tStart = 1 + ((b * tNumberOfMiddleValues) + tNumberOfBuckets - 1) / tNumberOfBuckets;
+        int64_t tEnd = 1 + (((b + 1) * tNumberOfMiddleValues) + tNumberOfBuckets - 1) / tNumberOfBuckets;
+        int64_t tNextEnd = 1 + (((b + 2) * tNumberOfMiddleValues) + tNumberOfBuckets - 1) / tNumberOfBuckets;
+        if (b == tNumberOfBuckets - 1) {
+            tNextEnd = aNumberOfInputValues; // the next bucket of the last bucket is the last value
+        }
+        int64_t tNextXSum = 0;
+        int64_t tNextYSum = 0;
+        for (int64_t i = tEnd; i < tNextEnd; ++i) {
+            tNextXSum += i;
+            tNextYSum += aInput[i];
+        }
+        int64_t tNextCount = tNextEnd - tEnd;
+        uint64_t tMaxArea = 0;
+        int64_t tMaxX = tStart;
+        for (int64_t i = tStart; i < tEnd; ++i) {
+            int64_t tArea = (i - tXA) * (tNextYSum - tYA * tNextCount) - (aInput[i] - tYA) * (tNextXSum - tXA * tNextCount);
+            uint64_t tAbsoluteArea = tArea < 0 ? -tArea : tArea;
+            if (tAbsoluteArea > tMaxArea) {
+                tMaxArea = tAbsoluteArea;
+                tMaxX = i;
+            }
+        }
+        tXA = tMaxX;
+        tYA = aInput[tMaxX];
+        aOutput[tOutputIndex++] = tYA;
+    }
+    aOutput[tOutputIndex++] = aInput[aNumberOfInputValues - 1];
+    return tOutputIndex;
+}
+
+/*
+ * Random sizes, including less than 3 output values and not more input than output values.
+ * Input is added in random chunks.
+ */
+static void testLTTB(void) {
+    static int16_t sOutput[TEST_LTTB_MAX_INPUT];
+    static int16_t sReferenceOutput[TEST_LTTB_MAX_INPUT];
+    static int16_t sBucketBuffer[2 * TEST_LTTB_MAX_INPUT];
+    for (int i = 0; i < 20000; ++i) {
+        uint32_t tNumberOfInputValues = getRandom() % TEST_LTTB_MAX_INPUT + 1;
+        uint16_t tNumberOfOutputValues = getRandom() % 300;
+        if ((i & 3) == 0) {
+            // flat and step data have many equal areas
+            fillRandomData(0, i & 4);
+        } else {
+            fillRandomData(0, 32767);
+        }
+        ChartLTTB tLTTB;
+        CHECK(ChartLTTB::getBucketBufferSize(tNumberOfInputValues, tNumberOfOutputValues) <= 2 * TEST_LTTB_MAX_INPUT,
+                "bucket buffer size");
+        CHECK(tLTTB.init(tNumberOfInputValues, tNumberOfOutputValues, sOutput, sBucketBuffer), "init(%u, %u)",
+                tNumberOfInputValues, tNumberOfOutputValues);
+        uint32_t tIndex = 0;
+        while (tIndex < tNumberOfInputValues) {
+            uint32_t tChunkSize = getRandom() % 700 + 1;
+            if (tChunkSize > tNumberOfInputValues - tIndex) {
+                tChunkSize = tNumberOfInputValues - tIndex;
+            }
+            tLTTB.addValues(&sData[tIndex], tChunkSize);
+            tIndex += tChunkSize;
+        }
+        uint16_t tNumberOfReferenceValues = getReferenceLTTB(sData, tNumberOfInputValues, tNumberOfOutputValues,
+                sReferenceOutput);
+        CHECK(tLTTB.getNumberOfOutputValues() == tNumberOfReferenceValues, "%u -> %u: %u values, expected %u",
+                tNumberOfInputValues, tNumberOfOutputValues, tLTTB.getNumberOfOutputValues(), tNumberOfReferenceValues);
+        CHECK(memcmp(sOutput, sReferenceOutput, tNumberOfReferenceValues * sizeof(int16_t)) == 0, "%u -> %u: values differ",
+                tNumberOfInputValues, tNumberOfOutputValues);
+    }
+}
+
+/*
+ * Chart with X compression by LTTB must draw all columns, including the last value
+ */
+static void testChartLTTB(void) {
+    static int16_t sColumns[TEST_CHART_WIDTH];
+    Chart tChart;
+    tChart.initChart(TEST_CHART_X, TEST_CHART_Y, TEST_CHART_WIDTH, TEST_CHART_HEIGHT, 2, true, 30, 20);
+    tChart.initYLabelInt(0, 100, 1.0, 4);
+    tChart.setXLTTB(true);
+    for (int tValuesPerColumn = 2; tValuesPerColumn <= 16; ++tValuesPerColumn) {
+        tChart.setXScaleFactor(-tValuesPerColumn, false);
+        uint16_t tNumberOfColumns = getRandom() % TEST_CHART_WIDTH + 1;
+        uint32_t tNumberOfValues = tNumberOfColumns * tValuesPerColumn;
+        fillRandomData(500, 500);
+        sNumberOfChartCalls = 0;
+        tChart.drawChartData(sData, tNumberOfValues, CHART_MODE_LINE);
+        CHECK(sNumberOfChartCalls == 1 && sChartCalls[0].DataLength == tNumberOfColumns, "%u columns, expected %u",
+                sChartCalls[0].DataLength, tNumberOfColumns);
+        if (tNumberOfColumns < 3
+                || ChartLTTB::getBucketBufferSize(tNumberOfValues, tNumberOfColumns) > CHART_LTTB_BUCKET_BUFFER_SIZE) {
+            // columns are averaged
+            continue;
+        }
+        getReferenceLTTB(sData, tNumberOfValues, tNumberOfColumns, sColumns);
+        for (int j = 0; j < tNumberOfColumns; ++j) {
+            uint8_t tExpected = getReferenceByte(0.2f, 0, 0, sColumns[j]);
+            CHECK(sChartCalls[0].Data[j] == tExpected, "%d values per column, column %d: %u, expected %u", tValuesPerColumn,
+                    j, sChartCalls[0].Data[j], tExpected);
+        }
+    }
+}
+
+/*
+ * X-Y points are sent in chunks. Only the first chunk clears, the host adds the other chunks to the points to clear.
+ */
+static void testChartXYChunks(void) {
+    static int16_t sXData[3 * CHART_MAX_HOST_XY_POINTS];
+    Chart tChart;
+    tChart.initChart(TEST_CHART_X, TEST_CHART_Y, 250, TEST_CHART_HEIGHT, 2, true, 25, 20);
+    tChart.initXLabelInt(0, 10, 1, 3);
+    tChart.initYLabelInt(0, 100, 1.0, 4);
+    tChart.initChartColors(COLOR16_RED, COLOR16_BLACK, COLOR16_BLUE, COLOR16_BLACK, COLOR16_WHITE);
+    tChart.setClearDataBeforeDraw(true);
+    tChart.setHostChartIndex(3);
+    uint16_t tNumberOfPoints = (2 * CHART_MAX_HOST_XY_POINTS) + 10;
+    for (int i = 0; i < tNumberOfPoints; ++i) {
+        sXData[i] = i % 100;
+    }
+    fillRandomData(500, 500);
+    sNumberOfChartCalls = 0;
+    tChart.drawChartDataXY(sXData, sData, tNumberOfPoints);
+    CHECK(sNumberOfChartCalls == 3, "%u chunks, expected 3", sNumberOfChartCalls);
+    uint32_t tNumberOfSentPoints = 0;
+    for (int i = 0; i < sNumberOfChartCalls; ++i) {
+        CHECK(sChartCalls[i].Type == STUB_CHART_CALL_XY && sChartCalls[i].ChartIndex == 3, "chunk %d", i);
+        CHECK((sChartCalls[i].ClearBeforeColor != 0) == (i == 0), "chunk %d has clear color 0x%X", i,
+                sChartCalls[i].ClearBeforeColor);
+        tNumberOfSentPoints += sChartCalls[i].DataLength / 2;
+    }
+    CHECK(tNumberOfSentPoints == tNumberOfPoints, "%u points sent, expected %u", tNumberOfSentPoints, tNumberOfPoints);
+}
+
+/*
+ * Checks that all aNumberOfColumns min max pairs of a recorded command are aTop and aBottom
+ */
+static void checkMinMaxCall(const struct StubChartCall *aCall, color16_t aColor, uint16_t aNumberOfColumns, uint8_t aTop,
+        uint8_t aBottom) {
+    CHECK(aCall->Type == STUB_CHART_CALL_MIN_MAX && aCall->Color == aColor && aCall->DataLength == 2 * aNumberOfColumns,
+            "type %u color 0x%X %u byte", aCall->Type, aCall->Color, aCall->DataLength);
+    for (uint16_t i = 0; i < aNumberOfColumns; ++i) {
+        if (aCall->Data[2 * i] != aTop || aCall->Data[(2 * i) + 1] != aBottom) {
+            CHECK(false, "column %u: %u to %u, expected %u to %u", i, aCall->Data[2 * i], aCall->Data[(2 * i) + 1], aTop,
+                    aBottom);
+            return;
+        }
+    }
+}
+
+/*
+ * 1 pixel per count. Min max values are rows relative to the top of the chart.
+ */
+static void testChartEnvelope(void) {
+    static uint8_t sEnvelopeBuffer[2 * TEST_CHART_WIDTH];
+    Chart tChart;
+    tChart.initChart(TEST_CHART_X, TEST_CHART_Y, TEST_CHART_WIDTH, TEST_CHART_HEIGHT, 2, true, 30, 20);
+    tChart.initYLabelInt(0, 20, 1.0, 3);
+    tChart.initChartColors(COLOR16_RED, COLOR16_BLACK, COLOR16_BLUE, COLOR16_BLACK, COLOR16_WHITE);
+    CHECK(tChart.initEnvelope(sEnvelopeBuffer, 5), "initEnvelope() failed");
+    uint8_t tXAxisRow = TEST_CHART_HEIGHT - 1;
+
+    // first trace into empty envelope, nothing to erase
+    for (int i = 0; i < TEST_CHART_WIDTH; ++i) {
+        sData[i] = 50;
+    }
+    sNumberOfChartCalls = 0;
+    tChart.drawChartData(sData, TEST_CHART_WIDTH, CHART_MODE_ENVELOPE);
+    CHECK(sNumberOfChartCalls == 1, "%u commands, expected 1", sNumberOfChartCalls);
+    checkMinMaxCall(&sChartCalls[0], COLOR16_RED, TEST_CHART_WIDTH, tXAxisRow - 50, tXAxisRow - 50);
+
+    // lower trace, maximum decays by 5, old envelope is erased before
+    for (int i = 0; i < TEST_CHART_WIDTH; ++i) {
+        sData[i] = 10;
+    }
+    sNumberOfChartCalls = 0;
+    tChart.drawChartData(sData, TEST_CHART_WIDTH, CHART_MODE_ENVELOPE);
+    CHECK(sNumberOfChartCalls == 2, "%u commands, expected 2", sNumberOfChartCalls);
+    checkMinMaxCall(&sChartCalls[0], COLOR16_WHITE, TEST_CHART_WIDTH, tXAxisRow - 50, tXAxisRow - 50);
+    checkMinMaxCall(&sChartCalls[1], COLOR16_RED, TEST_CHART_WIDTH, tXAxisRow - 45, tXAxisRow - 10);
+
+    // only the changed columns are sent, growing needs no erase
+    sData[100] = 60;
+    sData[102] = 0;
+    CHECK(tChart.initEnvelope(sEnvelopeBuffer, 0), "initEnvelope() failed");
+    sNumberOfChartCalls = 0;
+    tChart.drawChartData(sData, TEST_CHART_WIDTH, CHART_MODE_ENVELOPE);
+    sData[101] = 5;
+    sNumberOfChartCalls = 0;
+    tChart.drawChartData(sData, TEST_CHART_WIDTH, CHART_MODE_ENVELOPE);
+    CHECK(sNumberOfChartCalls == 1 && sChartCalls[0].DataLength == 2 && sChartCalls[0].XOffset == TEST_CHART_X + 101
+            && sChartCalls[0].Data[0] == tXAxisRow - 10 && sChartCalls[0].Data[1] == tXAxisRow - 5,
+            "%u commands, %u byte at %u", sNumberOfChartCalls, sChartCalls[0].DataLength, sChartCalls[0].XOffset);
+    sNumberOfChartCalls = 0;
+    tChart.drawChartData(sData, TEST_CHART_WIDTH, CHART_MODE_ENVELOPE);
+    CHECK(sNumberOfChartCalls == 0, "%u commands for unchanged envelope", sNumberOfChartCalls);
+}
+
+/*
+ * @return value aValueIndex (0 to 3 for x, y, width and height) of rectangle aRectIndex, decoded like the host does
+ */
+static uint16_t getRectValue(const struct StubChartCall *aCall, uint8_t aRectIndex, uint8_t aValueIndex) {
+    const uint8_t *tValuePointer = &aCall->Data[(8 * aRectIndex) + (2 * aValueIndex)];
+    return tValuePointer[0] | (tValuePointer[1] << 8);
+}
+
+/*
+ * Checks one rectangle list command with a rectangle of aHeight[i] pixel for each bin with aHeight[i] != 0.
+ * Rectangles of growing bars end at aTop[i] + aHeight[i] - 1, of shrinking bars they start at aTop[i].
+ */
+static void checkRectList(const struct StubChartCall *aCall, color16_t aColor, const int *aTop, const int *aHeight,
+        uint16_t aNumberOfBins, uint16_t aBarPitch, uint16_t aBarWidth) {
+    CHECK(aCall->Type == STUB_CHART_CALL_RECT_LIST && aCall->Color == aColor, "type %u color 0x%X", aCall->Type,
+            aCall->Color);
+    CHECK(aCall->XOffset == TEST_CHART_X && aCall->YOffset == TEST_CHART_Y - (TEST_CHART_HEIGHT - 1), "offset %u, %u",
+            aCall->XOffset, aCall->YOffset);
+    CHECK(aCall->DataLength == aCall->ChartIndex * 4 * sizeof(uint16_t), "data length %u for %u rectangles",
+            aCall->DataLength, aCall->ChartIndex);
+    uint8_t tRectIndex = 0;
+    for (uint16_t i = 0; i < aNumberOfBins; ++i) {
+        if (aHeight[i] == 0) {
+            continue;
+        }
+        if (tRectIndex >= aCall->ChartIndex) {
+            CHECK(false, "bin %u has no rectangle", i);
+            return;
+        }
+        CHECK(getRectValue(aCall, tRectIndex, 0) == 1 + (i * aBarPitch) && getRectValue(aCall, tRectIndex, 2) == aBarWidth,
+                "bin %u: x %u width %u", i, getRectValue(aCall, tRectIndex, 0), getRectValue(aCall, tRectIndex, 2));
+        CHECK(getRectValue(aCall, tRectIndex, 1) == aTop[i] && getRectValue(aCall, tRectIndex, 3) == aHeight[i],
+                "bin %u: y %u height %u, expected %d %d", i, getRectValue(aCall, tRectIndex, 1),
+                getRectValue(aCall, tRectIndex, 3), aTop[i], aHeight[i]);
+        tRectIndex++;
+    }
+    CHECK(tRectIndex == aCall->ChartIndex, "%u rectangles, expected %u", aCall->ChartIndex, tRectIndex);
+}
+
+/*
+ * 10 counts per grid line of 20 pixel, i.e. 2 pixel per count. The X axis is at row TEST_CHART_HEIGHT - 1 of the chart.
+ */
+static void testBarChart(void) {
+    static uint16_t sBinCounts[40];
+    static uint16_t sBarHeights[40];
+    int tTop[40];
+    int tHeight[40];
+    BarChart tBarChart;
+    tBarChart.initChart(TEST_CHART_X, TEST_CHART_Y, TEST_CHART_WIDTH, TEST_CHART_HEIGHT, 2, true, 30, 20);
+    tBarChart.initYLabelInt(0, 10, 1.0, 3);
+    tBarChart.initChartColors(COLOR16_RED, COLOR16_BLACK, COLOR16_BLUE, COLOR16_BLACK, COLOR16_WHITE);
+    tBarChart.setBarColor(COLOR16_GREEN);
+    CHECK(tBarChart.initBins(sBinCounts, sBarHeights, 10, 0, 10), "initBins() failed");
+    uint16_t tBarPitch = (TEST_CHART_WIDTH - 1) / 10;
+    uint16_t tXAxisRow = TEST_CHART_HEIGHT - 1;
+
+    // bin i gets i + 1 samples
+    for (int i = 0; i < 10; ++i) {
+        for (int j = 0; j <= i; ++j) {
+            sData[j] = (i * 10) + (j % 10);
+        }
+        tBarChart.addSamples(sData, i + 1);
+        tTop[i] = tXAxisRow - (2 * (i + 1));
+        tHeight[i] = 2 * (i + 1);
+    }
+    sNumberOfChartCalls = 0;
+    CHECK(tBarChart.drawChangedBars(), "bars clipped");
+    CHECK(sNumberOfChartCalls == 1, "%u commands, expected 1", sNumberOfChartCalls);
+    checkRectList(&sChartCalls[0], COLOR16_GREEN, tTop, tHeight, 10, tBarPitch, tBarPitch - 1);
+    // one FILL_RECT_LIST command: 10 rectangles of 8 byte
+    CHECK(sChartCalls[0].DataLength == 80, "data field of %u byte, expected 80", sChartCalls[0].DataLength);
+
+    // only the grown part of bin 0 and 9 is sent, values out of range are counted in the first and last bin
+    static const int16_t sOutOfRange[] = { -100, -1, 0, 1000 };
+    tBarChart.addSamples(sOutOfRange, 4);
+    for (int i = 0; i < 10; ++i) {
+        tHeight[i] = 0;
+    }
+    tTop[0] = tXAxisRow - 8;
+    tHeight[0] = 6;
+    tTop[9] = tXAxisRow - 22;
+    tHeight[9] = 2;
+    sNumberOfChartCalls = 0;
+    tBarChart.drawChangedBars();
+    CHECK(sNumberOfChartCalls == 1, "%u commands, expected 1", sNumberOfChartCalls);
+    checkRectList(&sChartCalls[0], COLOR16_GREEN, tTop, tHeight, 10, tBarPitch, tBarPitch - 1);
+
+    // clearing removes all bars with the background color
+    tBarChart.clearBins();
+    for (int i = 0; i < 10; ++i) {
+        tHeight[i] = 2 * (i + 1);
+    }
+    tHeight[0] = 8;
+    tHeight[9] = 22;
+    for (int i = 0; i < 10; ++i) {
+        tTop[i] = tXAxisRow - tHeight[i];
+    }
+    sNumberOfChartCalls = 0;
+    tBarChart.drawChangedBars();
+    CHECK(sNumberOfChartCalls == 1, "%u commands, expected 1", sNumberOfChartCalls);
+    checkRectList(&sChartCalls[0], COLOR16_WHITE, tTop, tHeight, 10, tBarPitch, tBarPitch - 1);
+    sNumberOfChartCalls = 0;
+    tBarChart.drawChangedBars();
+    CHECK(sNumberOfChartCalls == 0, "%u commands for unchanged bars", sNumberOfChartCalls);
+
+    // more changed bars than fit in one command
+    CHECK(tBarChart.initBins(sBinCounts, sBarHeights, 40, 0, 1), "initBins() failed");
+    for (int i = 0; i < 40; ++i) {
+        sData[i] = i;
+    }
+    tBarChart.addSamples(sData, 40);
+    sNumberOfChartCalls = 0;
+    tBarChart.drawChangedBars();
+    CHECK(sNumberOfChartCalls == 2 && sChartCalls[0].ChartIndex == BAR_CHART_MAX_RECTS_PER_COMMAND
+            && sChartCalls[1].ChartIndex == 40 - BAR_CHART_MAX_RECTS_PER_COMMAND, "%u commands", sNumberOfChartCalls);
+    for (int i = 0; i < sNumberOfChartCalls; ++i) {
+        CHECK(sChartCalls[i].DataLength == sChartCalls[i].ChartIndex * 8, "command %d has %u byte for %u rectangles", i,
+                sChartCalls[i].DataLength, sChartCalls[i].ChartIndex);
+    }
+}
+
+int main() {
+    testYScaling();
+    testTraceScaling();
+    testLTTB();
+    testChartLTTB();
+    testChartXYChunks();
+    testChartEnvelope();
+    testBarChart();
+    return printCheckSummary();
+}
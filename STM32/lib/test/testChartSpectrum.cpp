@@ -0,0 +1,147 @@
+/*
+ * testChartSpectrum.cpp
+ *
+ * Compares the fixed point FFT of ChartSpectrum with a double precision DFT divided by the FFT size,
+ * and the log magnitude with 100 * log10(re^2 + im^2), which is 20 * log10(magnitude) in 1/10 dB.
+ * The spectrum of a sine must have its peak at the bin of the sine and must be sent to the host with one byte per bin.
+ *
+ * @date 17.10.2026
+ * @author agent
+ * agent@local
+ * @copyright LGPL v3 (http://www.gnu.org/licenses/lgpl.html)
+ * @version 1.0.0
+ */
+
+#include "TestUtils.h"
+#include "BDNumberFormat.cpp"
+#include "ChartLTTB.cpp"
+#include "Chart.cpp"
+#include "ChartSpectrum.cpp"
+
+#include <math.h>
+#include <stdlib.h>
+
+BlueDisplay BlueDisplay1;
+
+/*
+ * Each of the log2(N) stages truncates once, so the error grows with the number of stages
+ */
+#define TEST_FFT_MAX_ERROR(aFFTSize) (log2((double) (aFFTSize)) + 1)
+#define TEST_LOG_MAGNITUDE_MAX_ERROR 1.0 // 1/10 dB
+
+static int16_t sReal[CHART_SPECTRUM_MAX_FFT_SIZE];
+static int16_t sImaginary[CHART_SPECTRUM_MAX_FFT_SIZE];
+static double sReferenceReal[CHART_SPECTRUM_MAX_FFT_SIZE];
+static double sReferenceImaginary[CHART_SPECTRUM_MAX_FFT_SIZE];
+
+static void computeReferenceDFT(const int16_t *aReal, const int16_t *aImaginary, uint16_t aFFTSize) {
+    for (uint16_t k = 0; k < aFFTSize; ++k) {
+        double tReal = 0;
+        double tImaginary = 0;
+        for (uint16_t n = 0; n < aFFTSize; ++n) {
+            double tAngle = -2 * M_PI * (((uint32_t) k * n) % aFFTSize) / aFFTSize;
+            tReal += (aReal[n] * cos(tAngle)) - (aImaginary[n] * sin(tAngle));
+            tImaginary += (aReal[n] * sin(tAngle)) + (aImaginary[n] * cos(tAngle));
+        }
+        sReferenceReal[k] = tReal / aFFTSize;
+        sReferenceImaginary[k] = tImaginary / aFFTSize;
+    }
+}
+
+static void testInit(void) {
+    ChartSpectrum tSpectrum;
+    CHECK(!tSpectrum.init(CHART_SPECTRUM_MIN_FFT_SIZE / 2, sReal, sImaginary, false), "FFT size too small accepted");
+    CHECK(!tSpectrum.init(CHART_SPECTRUM_MAX_FFT_SIZE * 2, sReal, sImaginary, false), "FFT size too big accepted");
+    CHECK(!tSpectrum.init(48, sReal, sImaginary, false), "FFT size 48 accepted");
+    CHECK(tSpectrum.init(64, sReal, sImaginary, false) && tSpectrum.getNumberOfBins() == 32, "FFT size 64");
+}
+
+static void testSine(void) {
+    for (uint16_t i = 0; i < CHART_SPECTRUM_SINE_TABLE_PERIOD; ++i) {
+        double tExpected = 32767 * sin(2 * M_PI * i / CHART_SPECTRUM_SINE_TABLE_PERIOD);
+        CHECK(fabs(ChartSpectrum::getSine(i) - tExpected) <= 0.5, "getSine(%u) is %d, expected %.1f", i,
+                ChartSpectrum::getSine(i), tExpected);
+    }
+}
+
+/*
+ * Random complex input of full scale and of small amplitude for all FFT sizes
+ */
+static void testFFT(void) {
+    for (uint16_t tFFTSize = CHART_SPECTRUM_MIN_FFT_SIZE; tFFTSize <= CHART_SPECTRUM_MAX_FFT_SIZE; tFFTSize <<= 1) {
+        double tMaxError = 0;
+        for (int tLoop = 0; tLoop < 4; ++tLoop) {
+            int32_t tAmplitude = (tLoop & 1) ? 32767 : 200;
+            for (uint16_t i = 0; i < tFFTSize; ++i) {
+                sReal[i] = (int32_t) (getRandom() % (2 * tAmplitude + 1)) - tAmplitude;
+                sImaginary[i] = (tLoop & 2) ? (int32_t) (getRandom() % (2 * tAmplitude + 1)) - tAmplitude : 0;
+            }
+            computeReferenceDFT(sReal, sImaginary, tFFTSize);
+            ChartSpectrum::computeFFT(sReal, sImaginary, tFFTSize);
+            for (uint16_t k = 0; k < tFFTSize; ++k) {
+                double tError = fmax(fabs(sReal[k] - sReferenceReal[k]), fabs(sImaginary[k] - sReferenceImaginary[k]));
+                tMaxError = fmax(tMaxError, tError);
+            }
+        }
+        CHECK(tMaxError <= TEST_FFT_MAX_ERROR(tFFTSize), "FFT size %u has error %.2f, expected <= %.2f", tFFTSize,
+                tMaxError, TEST_FFT_MAX_ERROR(tFFTSize));
+    }
+}
+
+static void testLogMagnitude(void) {
+    for (int i = 0; i < 200000; ++i) {
+        // values of all magnitudes
+        int16_t tReal = (int16_t) getRandom() >> (getRandom() % 16);
+        int16_t tImaginary = (int16_t) getRandom() >> (getRandom() % 16);
+        double tSquare = ((double) tReal * tReal) + ((double) tImaginary * tImaginary);
+        double tExpected = (tSquare == 0) ? 0 : 100 * log10(tSquare);
+        int16_t tLogMagnitude = ChartSpectrum::getLogMagnitude(tReal, tImaginary);
+        CHECK(fabs(tLogMagnitude - tExpected) <= TEST_LOG_MAGNITUDE_MAX_ERROR, "getLogMagnitude(%d, %d) is %d, expected %.2f",
+                tReal, tImaginary, tLogMagnitude, tExpected);
+    }
+}
+
+/*
+ * A full scale sine gives a bin of half scale, which is 20 * log10(16384) = 84.3 dB.
+ * Without window all other bins are at the rounding noise, with Hann window the neighbor bins get -6 dB.
+ */
+static void testSpectrum(void) {
+    ChartSpectrum tSpectrum;
+    for (int tUseHannWindow = 0; tUseHannWindow < 2; ++tUseHannWindow) {
+        uint16_t tFFTSize = 256;
+        tSpectrum.init(tFFTSize, sReal, sImaginary, tUseHannWindow);
+        for (uint16_t tSineBin = 2; tSineBin < tFFTSize / 2 - 1; tSineBin += 9) {
+            int16_t *tSamples = tSpectrum.getSampleBuffer();
+            for (uint16_t i = 0; i < tFFTSize; ++i) {
+                tSamples[i] = ChartSpectrum::getSine(i * tSineBin * (CHART_SPECTRUM_SINE_TABLE_PERIOD / tFFTSize));
+            }
+            tSpectrum.computeSpectrum();
+            double tExpectedPeak = 20 * log10(tUseHannWindow ? 8192 : 16384) * 10;
+            CHECK(fabs(tSamples[tSineBin] - tExpectedPeak) <= 10, "Hann %d, bin %u: peak %d, expected %.0f", tUseHannWindow,
+                    tSineBin, tSamples[tSineBin], tExpectedPeak);
+            for (uint16_t k = 0; k < tSpectrum.getNumberOfBins(); ++k) {
+                if (abs(k - tSineBin) > tUseHannWindow) {
+                    CHECK(tSamples[k] < tSamples[tSineBin] - 500, "Hann %d, sine bin %u: bin %u is %d", tUseHannWindow,
+                            tSineBin, k, tSamples[k]);
+                }
+            }
+        }
+    }
+
+    Chart tChart;
+    tChart.initChart(20, 220, 300, 200, 2, true, 30, 20);
+    tChart.initYLabelInt(0, 100, 0.2, 4);
+    sNumberOfChartCalls = 0;
+    tSpectrum.drawSpectrum(&tChart, CHART_MODE_LINE);
+    CHECK(sNumberOfChartCalls == 1 && sChartCalls[0].DataLength == tSpectrum.getNumberOfBins(), "%u bytes sent, expected %u",
+            sChartCalls[0].DataLength, tSpectrum.getNumberOfBins());
+}
+
+int main() {
+    testInit();
+    testSine();
+    testFFT();
+    testLogMagnitude();
+    testSpectrum();
+    return printCheckSummary();
+}
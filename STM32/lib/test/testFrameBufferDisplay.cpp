@@ -0,0 +1,180 @@
+/*
+ * testFrameBufferDisplay.cpp
+ *
+ * Compares the span based fills of FrameBufferDisplay with a pixel by pixel reference,
+ * for all start alignments, including a frame buffer which is not 32 bit aligned.
+ * A fixed scene is then rendered and compared with its golden image checksum.
+ * On mismatch the scene is written to build/FrameBufferScene.ppm for inspection.
+ *
+ * @date 17.10.2026
+ * @author agent
+ * agent@local
+ * @copyright LGPL v3 (http://www.gnu.org/licenses/lgpl.html)
+ * @version 1.0.0
+ */
+
+#include "TestUtils.h"
+#include "FrameBufferDisplay.cpp"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define TEST_WIDTH 61 // odd, so that lines start at all alignments
+#define TEST_HEIGHT 37
+
+/*
+ * FNV-1a of the scene rendered by drawScene(). Update only after checking the PPM file.
+ */
+#define SCENE_GOLDEN_CHECKSUM 0xA8B5523DUL
+
+static uint16_t sReferenceBuffer[TEST_WIDTH * TEST_HEIGHT];
+
+static void referenceFillRect(int aXStart, int aYStart, int aXEnd, int aYEnd, uint16_t aColor) {
+    if (aXStart > aXEnd) {
+        int tTemp = aXStart;
+        aXStart = aXEnd;
+        aXEnd = tTemp;
+    }
+    if (aYStart > aYEnd) {
+        int tTemp = aYStart;
+        aYStart = aYEnd;
+        aYEnd = tTemp;
+    }
+    for (int tYPos = aYStart; tYPos <= aYEnd; ++tYPos) {
+        for (int tXPos = aXStart; tXPos <= aXEnd; ++tXPos) {
+            if (tXPos < TEST_WIDTH && tYPos < TEST_HEIGHT) {
+                sReferenceBuffer[tYPos * TEST_WIDTH + tXPos] = aColor;
+            }
+        }
+    }
+}
+
+static uint32_t getChecksum(const uint16_t *aBuffer, uint32_t aNumberOfPixel) {
+    uint32_t tHash = 2166136261UL;
+    for (uint32_t i = 0; i < aNumberOfPixel; ++i) {
+        tHash = (tHash ^ (aBuffer[i] & 0xFF)) * 16777619UL;
+        tHash = (tHash ^ (aBuffer[i] >> 8)) * 16777619UL;
+    }
+    return tHash;
+}
+
+/*
+ * Random rectangles with random corner order, partially outside the display
+ */
+static void testFillRect(uint16_t *aFrameBuffer) {
+    FrameBufferDisplay tDisplay(TEST_WIDTH, TEST_HEIGHT, aFrameBuffer);
+    tDisplay.init();
+    memset(sReferenceBuffer, 0, sizeof(sReferenceBuffer));
+    for (int i = 0; i < 20000; ++i) {
+        uint16_t tXStart = getRandom() % (TEST_WIDTH + 8);
+        uint16_t tYStart = getRandom() % (TEST_HEIGHT + 8);
+        uint16_t tXEnd = getRandom() % (TEST_WIDTH + 8);
+        uint16_t tYEnd = getRandom() % (TEST_HEIGHT + 8);
+        uint16_t tColor = getRandom();
+        tDisplay.fillRect(tXStart, tYStart, tXEnd, tYEnd, tColor);
+        referenceFillRect(tXStart, tYStart, tXEnd, tYEnd, tColor);
+        CHECK(memcmp(aFrameBuffer, sReferenceBuffer, sizeof(sReferenceBuffer)) == 0, "fillRect(%u, %u, %u, %u)", tXStart,
+                tYStart, tXEnd, tYEnd);
+    }
+    // Guard pixel behind the frame buffer must not be touched
+    tDisplay.clearDisplay(0x1234);
+    CHECK(aFrameBuffer[TEST_WIDTH * TEST_HEIGHT] == 0xDEAD, "clearDisplay() wrote behind buffer");
+}
+
+static void testLine(void) {
+    FrameBufferDisplay tDisplay(TEST_WIDTH, TEST_HEIGHT);
+    tDisplay.init();
+    for (int i = 0; i < 2000; ++i) {
+        int tXStart = getRandom() % TEST_WIDTH;
+        int tYStart = getRandom() % TEST_HEIGHT;
+        int tXEnd = getRandom() % TEST_WIDTH;
+        int tYEnd = getRandom() % TEST_HEIGHT;
+        tDisplay.clearDisplay(0);
+        tDisplay.drawLine(tXStart, tYStart, tXEnd, tYEnd, 1);
+        int tDeltaX = abs(tXEnd - tXStart);
+        int tDeltaY = abs(tYEnd - tYStart);
+        int tExpectedNumberOfPixel = (tDeltaX > tDeltaY ? tDeltaX : tDeltaY) + 1;
+        int tNumberOfPixel = 0;
+        for (int j = 0; j < TEST_WIDTH * TEST_HEIGHT; ++j) {
+            tNumberOfPixel += tDisplay.getFrameBuffer()[j];
+        }
+        CHECK(tNumberOfPixel == tExpectedNumberOfPixel, "drawLine(%d, %d, %d, %d) has %d pixel, expected %d", tXStart, tYStart,
+                tXEnd, tYEnd, tNumberOfPixel, tExpectedNumberOfPixel);
+        CHECK(tDisplay.readPixel(tXStart, tYStart) == 1 && tDisplay.readPixel(tXEnd, tYEnd) == 1,
+                "drawLine(%d, %d, %d, %d) misses end point", tXStart, tYStart, tXEnd, tYEnd);
+    }
+}
+
+/*
+ * Every outline pixel must be inside the filled circle, and the filled circle must be within the radius
+ */
+static void testCircle(void) {
+    FrameBufferDisplay tOutline(TEST_WIDTH, TEST_HEIGHT);
+    FrameBufferDisplay tFilled(TEST_WIDTH, TEST_HEIGHT);
+    tOutline.init();
+    tFilled.init();
+    for (uint16_t tRadius = 0; tRadius < 24; ++tRadius) {
+        tOutline.clearDisplay(0);
+        tFilled.clearDisplay(0);
+        tOutline.drawCircle(30, 18, tRadius, 1);
+        tFilled.fillCircle(30, 18, tRadius, 1);
+        for (int tYPos = 0; tYPos < TEST_HEIGHT; ++tYPos) {
+            for (int tXPos = 0; tXPos < TEST_WIDTH; ++tXPos) {
+                int tDistanceSquare = (tXPos - 30) * (tXPos - 30) + (tYPos - 18) * (tYPos - 18);
+                if (tOutline.readPixel(tXPos, tYPos)) {
+                    CHECK(tFilled.readPixel(tXPos, tYPos), "radius %u: outline pixel %d,%d not filled", tRadius, tXPos, tYPos);
+                }
+                if (tFilled.readPixel(tXPos, tYPos)) {
+                    CHECK(tDistanceSquare <= (tRadius + 1) * (tRadius + 1), "radius %u: pixel %d,%d outside", tRadius, tXPos,
+                            tYPos);
+                }
+            }
+        }
+    }
+}
+
+static void drawScene(FrameBufferDisplay *aDisplay) {
+    aDisplay->clearDisplay(COLOR16_WHITE);
+    aDisplay->fillRect(3, 2, 40, 12, COLOR16_BLUE);
+    aDisplay->drawRect(1, 1, 59, 35, COLOR16_BLACK);
+    aDisplay->drawLine(2, 34, 58, 14, COLOR16_RED);
+    aDisplay->drawLineFastOneX(50, 3, 30, COLOR16_GREEN);
+    aDisplay->fillCircle(45, 25, 8, COLOR16_YELLOW);
+    aDisplay->drawCircle(45, 25, 10, COLOR16_RED);
+    aDisplay->drawText(5, 4, "BD 1", 1, COLOR16_WHITE, COLOR16_NO_BACKGROUND);
+    aDisplay->drawText(4, 18, "x", 2, COLOR16_BLACK, COLOR16_GREEN);
+    aDisplay->drawMLText(22, 16, "ab\nc", 1, COLOR16_BLUE, COLOR16_WHITE);
+}
+
+static void testGoldenScene(void) {
+    FrameBufferDisplay tDisplay(TEST_WIDTH, TEST_HEIGHT);
+    tDisplay.init();
+    drawScene(&tDisplay);
+    uint32_t tChecksum = getChecksum(tDisplay.getFrameBuffer(), TEST_WIDTH * TEST_HEIGHT);
+    CHECK(tChecksum == SCENE_GOLDEN_CHECKSUM, "scene checksum is 0x%08lX, see build/FrameBufferScene.ppm",
+            (unsigned long) tChecksum);
+    if (tChecksum != SCENE_GOLDEN_CHECKSUM) {
+        tDisplay.writePPM("build/FrameBufferScene.ppm");
+    }
+
+    FILE *tFile = tmpfile();
+    CHECK(tFile != NULL && tDisplay.writePPM(tFile), "writePPM() failed");
+    if (tFile != NULL) {
+        long tExpectedSize = strlen("P6\n61 37\n255\n") + (3L * TEST_WIDTH * TEST_HEIGHT);
+        CHECK(ftell(tFile) == tExpectedSize, "PPM file has %ld bytes, expected %ld", ftell(tFile), tExpectedSize);
+        fclose(tFile);
+    }
+}
+
+int main() {
+    // Start at index 1 for a frame buffer, which is not 32 bit aligned
+    static uint16_t sFrameBuffer[TEST_WIDTH * TEST_HEIGHT + 2];
+    for (int tOffset = 0; tOffset < 2; ++tOffset) {
+        sFrameBuffer[tOffset + TEST_WIDTH * TEST_HEIGHT] = 0xDEAD;
+        testFillRect(&sFrameBuffer[tOffset]);
+    }
+    testLine();
+    testCircle();
+    testGoldenScene();
+    return printCheckSummary();
+}
@@ -0,0 +1,101 @@
+/*
+ * testNumberFormat.cpp
+ *
+ * Compares the BDNumberFormat functions with snprintf(), including truncation to small buffers.
+ * Floats are compared numerically, because snprintf() rounds the exact binary value while formatFloat()
+ * rounds with float arithmetic.
+ *
+ * @date 17.10.2026
+ * @author agent
+ * agent@local
+ * @copyright LGPL v3 (http://www.gnu.org/licenses/lgpl.html)
+ * @version 1.0.0
+ */
+
+#include "TestUtils.h"
+#include "BDNumberFormat.cpp"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int32_t getRandomValue(void) {
+    // all magnitudes up to 10 digits
+    uint32_t tValue = getRandom() >> (getRandom() % 32);
+    return (getRandom() & 1) ? -(int32_t) (tValue >> 1) : (int32_t) tValue;
+}
+
+static void testDecimal(void) {
+    char tBuffer[FORMAT_BUFFER_SIZE_FOR_FLOAT];
+    char tExpected[64];
+    for (uint32_t i = 0; i < 200000; ++i) {
+        int32_t tValue = getRandomValue();
+        uint8_t tMinWidth = getRandom() % 14;
+        uint8_t tBufferSize = 1 + (getRandom() % sizeof(tBuffer));
+        bool tPadZero = getRandom() & 1;
+        char tPadChar = tPadZero ? FORMAT_PAD_ZERO : FORMAT_PAD_SPACE;
+
+        snprintf(tExpected, tBufferSize, tPadZero ? "%0*d" : "%*d", tMinWidth, (int) tValue);
+        uint8_t tLength = formatSignedDecimal(tBuffer, tBufferSize, tValue, tMinWidth, tPadChar);
+        CHECK(strcmp(tBuffer, tExpected) == 0 && tLength == strlen(tExpected), "signed %d width %d size %d \"%s\" != \"%s\"",
+                (int) tValue, tMinWidth, tBufferSize, tBuffer, tExpected);
+
+        uint32_t tUnsignedValue = getRandom() >> (getRandom() % 32);
+        snprintf(tExpected, tBufferSize, tPadZero ? "%0*u" : "%*u", tMinWidth, (unsigned int) tUnsignedValue);
+        tLength = formatUnsignedDecimal(tBuffer, tBufferSize, tUnsignedValue, tMinWidth, tPadChar);
+        CHECK(strcmp(tBuffer, tExpected) == 0 && tLength == strlen(tExpected), "unsigned %u width %d size %d \"%s\" != \"%s\"",
+                (unsigned int) tUnsignedValue, tMinWidth, tBufferSize, tBuffer, tExpected);
+
+        uint8_t tMinDigits = 1 + (getRandom() % 10);
+        snprintf(tExpected, tBufferSize, "%.*X", tMinDigits, (unsigned int) tUnsignedValue);
+        tLength = formatHex(tBuffer, tBufferSize, tUnsignedValue, tMinDigits);
+        CHECK(strcmp(tBuffer, tExpected) == 0 && tLength == strlen(tExpected), "hex %X digits %d size %d \"%s\" != \"%s\"",
+                (unsigned int) tUnsignedValue, tMinDigits, tBufferSize, tBuffer, tExpected);
+    }
+    // extreme values
+    formatSignedDecimal(tBuffer, sizeof(tBuffer), INT32_MIN);
+    CHECK(strcmp(tBuffer, "-2147483648") == 0, "INT32_MIN gives \"%s\"", tBuffer);
+    formatUnsignedDecimal(tBuffer, sizeof(tBuffer), UINT32_MAX);
+    CHECK(strcmp(tBuffer, "4294967295") == 0, "UINT32_MAX gives \"%s\"", tBuffer);
+    CHECK(formatSignedDecimal(tBuffer, 0, 42) == 0, "buffer size 0 must not write");
+}
+
+static void testFloat(void) {
+    char tBuffer[FORMAT_BUFFER_SIZE_FOR_FLOAT];
+    char tExpected[64];
+    for (uint32_t i = 0; i < 200000; ++i) {
+        // values up to 1E9 with all numbers of decimals
+        float tValue = (float) getRandomValue() / (float) (1UL << (getRandom() % 31));
+        uint8_t tNumberOfDecimals = getRandom() % (FORMAT_MAX_NUMBER_OF_DECIMALS + 1);
+        uint8_t tMinWidth = getRandom() % 20;
+
+        snprintf(tExpected, sizeof(tExpected), "%*.*f", tMinWidth, tNumberOfDecimals, tValue);
+        uint8_t tLength = formatFloat(tBuffer, sizeof(tBuffer), tValue, tMinWidth, tNumberOfDecimals);
+        CHECK(tLength == strlen(tExpected), "float %.9g length %d \"%s\" != \"%s\"", tValue, tLength, tBuffer, tExpected);
+        // float rounding may differ by one unit of the last decimal
+        double tDifference = fabs(strtod(tBuffer, NULL) - strtod(tExpected, NULL));
+        double tTolerance = pow(10, -tNumberOfDecimals) * 1.01 + fabs(tValue) * 1E-7;
+        CHECK(tDifference <= tTolerance, "float %.9g \"%s\" != \"%s\"", tValue, tBuffer, tExpected);
+    }
+    formatFloat(tBuffer, sizeof(tBuffer), -1.5f, 6, 2);
+    CHECK(strcmp(tBuffer, " -1.50") == 0, "-1.5 gives \"%s\"", tBuffer);
+    formatFloat(tBuffer, sizeof(tBuffer), 0.999f, 0, 2);
+    CHECK(strcmp(tBuffer, "1.00") == 0, "0.999 gives \"%s\"", tBuffer);
+    formatFloat(tBuffer, sizeof(tBuffer), NAN, 5, 2);
+    CHECK(strcmp(tBuffer, "  nan") == 0, "NaN gives \"%s\"", tBuffer);
+
+    // truncation like snprintf, e.g. for large values and many decimals in small label buffers
+    for (uint8_t tBufferSize = 1; tBufferSize <= sizeof(tBuffer); ++tBufferSize) {
+        memset(tBuffer, 'x', sizeof(tBuffer));
+        uint8_t tLength = formatFloat(tBuffer, tBufferSize, -1234567890.0f, 20, 7);
+        uint8_t tExpectedLength = (tBufferSize - 1 < 20) ? tBufferSize - 1 : 20;
+        CHECK(tLength == tExpectedLength && tBuffer[tLength] == '\0', "size %d gives length %d", tBufferSize, tLength);
+        CHECK(tBufferSize == sizeof(tBuffer) || tBuffer[tBufferSize] == 'x', "size %d writes behind buffer", tBufferSize);
+    }
+}
+
+int main(void) {
+    testDecimal();
+    testFloat();
+    return printCheckSummary();
+}
@@ -41,7 +41,10 @@ import android.graphics.Color;
 import android.graphics.Paint;
 import android.graphics.Paint.Cap;
 import android.graphics.Path;
+import android.graphics.PorterDuff;
+import android.graphics.PorterDuffXfermode;
 import android.graphics.Point;
+import android.graphics.Rect;
 import android.graphics.RectF;
 import android.graphics.Typeface;
 import android.hardware.Sensor;
@@ -81,14 +84,72 @@ public class RPCView extends View {
 
     private static final int MAX_CHART_LINE_WIDTH = 1280;
 
-    // 4 values for one line - 4 lines possible
-    public static float[][] mChartScreenBuffer = new float[4][MAX_CHART_LINE_WIDTH * 4];
+    private static final int MAX_NUMBER_OF_CHARTS = 16; // chart index is coded in 4 bits
 
-    public static int mChartScreenBufferCurrentLength = 0;
+    // 4 values for one line - allocated at first use of chart index
+    public static float[][] mChartScreenBuffer = new float[MAX_NUMBER_OF_CHARTS][];
+
+    // number of lines of last chart for each chart index, used for clearing
+    public static int[] mChartScreenBufferCurrentLength = new int[MAX_NUMBER_OF_CHARTS];
     public static float mChartScreenBufferXStart = 0;
 
+    /*
+     * Bitmaps uploaded by client, key is bitmap id. Cleared by reset all.
+     */
+    private SparseArray<Bitmap> mBitmapCache = new SparseArray<Bitmap>();
+    private SparseArray<int[]> mBitmapPalettes = new SparseArray<int[]>();
+    private RectF mBitmapDestinationRect = new RectF();
+
+    /*
+     * Strings defined by client for FUNCTION_DRAW_STRING_BY_ID and FUNCTION_BUTTON_SET_CAPTION_BY_ID, key is string id.
+     * Cleared by reset all.
+     */
+    private SparseArray<String> mInternedStrings = new SparseArray<String>();
+
+    /*
+     * Color palette for colors sent as one byte index, contains RGB565 values. Not cleared by reset all,
+     * since the client sends it at connection build up before the reset all of its connect callback.
+     */
+    private final static int MAX_NUMBER_OF_PALETTE_COLORS = 256;
+
+    /*
+     * Vectors defined by client for FUNCTION_VECTOR_SET_DEGREES, key is vector handle. Cleared by reset all.
+     */
+    private SparseArray<int[]> mVectors = new SparseArray<int[]>();
+    private final static int VECTOR_START_X = 0;
+    private final static int VECTOR_START_Y = 1;
+    private final static int VECTOR_LENGTH = 2;
+    private final static int VECTOR_THICKNESS = 3;
+    private final static int VECTOR_COLOR = 4;
+    private final static int VECTOR_BACKGROUND_COLOR = 5;
+    private final static int VECTOR_DRAWN_DEGREES = 6;
+    private final static int VECTOR_SIZE = 7;
+    private final static int VECTOR_NOT_DRAWN = Integer.MIN_VALUE;
+    private int[] mColorPalette = new int[MAX_NUMBER_OF_PALETTE_COLORS];
+
+    /*
+     * Frame transaction. While a frame is open, onDraw() shows mPresentedBitmap, which is the copy of mBitmap taken at frame begin.
+     * So all drawings of a frame become visible at once at frame end.
+     */
+    boolean mFrameIsOpen = false;
+    private Bitmap mPresentedBitmap;
+    private Canvas mPresentedCanvas;
+
+    /*
+     * Layers. Layer 0 is mBitmap, the upper layers are transparent and created on first use.
+     * onDraw() draws all layers directly on the view canvas, so the content of an upper layer, e.g. the traces of a chart,
+     * can be cleared and redrawn without redrawing the background layer below.
+     */
+    private final static int MAX_NUMBER_OF_LAYERS = 4;
+    private Bitmap[] mLayerBitmaps = new Bitmap[MAX_NUMBER_OF_LAYERS];
+    private Canvas[] mLayerCanvases = new Canvas[MAX_NUMBER_OF_LAYERS];
+    private int mSelectedLayer = 0;
+
     public static Bitmap mBitmap;
     private Paint mBitmapPaint; // only used for onDraw() to draw bitmap
+    private Paint mScrollPaint; // copies pixel including alpha for FUNCTION_RECT_SCROLL_LEFT
+    private Bitmap mScrollBitmap; // scratch bitmap for FUNCTION_RECT_SCROLL_LEFT, only grows
+    private Canvas mScrollCanvas;
     private Paint mInfoPaint; // for internal info text like touch coordinates
 
     static final float TEXT_ASCEND_FACTOR = 0.76f;
@@ -216,9 +277,9 @@ public class RPCView extends View {
     // Display (draw) functions with variable data 60-
     public static final int INDEX_FIRST_FUNCTION_WITH_DATA = 0x60;
 
-    // Button functions with variable data 70-77
+    // Button functions with variable data 70-73, 74-77 are display (draw) functions with variable data
     public static final int INDEX_FIRST_FUNCTION_BUTTON_WITH_DATA = 0x70;
-    public static final int INDEX_LAST_FUNCTION_BUTTON_WITH_DATA = 0x77;
+    public static final int INDEX_LAST_FUNCTION_BUTTON_WITH_DATA = 0x73;
 
     // Slider functions with variable data 78-7E
     // 0x7F is NOP
@@ -304,29 +365,65 @@ public class RPCView extends View {
     private final static int FUNCTION_DRAW_CIRCLE = 0x28;
     private final static int FUNCTION_FILL_CIRCLE = 0x29;
 
+    // 3 parameter
+    private final static int FUNCTION_BITMAP_DRAW = 0x2A;
+    private final static int FUNCTION_BITMAP_REMOVE = 0x2B;
+
     private final static int FUNCTION_DRAW_VECTOR_DEGREE = 0x2C;
     private final static int FUNCTION_DRAW_VECTOR_RADIAN = 0x2D;
 
+    // 6 parameter, last is string id
+    private final static int FUNCTION_DRAW_STRING_BY_ID = 0x2E;
+
+    // no parameter
+    public final static int FUNCTION_FRAME_BEGIN = 0x30;
+    public final static int FUNCTION_FRAME_BEGIN_OPTIONAL = 0x31; // used for skipping preceding frames in buffer
+    public final static int FUNCTION_FRAME_END = 0x32;
+    private final static int FUNCTION_VECTOR_DEFINE = 0x33;
+
     private final static int FUNCTION_WRITE_SETTINGS = 0x34;
     // Flags for WRITE_SETTINGS
     private final static int FLAG_WRITE_SETTINGS_SET_SIZE_AND_COLORS_AND_FLAGS = 0x00;
     private final static int FLAG_WRITE_SETTINGS_SET_POSITION = 0x01;
     private final static int FLAG_WRITE_SETTINGS_SET_LINE_COLUMN = 0x02;
 
+    // 1 parameter: layer
+    private final static int FUNCTION_LAYER_SELECT = 0x35;
+    private final static int FUNCTION_LAYER_CLEAR = 0x36;
+    // 6 parameter
+    private final static int FUNCTION_RECT_SCROLL_LEFT = 0x37;
+    // 10 parameter
+    private final static int FUNCTION_DRAW_CHART_GRID = 0x38;
+    private final static int CHART_GRID_FLAG_GRID_LINES = 0x01;
+    private final static int CHART_GRID_FLAG_X_INDICATORS = 0x02;
+    private final static int CHART_GRID_FLAG_Y_INDICATORS = 0x04;
+
     /*
      * Functions with variable parameter length
      */
     private final static int FUNCTION_DRAW_STRING = 0x60;
     private final static int FUNCTION_DEBUG_STRING = 0x61;
     private final static int FUNCTION_WRITE_STRING = 0x62;
+    private final static int FUNCTION_DRAW_CHART_XY = 0x63;
 
     private final static int FUNCTION_GET_NUMBER_WITH_SHORT_PROMPT = 0x64;
     private final static int FUNCTION_GET_TEXT_WITH_SHORT_PROMPT = 0x65;
+    private final static int FUNCTION_VECTOR_SET_DEGREES = 0x66;
+    private final static int FUNCTION_DRAW_CHART_MIN_MAX = 0x67;
 
     private final static int FUNCTION_DRAW_PATH = 0x68;
     private final static int FUNCTION_FILL_PATH = 0x69;
     final static int FUNCTION_DRAW_CHART = 0x6A;
     final static int FUNCTION_DRAW_CHART_WITHOUT_DIRECT_RENDERING = 0x6B;
+    private final static int FUNCTION_BITMAP_UPLOAD = 0x6C;
+    // Formats for FUNCTION_BITMAP_UPLOAD
+    private final static int BITMAP_FORMAT_RGB565 = 0x00;
+    private final static int BITMAP_FORMAT_INDEXED_8 = 0x01;
+    private final static int FUNCTION_BITMAP_SET_PALETTE = 0x6D;
+    private final static int FUNCTION_STRING_DEFINE = 0x6E;
+    private final static int FUNCTION_COLOR_PALETTE_SET = 0x6F;
+    // 0x74 to 0x77 are display functions with variable data
+    private final static int FUNCTION_FILL_RECT_LIST = 0x74;
 
     private static final int LONG_TOUCH_DOWN = 0;
 
@@ -456,9 +553,12 @@ public class RPCView extends View {
         // mBitmap.setHasAlpha(false);
 
         mBitmapPaint = new Paint();
+        mScrollPaint = new Paint();
+        mScrollPaint.setXfermode(new PorterDuffXfermode(PorterDuff.Mode.SRC));
 
         mCanvas = new Canvas(mBitmap);
         mCanvas.drawColor(Color.WHITE); // white background
+        mLayerCanvases[0] = mCanvas;
         initCharMappingArray();
 
         /*
@@ -516,7 +616,7 @@ public class RPCView extends View {
             int tSumWaitDelay = 0;
             do {
                 tResult = mBlueDisplayContext.mSerialService.searchCommand(this);
-                canvas.drawBitmap(mBitmap, 0, 0, mBitmapPaint); // must be done at every call
+                presentBitmap(canvas); // must be done at every call
                 int tBytesInBuffer = mBlueDisplayContext.mSerialService.getBufferBytesAvailable();
                 if (tResult == SerialService.RPCVIEW_DO_DRAW_AND_CALL_AGAIN) {
                     // We have more data in buffer, but want to show the bitmap now (between 4 and 20 ms on my Nexus7/6.0.1),
@@ -557,8 +657,85 @@ public class RPCView extends View {
                 }
             } while (tResult == SerialService.RPCVIEW_DO_WAIT);
         } else {
-            canvas.drawBitmap(mBitmap, 0, 0, mBitmapPaint);
+            presentBitmap(canvas);
+        }
+    }
+
+    /*
+     * Draws the frame taken at frame begin or all layers directly on the view canvas
+     */
+    private void presentBitmap(Canvas aCanvas) {
+        if (mFrameIsOpen) {
+            aCanvas.drawBitmap(mPresentedBitmap, 0, 0, mBitmapPaint);
+        } else {
+            composeLayers(aCanvas, mBitmapPaint);
+        }
+    }
+
+    /*
+     * Draws all layers from bottom to top on aCanvas
+     */
+    private void composeLayers(Canvas aCanvas, Paint aPaint) {
+        aCanvas.drawBitmap(mBitmap, 0, 0, aPaint);
+        for (int i = 1; i < MAX_NUMBER_OF_LAYERS; i++) {
+            if (mLayerBitmaps[i] != null) {
+                aCanvas.drawBitmap(mLayerBitmaps[i], 0, 0, aPaint);
+            }
+        }
+    }
+
+    /*
+     * Returns canvas of layer and creates a transparent layer bitmap if not yet done
+     */
+    private Canvas getLayerCanvas(int aLayer) {
+        if (mLayerCanvases[aLayer] == null) {
+            mLayerBitmaps[aLayer] = Bitmap.createBitmap(mBitmap.getWidth(), mBitmap.getHeight(), Bitmap.Config.ARGB_8888);
+            mLayerCanvases[aLayer] = new Canvas(mLayerBitmaps[aLayer]);
+        }
+        return mLayerCanvases[aLayer];
+    }
+
+    private static float[] getChartScreenBuffer(int aChartIndex) {
+        if (mChartScreenBuffer[aChartIndex] == null) {
+            mChartScreenBuffer[aChartIndex] = new float[MAX_CHART_LINE_WIDTH * 4];
         }
+        return mChartScreenBuffer[aChartIndex];
+    }
+
+    /*
+     * Like FUNCTION_FILL_RECT_REL
+     */
+    private void fillRectRel(int aXStart, int aYStart, int aWidth, int aHeight, Paint aPaint) {
+        mCanvas.drawRect(aXStart * mScaleFactor, aYStart * mScaleFactor, (aXStart + aWidth) * mScaleFactor,
+                (aYStart + aHeight) * mScaleFactor, aPaint);
+    }
+
+    private Bitmap getSelectedLayerBitmap() {
+        if (mSelectedLayer == 0) {
+            return mBitmap;
+        }
+        return mLayerBitmaps[mSelectedLayer];
+    }
+
+    private void clearLayer(int aLayer) {
+        if (mLayerCanvases[aLayer] != null) {
+            mLayerCanvases[aLayer].drawColor(Color.TRANSPARENT, PorterDuff.Mode.CLEAR);
+        }
+    }
+
+    /*
+     * Removes all upper layers and selects layer 0
+     */
+    private void removeUpperLayers() {
+        for (int i = 1; i < MAX_NUMBER_OF_LAYERS; i++) {
+            if (mLayerBitmaps[i] != null) {
+                mLayerBitmaps[i].recycle();
+                mLayerBitmaps[i] = null;
+                mLayerCanvases[i] = null;
+            }
+        }
+        mSelectedLayer = 0;
+        mCanvas = mLayerCanvases[0];
     }
 
     @SuppressLint("ClickableViewAccessibility")
@@ -1092,8 +1269,19 @@ public class RPCView extends View {
             mCurrentCanvasHeight = (int) (mRequestedCanvasHeight * mScaleFactor);
             Bitmap tOldBitmap = mBitmap;
             mBitmap = Bitmap.createScaledBitmap(mBitmap, mCurrentCanvasWidth, mCurrentCanvasHeight, false);
-            mCanvas = new Canvas(mBitmap);
+            mLayerCanvases[0] = new Canvas(mBitmap);
             tOldBitmap.recycle();
+            for (int i = 1; i < MAX_NUMBER_OF_LAYERS; i++) {
+                if (mLayerBitmaps[i] != null) {
+                    tOldBitmap = mLayerBitmaps[i];
+                    mLayerBitmaps[i] = Bitmap.createScaledBitmap(tOldBitmap, mCurrentCanvasWidth, mCurrentCanvasHeight, false);
+                    mLayerCanvases[i] = new Canvas(mLayerBitmaps[i]);
+                    tOldBitmap.recycle();
+                }
+            }
+            mCanvas = mLayerCanvases[mSelectedLayer];
+            // presented bitmap has the old size, so show the incomplete frame
+            mFrameIsOpen = false;
 
             mTouchScaleFactor = mScaleFactor;
             mGraphPaintStrokeScaleFactor.setStrokeWidth(mScaleFactor);
@@ -1126,6 +1314,38 @@ public class RPCView extends View {
         return false;
     }
 
+    /*
+     * Returns empty string if id was not defined
+     */
+    String getInternedString(int aStringId) {
+        String tString = mInternedStrings.get(aStringId);
+        if (tString == null) {
+            MyLog.w(LOG_TAG, "String id " + aStringId + " was not defined");
+            return "";
+        }
+        return tString;
+    }
+
+    private void drawVector(int[] aVector, int aDegrees, int aColor) {
+        float tXStart = aVector[VECTOR_START_X] * mScaleFactor;
+        float tYStart = aVector[VECTOR_START_Y] * mScaleFactor;
+        double tRadianOfDegree = aDegrees * (Math.PI / 180);
+        // round after scaling, rounding before scaling results in an offset of up to mScaleFactor / 2 pixel
+        float tXEnd = Math.round(tXStart + (float) (Math.cos(tRadianOfDegree) * aVector[VECTOR_LENGTH] * mScaleFactor));
+        float tYEnd = Math.round(tYStart - (float) (Math.sin(tRadianOfDegree) * aVector[VECTOR_LENGTH] * mScaleFactor));
+        mGraphPaintStrokeSettable.setStrokeWidth(aVector[VECTOR_THICKNESS] * mScaleFactor);
+        mGraphPaintStrokeSettable.setColor(aColor);
+        mCanvas.drawLine(tXStart, tYStart, tXEnd, tYEnd, mGraphPaintStrokeSettable);
+    }
+
+    /*
+     * Returns RGB565 value, which can be converted with shortToLongColor().
+     * It is sign extended like the 2 byte parameters, so that comparison with COLOR_NO_BACKGROUND works.
+     */
+    int getPaletteColor(int aPaletteIndex) {
+        return (short) mColorPalette[aPaletteIndex];
+    }
+
     // 5 red | 6 green | 5 blue
     public static int shortToLongColor(int aShortColor) {
         int tBlue = (aShortColor & 0x1F) << 3;
@@ -1186,6 +1406,20 @@ public class RPCView extends View {
         return tPrintY;
     }
 
+    /*
+     * Commands which change state, which is used by later commands, like definitions, settings and button or slider commands.
+     * They must not be skipped if the host is behind the client.
+     */
+    public static boolean isStateChangingCommand(int aCommand) {
+        return (aCommand > INDEX_LAST_FUNCTION_DATAFIELD && aCommand <= INDEX_LAST_FUNCTION_INTERNAL)
+                || (aCommand >= INDEX_FIRST_FUNCTION_BUTTON && aCommand <= INDEX_LAST_FUNCTION_SLIDER)
+                || (aCommand >= INDEX_FIRST_FUNCTION_BUTTON_WITH_DATA && aCommand <= INDEX_LAST_FUNCTION_BUTTON_WITH_DATA)
+                || (aCommand >= INDEX_FIRST_FUNCTION_SLIDER_WITH_DATA && aCommand <= INDEX_LAST_FUNCTION_SLIDER_WITH_DATA)
+                || aCommand == FUNCTION_WRITE_SETTINGS || aCommand == FUNCTION_VECTOR_DEFINE || aCommand == FUNCTION_VECTOR_SET_DEGREES
+                || aCommand == FUNCTION_LAYER_SELECT || aCommand == FUNCTION_BITMAP_UPLOAD || aCommand == FUNCTION_BITMAP_SET_PALETTE
+                || aCommand == FUNCTION_BITMAP_REMOVE || aCommand == FUNCTION_STRING_DEFINE || aCommand == FUNCTION_COLOR_PALETTE_SET;
+    }
+
     public void interpretCommand(int aCommand, int[] aParameters, int aParamsLength, byte[] aDataBytes, int[] aDataInts,
             int aDataLength) {
 
@@ -1566,6 +1800,132 @@ public class RPCView extends View {
                 mBlueDisplayContext.mSensorEventListener.setSensor(aParameters[0], tDoActivate, aParameters[2], tFilterFlag);
                 break;
 
+            case FUNCTION_FRAME_BEGIN:
+            case FUNCTION_FRAME_BEGIN_OPTIONAL:
+                if (MyLog.isDEBUG()) {
+                    MyLog.d(LOG_TAG, "Begin frame" + ((aCommand == FUNCTION_FRAME_BEGIN_OPTIONAL) ? " optional" : "")
+                            + " frameIsOpen=" + mFrameIsOpen);
+                }
+                if (!mFrameIsOpen) {
+                    if (mPresentedBitmap == null || mPresentedBitmap.getWidth() != mBitmap.getWidth()
+                            || mPresentedBitmap.getHeight() != mBitmap.getHeight()) {
+                        if (mPresentedBitmap != null) {
+                            mPresentedBitmap.recycle();
+                        }
+                        mPresentedBitmap = Bitmap.createBitmap(mBitmap.getWidth(), mBitmap.getHeight(), Bitmap.Config.ARGB_8888);
+                        mPresentedCanvas = new Canvas(mPresentedBitmap);
+                    }
+                    // keep showing the last frame while drawing the new one
+                    composeLayers(mPresentedCanvas, null);
+                    mFrameIsOpen = true;
+                }
+                break;
+
+            case FUNCTION_VECTOR_DEFINE:
+                int[] tVector = new int[VECTOR_SIZE];
+                tVector[VECTOR_START_X] = aParameters[1];
+                tVector[VECTOR_START_Y] = aParameters[2];
+                tVector[VECTOR_LENGTH] = aParameters[3];
+                tVector[VECTOR_THICKNESS] = aParameters[4];
+                tVector[VECTOR_COLOR] = shortToLongColor(aParameters[5]);
+                tVector[VECTOR_BACKGROUND_COLOR] = shortToLongColor(aParameters[6]);
+                tVector[VECTOR_DRAWN_DEGREES] = VECTOR_NOT_DRAWN;
+                mVectors.put(aParameters[0], tVector);
+                if (MyLog.isDEBUG()) {
+                    MyLog.d(LOG_TAG, "defineVector(" + aParameters[0] + ", " + aParameters[1] + ", " + aParameters[2] + ", "
+                            + aParameters[3] + ") thickness=" + aParameters[4] + " color= " + shortToColorString(aParameters[5]));
+                }
+                break;
+
+            case FUNCTION_RECT_SCROLL_LEFT:
+                /*
+                 * The columns of a chart are drawn at tXStart + (column * mScaleFactor) with a stroke width of mScaleFactor,
+                 * so the rectangle ends half a column behind the last column and is scrolled by the same float offset.
+                 */
+                int tScrollX = Math.round(tXStart);
+                int tScrollY = Math.round(tYStart);
+                float tScrollEndX = tXStart + ((aParameters[2] - 0.5f) * mScaleFactor);
+                int tScrollWidth = Math.round(tScrollEndX) - tScrollX;
+                int tScrollHeight = Math.round(aParameters[3] * mScaleFactor);
+                float tScrollOffset = aParameters[4] * mScaleFactor;
+                if (MyLog.isDEBUG()) {
+                    MyLog.d(LOG_TAG, "scrollRectLeft(" + aParameters[0] + ", " + aParameters[1] + ", " + aParameters[2] + ", "
+                            + aParameters[3] + ") pixel=" + aParameters[4] + " color= " + shortToColorString(aParameters[5]));
+                }
+                Bitmap tScrollLayerBitmap = getSelectedLayerBitmap();
+                if (tScrollX < 0 || tScrollY < 0 || tScrollWidth <= 0 || tScrollHeight <= 0
+                        || tScrollX + tScrollWidth > tScrollLayerBitmap.getWidth()
+                        || tScrollY + tScrollHeight > tScrollLayerBitmap.getHeight()) {
+                    MyLog.e(LOG_TAG, "Scroll rectangle is not inside canvas");
+                    break;
+                }
+                if (tScrollOffset > tScrollWidth) {
+                    tScrollOffset = tScrollWidth;
+                }
+                if (tScrollOffset < tScrollWidth) {
+                    // copy first, since source and destination overlap
+                    if (mScrollBitmap == null || mScrollBitmap.getWidth() < tScrollWidth
+                            || mScrollBitmap.getHeight() < tScrollHeight) {
+                        if (mScrollBitmap != null) {
+                            mScrollBitmap.recycle();
+                        }
+                        mScrollBitmap = Bitmap.createBitmap(tScrollWidth, tScrollHeight, Bitmap.Config.ARGB_8888);
+                        mScrollCanvas = new Canvas(mScrollBitmap);
+                    }
+                    Rect tScrollBitmapRect = new Rect(0, 0, tScrollWidth, tScrollHeight);
+                    mScrollCanvas.drawBitmap(tScrollLayerBitmap, new Rect(tScrollX, tScrollY, tScrollX + tScrollWidth, tScrollY
+                            + tScrollHeight), tScrollBitmapRect, mScrollPaint);
+                    mCanvas.save();
+                    mCanvas.clipRect(tScrollX, tScrollY, tScrollX + tScrollWidth, tScrollY + tScrollHeight);
+                    mCanvas.drawBitmap(mScrollBitmap, tScrollBitmapRect, new RectF(tScrollX - tScrollOffset, tScrollY, tScrollX
+                            - tScrollOffset + tScrollWidth, tScrollY + tScrollHeight), mScrollPaint);
+                    mCanvas.restore();
+                }
+                // fill exposed area at the right
+                mCanvas.save();
+                mCanvas.clipRect(tScrollX + tScrollWidth - tScrollOffset, tScrollY, tScrollX + tScrollWidth, tScrollY
+                        + tScrollHeight);
+                if (mSelectedLayer == 0) {
+                    mCanvas.drawColor(shortToLongColor(aParameters[5]));
+                } else {
+                    mCanvas.drawColor(Color.TRANSPARENT, PorterDuff.Mode.CLEAR);
+                }
+                mCanvas.restore();
+                break;
+
+            case FUNCTION_LAYER_SELECT:
+            case FUNCTION_LAYER_CLEAR:
+                int tLayer = aParameters[0];
+                if (tLayer < 0 || tLayer >= MAX_NUMBER_OF_LAYERS) {
+                    MyLog.e(LOG_TAG, "Layer " + tLayer + " is not in range 0 to " + (MAX_NUMBER_OF_LAYERS - 1));
+                    break;
+                }
+                if (aCommand == FUNCTION_LAYER_SELECT) {
+                    if (MyLog.isDEBUG()) {
+                        MyLog.d(LOG_TAG, "Select layer " + tLayer);
+                    }
+                    mSelectedLayer = tLayer;
+                    mCanvas = getLayerCanvas(tLayer);
+                } else {
+                    if (MyLog.isDEBUG()) {
+                        MyLog.d(LOG_TAG, "Clear layer " + tLayer);
+                    }
+                    if (tLayer == 0) {
+                        mLayerCanvases[0].drawColor(Color.WHITE);
+                    } else {
+                        clearLayer(tLayer);
+                    }
+                }
+                break;
+
+            case FUNCTION_FRAME_END:
+                if (MyLog.isDEBUG()) {
+                    MyLog.d(LOG_TAG, "End frame");
+                }
+                // present is triggered at SearchCommand
+                mFrameIsOpen = false;
+                break;
+
             case FUNCTION_CLEAR_DISPLAY_OPTIONAL:
                 // Do nothing, it is interpreted directly at SearchCommand as sync point for skipping command buffer
                 break;
@@ -1575,9 +1935,14 @@ public class RPCView extends View {
                 if (MyLog.isINFO()) {
                     MyLog.i(LOG_TAG, "Clear screen color= " + shortToColorString(aParameters[0]));
                 }
-                mCanvas.drawColor(shortToLongColor(aParameters[0]));
+                mLayerCanvases[0].drawColor(shortToLongColor(aParameters[0]));
+                for (int i = 1; i < MAX_NUMBER_OF_LAYERS; i++) {
+                    clearLayer(i);
+                }
                 // reset screen buffer
-                mChartScreenBufferCurrentLength = 0;
+                for (int i = 0; i < MAX_NUMBER_OF_CHARTS; i++) {
+                    mChartScreenBufferCurrentLength[i] = 0;
+                }
                 break;
 
             case FUNCTION_DRAW_PIXEL:
@@ -1696,7 +2061,7 @@ public class RPCView extends View {
                      */
                     // set delete color
                     mGraphPaintStrokeScaleFactor.setColor(tDeleteColor);
-                    mCanvas.drawLines(mChartScreenBuffer[tChartIndex], 0, mChartScreenBufferCurrentLength * 4,
+                    mCanvas.drawLines(getChartScreenBuffer(tChartIndex), 0, mChartScreenBufferCurrentLength[tChartIndex] * 4,
                             mGraphPaintStrokeScaleFactor);
                 }
 
@@ -1707,9 +2072,10 @@ public class RPCView extends View {
 
                 float tYOffset = tYStart;
                 tYStart += SerialService.convertByteToFloat(aDataBytes[0]) * mScaleFactor;
-                mChartScreenBuffer[tChartIndex][0] = tXStart;
-                mChartScreenBuffer[tChartIndex][1] = tYStart;
-                mChartScreenBufferCurrentLength = aDataLength;
+                float[] tChartLines = getChartScreenBuffer(tChartIndex);
+                tChartLines[0] = tXStart;
+                tChartLines[1] = tYStart;
+                mChartScreenBufferCurrentLength[tChartIndex] = aDataLength;
                 mChartScreenBufferXStart = tXStart;
                 int j = 1;
                 int i = 2;
@@ -1718,17 +2084,193 @@ public class RPCView extends View {
                     tXStart += mScaleFactor;
                     tYStart = (SerialService.convertByteToFloat(aDataBytes[j++]) * mScaleFactor) + tYOffset;
                     // end of first line ...
-                    mChartScreenBuffer[tChartIndex][i++] = tXStart;
-                    mChartScreenBuffer[tChartIndex][i++] = tYStart;
+                    tChartLines[i++] = tXStart;
+                    tChartLines[i++] = tYStart;
                     // ... is start of next line
-                    mChartScreenBuffer[tChartIndex][i++] = tXStart;
-                    mChartScreenBuffer[tChartIndex][i++] = tYStart;
+                    tChartLines[i++] = tXStart;
+                    tChartLines[i++] = tYStart;
+                }
+                tChartLines[i++] = tXStart + mScaleFactor;
+                tChartLines[i] = (SerialService.convertByteToFloat(aDataBytes[j++]) * mScaleFactor) + tYOffset;
+
+                mCanvas.drawLines(tChartLines, 0, aDataLength * 4, mGraphPaintStrokeScaleFactor);
+
+                break;
+
+            case FUNCTION_DRAW_CHART_MIN_MAX:
+                /*
+                 * Data is a pair of top and bottom Y value for each column, which is drawn as vertical line.
+                 * Chart index is coded in the upper 4 bits of Y start position.
+                 */
+                int tMinMaxChartIndex = aParameters[1] >> 12;
+                float tMinMaxYOffset = (aParameters[1] & 0x0FFF) * mScaleFactor;
+                int tNumberOfColumns = aDataLength / 2;
+                if (tNumberOfColumns > MAX_CHART_LINE_WIDTH) {
+                    tNumberOfColumns = MAX_CHART_LINE_WIDTH;
+                }
+                if (MyLog.isDEBUG()) {
+                    MyLog.d(LOG_TAG, "drawChartMinMax(" + aParameters[0] + ", " + (aParameters[1] & 0x0FFF) + ") color= "
+                            + shortToColorString(aParameters[2]) + " ,deleteColor= " + shortToColorString(aParameters[3])
+                            + " columns=" + tNumberOfColumns + " ChartIndex=" + tMinMaxChartIndex);
                 }
-                mChartScreenBuffer[tChartIndex][i++] = tXStart + mScaleFactor;
-                mChartScreenBuffer[tChartIndex][i] = (SerialService.convertByteToFloat(aDataBytes[j++]) * mScaleFactor) + tYOffset;
 
-                mCanvas.drawLines(mChartScreenBuffer[tChartIndex], 0, aDataLength * 4, mGraphPaintStrokeScaleFactor);
+                if (aParameters[3] != 0) {
+                    // delete old chart
+                    mGraphPaintStrokeScaleFactor.setColor(shortToLongColor(aParameters[3]));
+                    mCanvas.drawLines(getChartScreenBuffer(tMinMaxChartIndex), 0,
+                            mChartScreenBufferCurrentLength[tMinMaxChartIndex] * 4, mGraphPaintStrokeScaleFactor);
+                }
+
+                float[] tMinMaxLines = getChartScreenBuffer(tMinMaxChartIndex);
+                float tColumnX = tXStart;
+                int tLinesIndex = 0;
+                for (int tColumnIndex = 0; tColumnIndex < tNumberOfColumns; tColumnIndex++) {
+                    tMinMaxLines[tLinesIndex++] = tColumnX;
+                    tMinMaxLines[tLinesIndex++] = (SerialService.convertByteToFloat(aDataBytes[2 * tColumnIndex]) * mScaleFactor)
+                            + tMinMaxYOffset;
+                    tMinMaxLines[tLinesIndex++] = tColumnX;
+                    // + 1 to include the bottom pixel
+                    tMinMaxLines[tLinesIndex++] = ((SerialService.convertByteToFloat(aDataBytes[(2 * tColumnIndex) + 1]) + 1)
+                            * mScaleFactor) + tMinMaxYOffset;
+                    tColumnX += mScaleFactor;
+                }
+                mChartScreenBufferCurrentLength[tMinMaxChartIndex] = tNumberOfColumns;
+                mChartScreenBufferXStart = tXStart;
+
+                mGraphPaintStrokeScaleFactor.setColor(shortToLongColor(aParameters[2]));
+                mCanvas.drawLines(tMinMaxLines, 0, tNumberOfColumns * 4, mGraphPaintStrokeScaleFactor);
+                break;
+
+            case FUNCTION_DRAW_CHART_GRID:
+                /*
+                 * Same drawings as the client does with one command per line, see BlueDisplay::drawChartGridSingle()
+                 */
+                int tGridXOrigin = aParameters[0];
+                int tGridYOrigin = aParameters[1];
+                int tGridWidth = aParameters[2];
+                int tGridHeight = aParameters[3];
+                int tGridXSpacing = aParameters[6];
+                int tGridYSpacing = aParameters[7];
+                int tAxesSize = aParameters[8];
+                int tGridFlags = aParameters[9];
+                if (MyLog.isDEBUG()) {
+                    MyLog.d(LOG_TAG, "drawChartGrid(" + tGridXOrigin + ", " + tGridYOrigin + ", " + tGridWidth + ", " + tGridHeight
+                            + ") spacing=" + tGridXSpacing + "/" + tGridYSpacing + " axesSize=" + tAxesSize + " flags=0x"
+                            + Integer.toHexString(tGridFlags) + " gridColor= " + shortToColorString(aParameters[4])
+                            + " axesColor= " + shortToColorString(aParameters[5]));
+                }
+                if (tGridXSpacing <= 0 || tGridYSpacing <= 0) {
+                    MyLog.e(LOG_TAG, "Grid spacing " + tGridXSpacing + "/" + tGridYSpacing + " must be greater than 0");
+                    break;
+                }
+                // X and Y axis
+                mGraphPaintStroke1Fill.setColor(shortToLongColor(aParameters[5]));
+                fillRectRel(tGridXOrigin - (tAxesSize - 1), tGridYOrigin, tGridWidth + (tAxesSize - 1), tAxesSize,
+                        mGraphPaintStroke1Fill);
+                fillRectRel(tGridXOrigin - (tAxesSize - 1), tGridYOrigin - (tGridHeight - 1), tAxesSize, tGridHeight - 1,
+                        mGraphPaintStroke1Fill);
+
+                mGraphPaintStroke1Fill.setColor(shortToLongColor(aParameters[4]));
+                if ((tGridFlags & CHART_GRID_FLAG_X_INDICATORS) != 0) {
+                    for (int tOffset = 0; tOffset <= tGridWidth; tOffset += tGridXSpacing) {
+                        fillRectRel(tGridXOrigin + tOffset, tGridYOrigin + tAxesSize, 1, tAxesSize, mGraphPaintStroke1Fill);
+                    }
+                }
+                if ((tGridFlags & CHART_GRID_FLAG_Y_INDICATORS) != 0) {
+                    for (int tOffset = 0; tOffset <= tGridHeight; tOffset += tGridYSpacing) {
+                        fillRectRel(tGridXOrigin - (2 * tAxesSize) + 1, tGridYOrigin - tOffset, tAxesSize, 1,
+                                mGraphPaintStroke1Fill);
+                    }
+                }
+                if ((tGridFlags & CHART_GRID_FLAG_GRID_LINES) != 0) {
+                    mGraphPaintStrokeScaleFactor.setColor(shortToLongColor(aParameters[4]));
+                    float tGridTop = (tGridYOrigin - (tGridHeight - 1)) * mScaleFactor;
+                    for (int tOffset = tGridXSpacing; tOffset <= tGridWidth; tOffset += tGridXSpacing) {
+                        float tGridX = (tGridXOrigin + tOffset) * mScaleFactor;
+                        mCanvas.drawLine(tGridX, tGridTop, tGridX, tGridYOrigin * mScaleFactor, mGraphPaintStrokeScaleFactor);
+                    }
+                    for (int tOffset = tGridYSpacing; tOffset <= tGridHeight; tOffset += tGridYSpacing) {
+                        float tGridY = (tGridYOrigin - tOffset) * mScaleFactor;
+                        mCanvas.drawLine((tGridXOrigin + 1) * mScaleFactor, tGridY, (tGridXOrigin + tGridWidth) * mScaleFactor,
+                                tGridY, mGraphPaintStrokeScaleFactor);
+                    }
+                }
+                break;
 
+            case FUNCTION_FILL_RECT_LIST:
+                /*
+                 * Data is x, y, width and height of each rectangle relative to start position as little endian shorts
+                 */
+                int tNumberOfRects = aDataLength / 8;
+                if (MyLog.isDEBUG()) {
+                    MyLog.d(LOG_TAG, "fillRectList(" + aParameters[0] + ", " + aParameters[1] + ") rects=" + tNumberOfRects
+                            + " color= " + shortToColorString(aParameters[4]));
+                }
+                mGraphPaintStroke1Fill.setColor(shortToLongColor(aParameters[4]));
+                for (int tRectIndex = 0; tRectIndex < tNumberOfRects; tRectIndex++) {
+                    int tRectDataIndex = 8 * tRectIndex;
+                    int tRectXOffset = (aDataBytes[tRectDataIndex] & 0xFF) | ((aDataBytes[tRectDataIndex + 1] & 0xFF) << 8);
+                    int tRectYOffset = (aDataBytes[tRectDataIndex + 2] & 0xFF) | ((aDataBytes[tRectDataIndex + 3] & 0xFF) << 8);
+                    int tRectWidth = (aDataBytes[tRectDataIndex + 4] & 0xFF) | ((aDataBytes[tRectDataIndex + 5] & 0xFF) << 8);
+                    int tRectHeight = (aDataBytes[tRectDataIndex + 6] & 0xFF) | ((aDataBytes[tRectDataIndex + 7] & 0xFF) << 8);
+                    float tRectX = tXStart + tRectXOffset * mScaleFactor;
+                    float tRectY = tYStart + tRectYOffset * mScaleFactor;
+                    mCanvas.drawRect(tRectX, tRectY, tRectX + tRectWidth * mScaleFactor, tRectY + tRectHeight * mScaleFactor,
+                            mGraphPaintStroke1Fill);
+                }
+                break;
+
+            case FUNCTION_DRAW_CHART_XY:
+                /*
+                 * Data is a pair of X and Y value for each point. Chart index is coded in the upper 4 bits of Y start position.
+                 * Points are stored like lines, i.e. 2 points in the space of one line.
+                 * Without delete color, the points are appended to the stored points, since the client sends
+                 * the points of one chart in chunks and only the first chunk has a delete color.
+                 */
+                int tXYChartIndex = aParameters[1] >> 12;
+                float tXYYOffset = (aParameters[1] & 0x0FFF) * mScaleFactor;
+                int tNumberOfPoints = aDataLength / 2;
+                if (tNumberOfPoints > 2 * MAX_CHART_LINE_WIDTH) {
+                    tNumberOfPoints = 2 * MAX_CHART_LINE_WIDTH;
+                }
+                if (MyLog.isDEBUG()) {
+                    MyLog.d(LOG_TAG, "drawChartXY(" + aParameters[0] + ", " + (aParameters[1] & 0x0FFF) + ") color= "
+                            + shortToColorString(aParameters[2]) + " ,deleteColor= " + shortToColorString(aParameters[3])
+                            + " points=" + tNumberOfPoints + " ChartIndex=" + tXYChartIndex);
+                }
+
+                int tFirstPointsIndex = 0;
+                if (aParameters[3] != 0) {
+                    // delete old points
+                    mGraphPaintStrokeScaleFactor.setColor(shortToLongColor(aParameters[3]));
+                    mCanvas.drawPoints(getChartScreenBuffer(tXYChartIndex), 0, mChartScreenBufferCurrentLength[tXYChartIndex] * 4,
+                            mGraphPaintStrokeScaleFactor);
+                } else {
+                    tFirstPointsIndex = mChartScreenBufferCurrentLength[tXYChartIndex] * 4;
+                    if (tFirstPointsIndex + (tNumberOfPoints * 2) > MAX_CHART_LINE_WIDTH * 4) {
+                        // buffer is full, the points stored before cannot be deleted any more
+                        tFirstPointsIndex = 0;
+                    }
+                }
+
+                float[] tXYPoints = getChartScreenBuffer(tXYChartIndex);
+                int tPointsIndex = tFirstPointsIndex;
+                for (int tPointIndex = 0; tPointIndex < tNumberOfPoints; tPointIndex++) {
+                    tXYPoints[tPointsIndex++] = (SerialService.convertByteToFloat(aDataBytes[2 * tPointIndex]) * mScaleFactor)
+                            + tXStart;
+                    tXYPoints[tPointsIndex++] = (SerialService.convertByteToFloat(aDataBytes[(2 * tPointIndex) + 1]) * mScaleFactor)
+                            + tXYYOffset;
+                }
+                if ((tNumberOfPoints & 1) != 0) {
+                    // fill the space of the last line with a copy of the last point
+                    tXYPoints[tPointsIndex] = tXYPoints[tPointsIndex - 2];
+                    tXYPoints[tPointsIndex + 1] = tXYPoints[tPointsIndex - 1];
+                }
+                mChartScreenBufferCurrentLength[tXYChartIndex] = (tFirstPointsIndex / 4) + ((tNumberOfPoints + 1) / 2);
+                mChartScreenBufferXStart = tXStart;
+
+                mGraphPaintStrokeScaleFactor.setColor(shortToLongColor(aParameters[2]));
+                mCanvas.drawPoints(tXYPoints, tFirstPointsIndex, tNumberOfPoints * 2, mGraphPaintStrokeScaleFactor);
                 break;
 
             case FUNCTION_DRAW_PATH:
@@ -1963,6 +2505,7 @@ public class RPCView extends View {
 
             case FUNCTION_DRAW_CHAR:
             case FUNCTION_DRAW_STRING:
+            case FUNCTION_DRAW_STRING_BY_ID:
                 tYStart = aParameters[1] * mScaleFactor;
                 int tBackgroundColor;
 
@@ -1999,11 +2542,17 @@ public class RPCView extends View {
                     tFunctionName = "drawChar";
                     sCharsArray[0] = myConvertChar((byte) aParameters[5]);
                     tDataLength = 1;
+                } else if (aCommand == FUNCTION_DRAW_STRING_BY_ID) {
+                    tFunctionName = "drawStringById";
                 } else {
                     tFunctionName = "drawString";
                     myConvertChars(aDataBytes, sCharsArray, tDataLength);
                 }
-                tStringParameter = new String(sCharsArray, 0, tDataLength);
+                if (aCommand == FUNCTION_DRAW_STRING_BY_ID) {
+                    tStringParameter = getInternedString(aParameters[5]);
+                } else {
+                    tStringParameter = new String(sCharsArray, 0, tDataLength);
+                }
 
                 if (MyLog.isDEBUG()) {
                     MyLog.d(LOG_TAG, tFunctionName + "(\"" + tStringParameter + "\", " + aParameters[0] + ", " + aParameters[1]
@@ -2093,6 +2642,131 @@ public class RPCView extends View {
                 }
                 break;
 
+            case FUNCTION_STRING_DEFINE:
+                myConvertChars(aDataBytes, sCharsArray, aDataLength);
+                tStringParameter = new String(sCharsArray, 0, aDataLength);
+                mInternedStrings.put(aParameters[0], tStringParameter);
+                if (MyLog.isDEBUG()) {
+                    MyLog.d(LOG_TAG, "defineString(" + aParameters[0] + ", \"" + tStringParameter + "\")");
+                }
+                break;
+
+            case FUNCTION_VECTOR_SET_DEGREES:
+                /*
+                 * First erase all old vectors, then draw all new ones, so a vector is not damaged by erasing another one
+                 */
+                boolean tDoDrawAllVectors = aParameters[0] != 0;
+                int tNumberOfVectors = aDataLength / 4;
+                for (int k = 0; k < tNumberOfVectors; k++) {
+                    int[] tVectorToErase = mVectors.get((aDataBytes[4 * k] & 0xFF) | (aDataBytes[4 * k + 1] << 8));
+                    int tNewDegrees = (aDataBytes[4 * k + 2] & 0xFF) | (aDataBytes[4 * k + 3] << 8);
+                    if (tVectorToErase != null && tVectorToErase[VECTOR_DRAWN_DEGREES] != VECTOR_NOT_DRAWN
+                            && tVectorToErase[VECTOR_DRAWN_DEGREES] != tNewDegrees) {
+                        drawVector(tVectorToErase, tVectorToErase[VECTOR_DRAWN_DEGREES], tVectorToErase[VECTOR_BACKGROUND_COLOR]);
+                    }
+                }
+                for (int k = 0; k < tNumberOfVectors; k++) {
+                    int[] tVectorToDraw = mVectors.get((aDataBytes[4 * k] & 0xFF) | (aDataBytes[4 * k + 1] << 8));
+                    int tNewDegrees = (aDataBytes[4 * k + 2] & 0xFF) | (aDataBytes[4 * k + 3] << 8);
+                    if (tVectorToDraw != null && (tDoDrawAllVectors || tVectorToDraw[VECTOR_DRAWN_DEGREES] != tNewDegrees)) {
+                        drawVector(tVectorToDraw, tNewDegrees, tVectorToDraw[VECTOR_COLOR]);
+                        tVectorToDraw[VECTOR_DRAWN_DEGREES] = tNewDegrees;
+                    }
+                }
+                if (MyLog.isDEBUG()) {
+                    MyLog.d(LOG_TAG, "setVectorDegrees() vectors=" + tNumberOfVectors + " drawAll=" + tDoDrawAllVectors);
+                }
+                break;
+
+            case FUNCTION_COLOR_PALETTE_SET:
+                int tNumberOfPaletteColors = Math.min(Math.min(aParameters[0], aDataLength / 2), MAX_NUMBER_OF_PALETTE_COLORS);
+                for (int k = 0; k < tNumberOfPaletteColors; k++) {
+                    mColorPalette[k] = (aDataBytes[2 * k] & 0xFF) | ((aDataBytes[2 * k + 1] & 0xFF) << 8);
+                }
+                if (MyLog.isDEBUG()) {
+                    MyLog.d(LOG_TAG, "setColorPalette() colors=" + tNumberOfPaletteColors);
+                }
+                break;
+
+            case FUNCTION_BITMAP_SET_PALETTE:
+                int tNumberOfPaletteEntries = Math.min(aParameters[1], aDataLength / 2);
+                int[] tPalette = new int[tNumberOfPaletteEntries];
+                for (int k = 0; k < tNumberOfPaletteEntries; k++) {
+                    tPalette[k] = shortToLongColor((aDataBytes[2 * k] & 0xFF) | ((aDataBytes[2 * k + 1] & 0xFF) << 8));
+                }
+                mBitmapPalettes.put(aParameters[0], tPalette);
+                if (MyLog.isDEBUG()) {
+                    MyLog.d(LOG_TAG, "setBitmapPalette(" + aParameters[0] + ") entries=" + tNumberOfPaletteEntries);
+                }
+                break;
+
+            case FUNCTION_BITMAP_UPLOAD:
+                /*
+                 * Large bitmaps are sent in chunks of complete lines, starting at line aParameters[4]
+                 */
+                int tBitmapId = aParameters[0];
+                int tBitmapWidth = aParameters[1];
+                int tBitmapHeight = aParameters[2];
+                int tBitmapFormat = aParameters[3];
+                int tStartLine = aParameters[4];
+                int tBytesPerPixel = 1;
+                if (tBitmapFormat == BITMAP_FORMAT_RGB565) {
+                    tBytesPerPixel = 2;
+                }
+                int tNumberOfLines = Math.min(aDataLength / (tBitmapWidth * tBytesPerPixel), tBitmapHeight - tStartLine);
+                if (MyLog.isDEBUG()) {
+                    MyLog.d(LOG_TAG, "uploadBitmap(" + tBitmapId + ") " + tBitmapWidth + "*" + tBitmapHeight + " format="
+                            + tBitmapFormat + " startLine=" + tStartLine + " lines=" + tNumberOfLines);
+                }
+                Bitmap tBitmap = mBitmapCache.get(tBitmapId);
+                if (tStartLine == 0 || tBitmap == null || tBitmap.getWidth() != tBitmapWidth
+                        || tBitmap.getHeight() != tBitmapHeight) {
+                    tBitmap = Bitmap.createBitmap(tBitmapWidth, tBitmapHeight, Bitmap.Config.ARGB_8888);
+                    mBitmapCache.put(tBitmapId, tBitmap);
+                }
+                int[] tPixels = new int[tBitmapWidth * tNumberOfLines];
+                if (tBitmapFormat == BITMAP_FORMAT_INDEXED_8) {
+                    int[] tPaletteForBitmap = mBitmapPalettes.get(tBitmapId);
+                    for (int k = 0; k < tPixels.length; k++) {
+                        int tPaletteIndex = aDataBytes[k] & 0xFF;
+                        if (tPaletteForBitmap != null && tPaletteIndex < tPaletteForBitmap.length) {
+                            tPixels[k] = tPaletteForBitmap[tPaletteIndex];
+                        } else {
+                            tPixels[k] = Color.BLACK;
+                        }
+                    }
+                } else {
+                    for (int k = 0; k < tPixels.length; k++) {
+                        tPixels[k] = shortToLongColor((aDataBytes[2 * k] & 0xFF) | ((aDataBytes[2 * k + 1] & 0xFF) << 8));
+                    }
+                }
+                tBitmap.setPixels(tPixels, 0, tBitmapWidth, 0, tStartLine, tBitmapWidth, tNumberOfLines);
+                break;
+
+            case FUNCTION_BITMAP_DRAW:
+                tBitmap = mBitmapCache.get(aParameters[0]);
+                if (MyLog.isDEBUG()) {
+                    MyLog.d(LOG_TAG, "drawBitmap(" + aParameters[0] + ", " + aParameters[1] + ", " + aParameters[2] + ")");
+                }
+                if (tBitmap == null) {
+                    MyLog.w(LOG_TAG, "drawBitmap: bitmap " + aParameters[0] + " was not uploaded");
+                    break;
+                }
+                tXStart = aParameters[1] * mScaleFactor;
+                tYStart = aParameters[2] * mScaleFactor;
+                mBitmapDestinationRect.set(tXStart, tYStart, tXStart + tBitmap.getWidth() * mScaleFactor,
+                        tYStart + tBitmap.getHeight() * mScaleFactor);
+                mCanvas.drawBitmap(tBitmap, null, mBitmapDestinationRect, null);
+                break;
+
+            case FUNCTION_BITMAP_REMOVE:
+                if (MyLog.isDEBUG()) {
+                    MyLog.d(LOG_TAG, "removeBitmap(" + aParameters[0] + ")");
+                }
+                mBitmapCache.remove(aParameters[0]);
+                mBitmapPalettes.remove(aParameters[0]);
+                break;
+
             case FUNCTION_NOP:
                 if (MyLog.isINFO()) {
                     MyLog.i(LOG_TAG, "NOP (for sync) received. ParamsLength=" + aParamsLength + " DataLength=" + aDataLength);
@@ -2204,6 +2878,22 @@ public class RPCView extends View {
         TouchSlider.resetSliders(this);
         Sensors.disableAllSensors();
         resetFlags();
+        mBitmapCache.clear();
+        mBitmapPalettes.clear();
+        mInternedStrings.clear();
+        mVectors.clear();
+        mFrameIsOpen = false;
+        if (mPresentedBitmap != null) {
+            mPresentedBitmap.recycle();
+            mPresentedBitmap = null;
+            mPresentedCanvas = null;
+        }
+        if (mScrollBitmap != null) {
+            mScrollBitmap.recycle();
+            mScrollBitmap = null;
+            mScrollCanvas = null;
+        }
+        removeUpperLayers();
         initCharMappingArray();
         if (MyLog.isINFO()) {
             MyLog.i(LOG_TAG, "Reset all");
@@ -658,6 +658,7 @@ public class SerialService {
     private byte searchStateCommand;
     private byte searchStateCommandReceived; // The command we received, for which data we wait now
     private int searchStateParamsLength; // Parameter length for the above command
+    private int searchStateColorParameterMask; // Mask of parameters sent as one byte color palette index
     private int searchStateInputLengthToWaitFor = MIN_COMMAND_SIZE; // If available data is less than length, do nothing.
     private long sTimestampOfLastDataWait = 0;
 
@@ -780,6 +781,7 @@ public class SerialService {
         inBufferReadingLock = true;
         byte tCommand = 0;
         int tParamsLength = 0;
+        int tColorParameterMask = 0;
         byte tByte;
         int i;
         byte tCommandReceived;
@@ -817,6 +819,7 @@ public class SerialService {
                 tCommandReceived = searchStateCommandReceived;
                 tCommand = searchStateCommand;
                 tParamsLength = searchStateParamsLength;
+                tColorParameterMask = searchStateColorParameterMask;
                 searchStateMustBeLoaded = false;
                 if (MyLog.isVERBOSE()) {
                     MyLog.v(LOG_TAG, "Restore previous state");
@@ -858,8 +861,10 @@ public class SerialService {
 
                 } else {
                     /*
-                     * Parameter length received
+                     * Parameter length received. Upper byte is the mask of parameters sent as color palette index.
                      */
+                    tColorParameterMask = (tLengthReceived >> 8) & 0xFF;
+                    tLengthReceived &= 0xFF;
                     if (MyLog.isVERBOSE()) {
                         MyLog.v(LOG_TAG, "Command=0x" + Integer.toHexString(tCommandReceived) + " ParameterLength="
                                 + tLengthReceived + " at ptr=" + (mReceiveBufferOutIndex - 1));
@@ -880,6 +885,7 @@ public class SerialService {
                     searchStateCommandReceived = tCommandReceived;
                     searchStateCommand = tCommand;
                     searchStateParamsLength = tParamsLength;
+                    searchStateColorParameterMask = tColorParameterMask;
 
                     searchStateMustBeLoaded = true;
                     if (MyLog.isVERBOSE()) {
@@ -944,7 +950,8 @@ public class SerialService {
                                 /*
                                  * Scan for clear screen command and skip content until it
                                  */
-                                scanBufferForClearDisplayOptionalCommandAndSkip(tBufferBytesAvailable);
+                                scanBufferForCommandAndSkip(tBufferBytesAvailable, RPCView.FUNCTION_CLEAR_DISPLAY_OPTIONAL,
+                                        RPCView.FUNCTION_CLEAR_DISPLAY);
                             }
                         }
                         // break in order to draw a chart directly
@@ -966,12 +973,31 @@ public class SerialService {
                 /*
                  * Command parameters here
                  */
-                tParamsLength = tLengthReceived / 2;
                 tCommand = tCommandReceived;
 
-                for (i = 0; i < tParamsLength; i++) {
-                    tByte = getByteFromBuffer();
-                    mParameters[i] = convert2BytesToInt(tByte, getByteFromBuffer());
+                if (tColorParameterMask == 0) {
+                    tParamsLength = tLengthReceived / 2;
+                    for (i = 0; i < tParamsLength; i++) {
+                        tByte = getByteFromBuffer();
+                        mParameters[i] = convert2BytesToInt(tByte, getByteFromBuffer());
+                    }
+                } else {
+                    /*
+                     * Colors are sent as one byte palette index, so interpretCommand() gets the same RGB565 values as without palette
+                     */
+                    tParamsLength = 0;
+                    int tBytesRead = 0;
+                    while (tBytesRead < tLengthReceived && tParamsLength < MAX_NUMBER_OF_PARAMS) {
+                        if ((tColorParameterMask & (1 << tParamsLength)) != 0) {
+                            mParameters[tParamsLength] = aRPCView.getPaletteColor(getByteFromBuffer() & 0xFF);
+                            tBytesRead++;
+                        } else {
+                            tByte = getByteFromBuffer();
+                            mParameters[tParamsLength] = convert2BytesToInt(tByte, getByteFromBuffer());
+                            tBytesRead += 2;
+                        }
+                        tParamsLength++;
+                    }
                 }
                 if (MyLog.isDEVELOPMENT_TESTING() && MyLog.isVERBOSE()) {
                     // Output parameter buffer as short hex values
@@ -991,14 +1017,25 @@ public class SerialService {
                      */
                     aRPCView.interpretCommand(tCommand, mParameters, tParamsLength, null, null, 0);
                     mStatisticNumberOfReceivedCommands++;
-                    if (tCommand == RPCView.FUNCTION_DRAW_DISPLAY) {
+                    if (tCommand == RPCView.FUNCTION_DRAW_DISPLAY || tCommand == RPCView.FUNCTION_FRAME_END) {
                         if (getBufferBytesAvailable() > 0) {
                             // We still have bytes in the buffer so call again
                             tRetval = RPCVIEW_DO_DRAW_AND_CALL_AGAIN;
                         }
-                        // break in order to draw the bitmap as requested by FUNCTION_DRAW_DISPLAY
+                        // break in order to draw the bitmap as requested by FUNCTION_DRAW_DISPLAY or to present the frame
                         break;
                     }
+                    if (tCommand == RPCView.FUNCTION_FRAME_BEGIN_OPTIONAL) {
+                        int tBufferBytesAvailable = getBufferBytesAvailable();
+                        if (tBufferBytesAvailable > 2000) {
+                            /*
+                             * We are behind the client, so skip this optional frame until the next optional frame begin.
+                             * Frames containing definitions or settings are not skipped.
+                             */
+                            scanBufferForCommandAndSkip(tBufferBytesAvailable, RPCView.FUNCTION_FRAME_BEGIN_OPTIONAL,
+                                    RPCView.FUNCTION_FRAME_BEGIN_OPTIONAL);
+                        }
+                    }
 
                     if ((System.nanoTime() - tStartOfSearchCommand) > MAX_DRAW_INTERVAL_NANOS) {
                         Log.w(LOG_TAG, "Return searchCommand() prematurely after 0.5 seconds to enable display refresh");
@@ -1099,9 +1136,10 @@ public class SerialService {
     }
 
     /*
-     * Scan for next clear screen command. return true if found
+     * Scan for next aCommandToSearch command, skip buffer content until it and replace it by aReplacementCommand.
+     * Nothing is skipped, if a state changing command like a string or button definition is found before.
      */
-    private void scanBufferForClearDisplayOptionalCommandAndSkip(int aBytesToScan) {
+    private void scanBufferForCommandAndSkip(int aBytesToScan, int aCommandToSearch, int aReplacementCommand) {
         int tByteCount = 0;
         // initialize
         int tBufferIndex = mReceiveBufferOutIndex;
@@ -1128,16 +1166,22 @@ public class SerialService {
             // double check
             if (tByte == SYNC_TOKEN) {
                 tByte = mBigReceiveBuffer[tBufferIndex];
-                if (tByte == RPCView.FUNCTION_CLEAR_DISPLAY_OPTIONAL) {
+                if (tByte == aCommandToSearch) {
                     /*
-                     * Found clear display optional -> skip buffer content and change command to clear buffer.
+                     * Found command -> skip buffer content and change command, e.g. clear display optional to clear display.
                      */
-                    mBigReceiveBuffer[tBufferIndex] = RPCView.FUNCTION_CLEAR_DISPLAY;
+                    mBigReceiveBuffer[tBufferIndex] = (byte) aReplacementCommand;
                     mReceiveBufferOutIndex = tIndexOfSyncToken;
                     mInputBufferWrapAroundIndex = tWrapAroundIndexOfSyncToken;
-                    Log.w(LOG_TAG, "Skip " + (tByteCount - 2)
-                            + " bytes until next CLEAR_DISPLAY_OPTIONAL command. Bytes in buffer==" + aBytesToScan + "->"
-                            + getBufferBytesAvailable());
+                    Log.w(LOG_TAG, "Skip " + (tByteCount - 2) + " bytes until next 0x" + Integer.toHexString(aCommandToSearch)
+                            + " command. Bytes in buffer==" + aBytesToScan + "->" + getBufferBytesAvailable());
+                    break;
+                }
+                if (RPCView.isStateChangingCommand(tByte & 0xFF)) {
+                    if (MyLog.isDEBUG()) {
+                        Log.d(LOG_TAG, "Do not skip, found state changing command 0x" + Integer.toHexString(tByte & 0xFF)
+                                + " before next 0x" + Integer.toHexString(aCommandToSearch) + " command");
+                    }
                     break;
                 }
 
@@ -104,6 +104,8 @@ public class TouchButton {
     private static final int FUNCTION_BUTTON_DRAW_CAPTION = 0x41;
     private static final int FUNCTION_BUTTON_SETTINGS = 0x42;
     private static final int FUNCTION_BUTTON_REMOVE = 0x43;
+    private static final int FUNCTION_BUTTON_SET_CAPTION_BY_ID = 0x44;
+    private static final int FUNCTION_BUTTON_SET_CAPTION_BY_ID_AND_DRAW_BUTTON = 0x45;
 
     // static functions
     private static final int FUNCTION_BUTTON_ACTIVATE_ALL = 0x48;
@@ -670,6 +672,19 @@ public class TouchButton {
             }
             break;
 
+        case FUNCTION_BUTTON_SET_CAPTION_BY_ID:
+        case FUNCTION_BUTTON_SET_CAPTION_BY_ID_AND_DRAW_BUTTON:
+            tButton.handleCaption(aRPCView.getInternedString(aParameters[1]));
+
+            if (MyLog.isINFO()) {
+                MyLog.i(LOG_TAG, "Set caption by id=" + aParameters[1] + " \"" + tButton.mEscapedCaption + "\" for" + tButtonCaption
+                        + tButtonNumber);
+            }
+            if (aCommand == FUNCTION_BUTTON_SET_CAPTION_BY_ID_AND_DRAW_BUTTON) {
+                tButton.drawButton();
+            }
+            break;
+
         case FUNCTION_BUTTON_SET_CAPTION_FOR_VALUE_TRUE:
             aRPCView.myConvertChars(aDataBytes, RPCView.sCharsArray, aDataLength);
             tString = new String(RPCView.sCharsArray, 0, aDataLength);